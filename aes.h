@@ -5,7 +5,63 @@
 #ifndef AES_H
 #define AES_H
 
-#endif //AES_H
+#include <stddef.h>
+
+#define AES_BLOCK_SIZE 16   // AES分组长度（字节）
+#define AES_MAX_ROUNDS 14   // AES-256 的轮数，决定轮密钥缓冲区大小
+
+// AES实现选择
+typedef enum {
+    AES_IMPL_AUTO = 0,  // 自动选择最快的可用实现
+    AES_IMPL_REF,       // 字节矩阵参考实现
+    AES_IMPL_TTABLE,    // 32位T表实现，可移植的快速路径
+    AES_IMPL_AESNI,     // AES-NI 硬件指令实现
+    AES_IMPL_BITSLICE   // 位切片实现，不查表、常数时间，每批8个分组
+} aes_impl_t;
+
+// AES上下文 - 密钥只扩展一次，之后可反复用于任意数量的分组
+typedef struct {
+    unsigned char enc_rk[(AES_MAX_ROUNDS + 1) * 16];  // 加密轮密钥，(rounds + 1) x 16字节
+    unsigned char dec_rk[(AES_MAX_ROUNDS + 1) * 16];  // 解密轮密钥，按解密使用顺序排列
+    int rounds;                 // 轮数：10/12/14 对应 AES-128/192/256
+    aes_impl_t impl;            // 初始化时选定的实现
+    int bs_batches;             // 不少于8个分组的批量改用位切片实现 (自动选择且没有 AES-NI 时)
+} aes_ctx;
+
+// 设置之后 aes_init 使用的实现，成功返回0，当前CPU不支持返回-1
+// 默认自动选择：AES-NI > T表；环境变量 AES_IMPL=ref/ttable/aesni/bitslice 可强制指定
+// 自动选择落到T表时，不少于8个分组的批量 (CTR、XTS、CBC解密等可并行的模式) 改用不查表的位切片实现，
+// 单分组和串行调用 (CBC加密等) 仍用T表；显式选择 bitslice 则所有调用都补齐到8个分组后用位切片实现
+int aes_set_impl(aes_impl_t impl);
+
+// 返回当前默认实现及其名称
+aes_impl_t aes_get_impl(void);
+const char *aes_impl_name(aes_impl_t impl);
+
+// 用 key_len 字节 (16/24/32，即 AES-128/192/256) 的密钥初始化上下文，生成加密和解密轮密钥
+// 成功返回0，密钥长度无效返回-1。各实现按轮数分派到编译期特化、轮循环完全展开的内核
+int aes_init_key(aes_ctx *ctx, const unsigned char *key, size_t key_len);
 
+// 用128位密钥初始化上下文，等同于 aes_init_key(ctx, key, 16)
+void aes_init(aes_ctx *ctx, const unsigned char *key);
+
+// 使用已初始化的上下文加密/解密 nblocks 个连续的16字节分组，in 与 out 可以相同
+void aes_encrypt_blocks(const aes_ctx *ctx, const unsigned char *in, unsigned char *out, size_t nblocks);
+void aes_decrypt_blocks(const aes_ctx *ctx, const unsigned char *in, unsigned char *out, size_t nblocks);
+
+// CTR 密钥流：加密 counter, counter+1, ... 共 nblocks 个计数器分组并与 in 异或写入 out，
+// counter 为16字节大端计数器，返回时已前进 nblocks。供各种基于计数器的模式使用
+void aes_ctr_blocks(const aes_ctx *ctx, unsigned char *counter, const unsigned char *in, unsigned char *out,
+                    size_t nblocks);
+
+// 清除上下文中的轮密钥
+void aes_wipe(aes_ctx *ctx);
+
+// 用FIPS-197测试向量检查所有可用实现和密钥长度，全部通过返回0
+int aes_self_test(void);
+
+// 单分组接口，每次调用都会重新扩展密钥
 void aes_encrypt(unsigned char* input, const unsigned char* key, unsigned char* output);
 void aes_decrypt(unsigned char* input, const unsigned char* key, unsigned char* output);
+
+#endif //AES_H
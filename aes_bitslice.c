@@ -0,0 +1,461 @@
+//
+// 位切片 AES
+//
+// 8个分组共128字节，按比特位拆成8个切片：切片k是一个128位向量，其第j个字节的第b位
+// 是第b个分组第j个字节的第k位。于是：
+//   - SubBytes 变成对8个切片的布尔电路（Boyar-Peralta S盒电路），没有任何查表；
+//   - ShiftRows 只是每个切片内部的字节置换；
+//   - MixColumns 是32位通道内的循环移位加上切片间的 xtime 线性变换。
+// 所有操作与数据无关，执行时间恒定。
+//
+
+#include "aes_bitslice.h"
+
+#if AES_BITSLICE_AVAILABLE
+
+#include <emmintrin.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "crypto_util.h"
+
+#define BS_TARGET __attribute__((target("sse2")))
+
+#define BS_MAX_ROUNDS 14
+
+// 32位通道内循环右移，用于把同一列中第r+n行的字节移到第r行
+#define ROTR32(x, n) _mm_or_si128(_mm_srli_epi32(x, n), _mm_slli_epi32(x, 32 - (n)))
+
+// 把8个16字节向量看作8x16的字节矩阵做转置：out[m] 的低/高8字节分别是原矩阵第 2m/2m+1 列
+static BS_TARGET void transpose_bytes(const __m128i x[8], __m128i out[8]) {
+    __m128i a[8], b[8];
+
+    a[0] = _mm_unpacklo_epi8(x[0], x[1]);
+    a[1] = _mm_unpackhi_epi8(x[0], x[1]);
+    a[2] = _mm_unpacklo_epi8(x[2], x[3]);
+    a[3] = _mm_unpackhi_epi8(x[2], x[3]);
+    a[4] = _mm_unpacklo_epi8(x[4], x[5]);
+    a[5] = _mm_unpackhi_epi8(x[4], x[5]);
+    a[6] = _mm_unpacklo_epi8(x[6], x[7]);
+    a[7] = _mm_unpackhi_epi8(x[6], x[7]);
+
+    b[0] = _mm_unpacklo_epi16(a[0], a[2]);
+    b[1] = _mm_unpackhi_epi16(a[0], a[2]);
+    b[2] = _mm_unpacklo_epi16(a[1], a[3]);
+    b[3] = _mm_unpackhi_epi16(a[1], a[3]);
+    b[4] = _mm_unpacklo_epi16(a[4], a[6]);
+    b[5] = _mm_unpackhi_epi16(a[4], a[6]);
+    b[6] = _mm_unpacklo_epi16(a[5], a[7]);
+    b[7] = _mm_unpackhi_epi16(a[5], a[7]);
+
+    out[0] = _mm_unpacklo_epi32(b[0], b[4]);
+    out[1] = _mm_unpackhi_epi32(b[0], b[4]);
+    out[2] = _mm_unpacklo_epi32(b[1], b[5]);
+    out[3] = _mm_unpackhi_epi32(b[1], b[5]);
+    out[4] = _mm_unpacklo_epi32(b[2], b[6]);
+    out[5] = _mm_unpackhi_epi32(b[2], b[6]);
+    out[6] = _mm_unpacklo_epi32(b[3], b[7]);
+    out[7] = _mm_unpackhi_epi32(b[3], b[7]);
+}
+
+// 把8个分组转换为8个切片
+// 字节转置后每个64位通道是同一字节位置上的8个分组，再用 movemask 逐位取出各分组的第k位
+static BS_TARGET void bs_load(const unsigned char* in, __m128i q[8]) {
+    __m128i blocks[8], cols[8];
+    uint16_t w[8][8];
+
+    for (int b = 0; b < 8; b++) {
+        blocks[b] = _mm_loadu_si128((const __m128i*) (in + b * 16));
+    }
+    transpose_bytes(blocks, cols);
+
+    for (int m = 0; m < 8; m++) {
+        __m128i x = cols[m];
+        for (int k = 7; k >= 0; k--) {
+            w[k][m] = (uint16_t) _mm_movemask_epi8(x);
+            x = _mm_add_epi8(x, x);
+        }
+    }
+
+    for (int k = 0; k < 8; k++) {
+        q[k] = _mm_loadu_si128((const __m128i*) w[k]);
+    }
+}
+
+// 把8个切片转换回8个分组，是 bs_load 的逆过程
+static BS_TARGET void bs_store(const __m128i q[8], unsigned char* out) {
+    __m128i cols[8];
+    uint16_t w[8][8];
+
+    transpose_bytes(q, cols);
+
+    for (int m = 0; m < 8; m++) {
+        __m128i x = cols[m];
+        for (int b = 7; b >= 0; b--) {
+            w[b][m] = (uint16_t) _mm_movemask_epi8(x);
+            x = _mm_add_epi8(x, x);
+        }
+    }
+
+    for (int b = 0; b < 8; b++) {
+        _mm_storeu_si128((__m128i*) (out + b * 16), _mm_loadu_si128((const __m128i*) w[b]));
+    }
+}
+
+// 把一个轮密钥展开成8个切片：切片k中第j个字节为全1当且仅当轮密钥第j个字节的第k位为1
+static BS_TARGET void bs_key(const unsigned char* round_key, __m128i sk[8]) {
+    __m128i key = _mm_loadu_si128((const __m128i*) round_key);
+
+    for (int k = 0; k < 8; k++) {
+        __m128i bit = _mm_set1_epi8((char) (1 << k));
+        sk[k] = _mm_cmpeq_epi8(_mm_and_si128(key, bit), bit);
+    }
+}
+
+// 轮密钥加
+static BS_TARGET void add_round_key(__m128i q[8], const __m128i sk[8]) {
+    for (int k = 0; k < 8; k++) {
+        q[k] = _mm_xor_si128(q[k], sk[k]);
+    }
+}
+
+// S盒的布尔电路（Boyar-Peralta），q[k] 为第k位切片
+static BS_TARGET void sub_bytes(__m128i q[8]) {
+    __m128i x0, x1, x2, x3, x4, x5, x6, x7;
+    __m128i y1, y2, y3, y4, y5, y6, y7, y8, y9, y10, y11;
+    __m128i y12, y13, y14, y15, y16, y17, y18, y19, y20, y21;
+    __m128i z0, z1, z2, z3, z4, z5, z6, z7, z8, z9;
+    __m128i z10, z11, z12, z13, z14, z15, z16, z17;
+    __m128i t0, t1, t2, t3, t4, t5, t6, t7, t8, t9;
+    __m128i t10, t11, t12, t13, t14, t15, t16, t17, t18, t19;
+    __m128i t20, t21, t22, t23, t24, t25, t26, t27, t28, t29;
+    __m128i t30, t31, t32, t33, t34, t35, t36, t37, t38, t39;
+    __m128i t40, t41, t42, t43, t44, t45, t46, t47, t48, t49;
+    __m128i t50, t51, t52, t53, t54, t55, t56, t57, t58, t59;
+    __m128i t60, t61, t62, t63, t64, t65, t66, t67;
+    __m128i s0, s1, s2, s3, s4, s5, s6, s7;
+
+    x0 = q[7];
+    x1 = q[6];
+    x2 = q[5];
+    x3 = q[4];
+    x4 = q[3];
+    x5 = q[2];
+    x6 = q[1];
+    x7 = q[0];
+
+    // 顶部线性变换
+    y14 = x3 ^ x5;
+    y13 = x0 ^ x6;
+    y9 = x0 ^ x3;
+    y8 = x0 ^ x5;
+    t0 = x1 ^ x2;
+    y1 = t0 ^ x7;
+    y4 = y1 ^ x3;
+    y12 = y13 ^ y14;
+    y2 = y1 ^ x0;
+    y5 = y1 ^ x6;
+    y3 = y5 ^ y8;
+    t1 = x4 ^ y12;
+    y15 = t1 ^ x5;
+    y20 = t1 ^ x1;
+    y6 = y15 ^ x7;
+    y10 = y15 ^ t0;
+    y11 = y20 ^ y9;
+    y7 = x7 ^ y11;
+    y17 = y10 ^ y11;
+    y19 = y10 ^ y8;
+    y16 = t0 ^ y11;
+    y21 = y13 ^ y16;
+    y18 = x0 ^ y16;
+
+    // 非线性部分：GF(2^4) 上的求逆
+    t2 = y12 & y15;
+    t3 = y3 & y6;
+    t4 = t3 ^ t2;
+    t5 = y4 & x7;
+    t6 = t5 ^ t2;
+    t7 = y13 & y16;
+    t8 = y5 & y1;
+    t9 = t8 ^ t7;
+    t10 = y2 & y7;
+    t11 = t10 ^ t7;
+    t12 = y9 & y11;
+    t13 = y14 & y17;
+    t14 = t13 ^ t12;
+    t15 = y8 & y10;
+    t16 = t15 ^ t12;
+    t17 = t4 ^ t14;
+    t18 = t6 ^ t16;
+    t19 = t9 ^ t14;
+    t20 = t11 ^ t16;
+    t21 = t17 ^ y20;
+    t22 = t18 ^ y19;
+    t23 = t19 ^ y21;
+    t24 = t20 ^ y18;
+
+    t25 = t21 ^ t22;
+    t26 = t21 & t23;
+    t27 = t24 ^ t26;
+    t28 = t25 & t27;
+    t29 = t28 ^ t22;
+    t30 = t23 ^ t24;
+    t31 = t22 ^ t26;
+    t32 = t31 & t30;
+    t33 = t32 ^ t24;
+    t34 = t23 ^ t33;
+    t35 = t27 ^ t33;
+    t36 = t24 & t35;
+    t37 = t36 ^ t34;
+    t38 = t27 ^ t36;
+    t39 = t29 & t38;
+    t40 = t25 ^ t39;
+
+    t41 = t40 ^ t37;
+    t42 = t29 ^ t33;
+    t43 = t29 ^ t40;
+    t44 = t33 ^ t37;
+    t45 = t42 ^ t41;
+    z0 = t44 & y15;
+    z1 = t37 & y6;
+    z2 = t33 & x7;
+    z3 = t43 & y16;
+    z4 = t40 & y1;
+    z5 = t29 & y7;
+    z6 = t42 & y11;
+    z7 = t45 & y17;
+    z8 = t41 & y10;
+    z9 = t44 & y12;
+    z10 = t37 & y3;
+    z11 = t33 & y4;
+    z12 = t43 & y13;
+    z13 = t40 & y5;
+    z14 = t29 & y2;
+    z15 = t42 & y9;
+    z16 = t45 & y14;
+    z17 = t41 & y8;
+
+    // 底部线性变换
+    t46 = z15 ^ z16;
+    t47 = z10 ^ z11;
+    t48 = z5 ^ z13;
+    t49 = z9 ^ z10;
+    t50 = z2 ^ z12;
+    t51 = z2 ^ z5;
+    t52 = z7 ^ z8;
+    t53 = z0 ^ z3;
+    t54 = z6 ^ z7;
+    t55 = z16 ^ z17;
+    t56 = z12 ^ t48;
+    t57 = t50 ^ t53;
+    t58 = z4 ^ t46;
+    t59 = z3 ^ t54;
+    t60 = t46 ^ t57;
+    t61 = z14 ^ t57;
+    t62 = t52 ^ t58;
+    t63 = t49 ^ t58;
+    t64 = z4 ^ t59;
+    t65 = t61 ^ t62;
+    t66 = z1 ^ t63;
+    s0 = t59 ^ t63;
+    s6 = t56 ^ ~t62;
+    s7 = t48 ^ ~t60;
+    t67 = t64 ^ t65;
+    s3 = t53 ^ t66;
+    s4 = t51 ^ t66;
+    s5 = t47 ^ t65;
+    s1 = t64 ^ ~s3;
+    s2 = t55 ^ ~t67;
+
+    q[7] = s0;
+    q[6] = s1;
+    q[5] = s2;
+    q[4] = s3;
+    q[3] = s4;
+    q[2] = s5;
+    q[1] = s6;
+    q[0] = s7;
+}
+
+// 逆仿射变换 (S盒仿射变换的逆，常数0x05)
+static BS_TARGET void inv_affine(__m128i q[8]) {
+    __m128i t[8];
+
+    for (int i = 0; i < 8; i++) {
+        t[i] = q[(i + 2) & 7] ^ q[(i + 5) & 7] ^ q[(i + 7) & 7];
+    }
+    t[0] = ~t[0];
+    t[2] = ~t[2];
+    for (int i = 0; i < 8; i++) {
+        q[i] = t[i];
+    }
+}
+
+// 逆S盒：InvS(y) = InvAffine(S(InvAffine(y)))，复用同一个求逆电路
+static BS_TARGET void inv_sub_bytes(__m128i q[8]) {
+    inv_affine(q);
+    sub_bytes(q);
+    inv_affine(q);
+}
+
+// 行移位：列c第r行的字节取自列c+r，即第r行字节所在的32位通道整体左移r个通道
+static BS_TARGET __m128i shift_rows_slice(__m128i x) {
+    const __m128i m0 = _mm_set1_epi32(0x000000ff);
+    const __m128i m1 = _mm_set1_epi32(0x0000ff00);
+    const __m128i m2 = _mm_set1_epi32(0x00ff0000);
+    const __m128i m3 = _mm_set1_epi32((int) 0xff000000);
+
+    return (x & m0) |
+           (_mm_shuffle_epi32(x, _MM_SHUFFLE(0, 3, 2, 1)) & m1) |
+           (_mm_shuffle_epi32(x, _MM_SHUFFLE(1, 0, 3, 2)) & m2) |
+           (_mm_shuffle_epi32(x, _MM_SHUFFLE(2, 1, 0, 3)) & m3);
+}
+
+// 逆行移位：列c第r行的字节取自列c-r
+static BS_TARGET __m128i inv_shift_rows_slice(__m128i x) {
+    const __m128i m0 = _mm_set1_epi32(0x000000ff);
+    const __m128i m1 = _mm_set1_epi32(0x0000ff00);
+    const __m128i m2 = _mm_set1_epi32(0x00ff0000);
+    const __m128i m3 = _mm_set1_epi32((int) 0xff000000);
+
+    return (x & m0) |
+           (_mm_shuffle_epi32(x, _MM_SHUFFLE(2, 1, 0, 3)) & m1) |
+           (_mm_shuffle_epi32(x, _MM_SHUFFLE(1, 0, 3, 2)) & m2) |
+           (_mm_shuffle_epi32(x, _MM_SHUFFLE(0, 3, 2, 1)) & m3);
+}
+
+static BS_TARGET void shift_rows(__m128i q[8]) {
+    for (int k = 0; k < 8; k++) {
+        q[k] = shift_rows_slice(q[k]);
+    }
+}
+
+static BS_TARGET void inv_shift_rows(__m128i q[8]) {
+    for (int k = 0; k < 8; k++) {
+        q[k] = inv_shift_rows_slice(q[k]);
+    }
+}
+
+// 切片形式的有限域乘2：左移一位，溢出的最高位按 0x1b (位0、1、3、4) 反馈
+static BS_TARGET void xtime(const __m128i t[8], __m128i out[8]) {
+    out[0] = t[7];
+    out[1] = t[0] ^ t[7];
+    out[2] = t[1];
+    out[3] = t[2] ^ t[7];
+    out[4] = t[3] ^ t[7];
+    out[5] = t[4];
+    out[6] = t[5];
+    out[7] = t[6];
+}
+
+// 列混淆：b_r = 2(a_r ^ a_{r+1}) ^ a_{r+1} ^ a_{r+2} ^ a_{r+3}
+static BS_TARGET void mix_columns(__m128i q[8]) {
+    __m128i a1[8], t[8], t2[8];
+
+    for (int k = 0; k < 8; k++) {
+        a1[k] = ROTR32(q[k], 8);
+        t[k] = q[k] ^ a1[k];
+    }
+    xtime(t, t2);
+    for (int k = 0; k < 8; k++) {
+        q[k] = t2[k] ^ a1[k] ^ ROTR32(t[k], 16);
+    }
+}
+
+// 逆列混淆：先做 a_r ^= 4(a_r ^ a_{r+2})，再做一次列混淆
+static BS_TARGET void inv_mix_columns(__m128i q[8]) {
+    __m128i u[8], u2[8], u4[8];
+
+    for (int k = 0; k < 8; k++) {
+        u[k] = q[k] ^ ROTR32(q[k], 16);
+    }
+    xtime(u, u2);
+    xtime(u2, u4);
+    for (int k = 0; k < 8; k++) {
+        q[k] ^= u4[k];
+    }
+    mix_columns(q);
+}
+
+// 加密一批8个分组
+static BS_TARGET void bs_encrypt8(const __m128i sk[][8], int rounds, const unsigned char* in, unsigned char* out) {
+    __m128i q[8];
+
+    bs_load(in, q);
+    add_round_key(q, sk[0]);
+    for (int round = 1; round < rounds; round++) {
+        sub_bytes(q);
+        shift_rows(q);
+        mix_columns(q);
+        add_round_key(q, sk[round]);
+    }
+    sub_bytes(q);
+    shift_rows(q);
+    add_round_key(q, sk[rounds]);
+    bs_store(q, out);
+}
+
+// 解密一批8个分组（标准逆密码，轮密钥逆序使用）
+static BS_TARGET void bs_decrypt8(const __m128i sk[][8], int rounds, const unsigned char* in, unsigned char* out) {
+    __m128i q[8];
+
+    bs_load(in, q);
+    add_round_key(q, sk[rounds]);
+    for (int round = rounds - 1; round > 0; round--) {
+        inv_shift_rows(q);
+        inv_sub_bytes(q);
+        add_round_key(q, sk[round]);
+        inv_mix_columns(q);
+    }
+    inv_shift_rows(q);
+    inv_sub_bytes(q);
+    add_round_key(q, sk[0]);
+    bs_store(q, out);
+}
+
+// 按批处理分组，最后不足8个的分组补零凑成一批
+static BS_TARGET void bs_crypt_blocks(const unsigned char* round_keys, int rounds, const unsigned char* in,
+                                      unsigned char* out, size_t nblocks, int decrypt) {
+    __m128i sk[BS_MAX_ROUNDS + 1][8];
+    unsigned char buf[AES_BS_BATCH * 16];
+    size_t i = 0;
+
+    for (int round = 0; round <= rounds; round++) {
+        bs_key(round_keys + round * 16, sk[round]);
+    }
+
+    for (; i + AES_BS_BATCH <= nblocks; i += AES_BS_BATCH) {
+        if (decrypt) {
+            bs_decrypt8(sk, rounds, in + i * 16, out + i * 16);
+        } else {
+            bs_encrypt8(sk, rounds, in + i * 16, out + i * 16);
+        }
+    }
+
+    if (i < nblocks) {
+        size_t rest = (nblocks - i) * 16;
+
+        memset(buf, 0, sizeof(buf));
+        memcpy(buf, in + i * 16, rest);
+        if (decrypt) {
+            bs_decrypt8(sk, rounds, buf, buf);
+        } else {
+            bs_encrypt8(sk, rounds, buf, buf);
+        }
+        memcpy(out + i * 16, buf, rest);
+        secure_wipe(buf, sizeof(buf));
+    }
+    secure_wipe(sk, sizeof(sk));
+}
+
+void aes_bs_encrypt_blocks(const unsigned char* round_keys, int rounds,
+                           const unsigned char* in, unsigned char* out, size_t nblocks) {
+    bs_crypt_blocks(round_keys, rounds, in, out, nblocks, 0);
+}
+
+void aes_bs_decrypt_blocks(const unsigned char* round_keys, int rounds,
+                           const unsigned char* in, unsigned char* out, size_t nblocks) {
+    bs_crypt_blocks(round_keys, rounds, in, out, nblocks, 1);
+}
+
+#endif
@@ -0,0 +1,27 @@
+//
+// 位切片 AES - 不查表的常数时间实现，每次并行处理8个分组
+//
+
+#ifndef AES_BITSLICE_H
+#define AES_BITSLICE_H
+
+#include <stddef.h>
+
+#include "cpu_features.h"
+
+// 位切片实现基于SSE2，只在x86上编译
+#define AES_BITSLICE_AVAILABLE CPU_X86
+
+// 每批并行处理的分组数
+#define AES_BS_BATCH 8
+
+#if AES_BITSLICE_AVAILABLE
+// 加密/解密 nblocks 个分组。round_keys 为按加密顺序排列的 (rounds + 1) 个轮密钥，解密时也使用同一份
+// 不足一批的分组会补齐后一起计算，保证执行时间只与分组数量有关
+void aes_bs_encrypt_blocks(const unsigned char *round_keys, int rounds,
+                           const unsigned char *in, unsigned char *out, size_t nblocks);
+void aes_bs_decrypt_blocks(const unsigned char *round_keys, int rounds,
+                           const unsigned char *in, unsigned char *out, size_t nblocks);
+#endif
+
+#endif //AES_BITSLICE_H
@@ -0,0 +1,109 @@
+//
+// AES-CBC 密码分组链接模式
+//
+// 加密：C[i] = E(K, P[i] ^ C[i-1])，必须串行。
+// 解密：P[i] = D(K, C[i]) ^ C[i-1]，各分组的 D(K, C[i]) 互不依赖，
+// 所以每批先用 aes_decrypt_blocks 并行解密 (AES-NI 8路交错 / 位切片 / T表)，再统一异或链接。
+//
+
+#include "aes_cbc.h"
+
+#include <string.h>
+
+#include "crypto_util.h"
+
+static void xor_block(unsigned char *out, const unsigned char *a, const unsigned char *b) {
+    for (int i = 0; i < AES_BLOCK_SIZE; i++) {
+        out[i] = a[i] ^ b[i];
+    }
+}
+
+void aes_cbc_encrypt_blocks(const aes_ctx *ctx, unsigned char *iv, const unsigned char *in, unsigned char *out,
+                            size_t nblocks) {
+    unsigned char block[AES_BLOCK_SIZE];
+
+    for (size_t i = 0; i < nblocks; i++) {
+        xor_block(block, in, iv);
+        aes_encrypt_blocks(ctx, block, out, 1);
+        memcpy(iv, out, AES_BLOCK_SIZE);
+        in += AES_BLOCK_SIZE;
+        out += AES_BLOCK_SIZE;
+    }
+    secure_wipe(block, sizeof(block));
+}
+
+void aes_cbc_decrypt_blocks(const aes_ctx *ctx, unsigned char *iv, const unsigned char *in, unsigned char *out,
+                            size_t nblocks) {
+    unsigned char tmp[AES_CBC_BATCH * AES_BLOCK_SIZE];
+    unsigned char next_iv[AES_BLOCK_SIZE];
+
+    while (nblocks > 0) {
+        size_t n = nblocks < AES_CBC_BATCH ? nblocks : AES_CBC_BATCH;
+
+        aes_decrypt_blocks(ctx, in, tmp, n);
+        memcpy(next_iv, in + (n - 1) * AES_BLOCK_SIZE, AES_BLOCK_SIZE);
+
+        // 从后往前异或，in 与 out 相同时前一个密文分组在用到之前不会被覆盖
+        for (size_t i = n - 1; i > 0; i--) {
+            xor_block(out + i * AES_BLOCK_SIZE, tmp + i * AES_BLOCK_SIZE, in + (i - 1) * AES_BLOCK_SIZE);
+        }
+        xor_block(out, tmp, iv);
+        memcpy(iv, next_iv, AES_BLOCK_SIZE);
+
+        in += n * AES_BLOCK_SIZE;
+        out += n * AES_BLOCK_SIZE;
+        nblocks -= n;
+    }
+    secure_wipe(tmp, sizeof(tmp));
+}
+
+size_t aes_cbc_padded_size(size_t len) {
+    return (len / AES_BLOCK_SIZE + 1) * AES_BLOCK_SIZE;
+}
+
+size_t aes_cbc_encrypt(const aes_ctx *ctx, const unsigned char *iv, const unsigned char *in, size_t len,
+                       unsigned char *out) {
+    unsigned char chain[AES_BLOCK_SIZE];
+    unsigned char last[AES_BLOCK_SIZE];
+    size_t full = len / AES_BLOCK_SIZE;
+    size_t rem = len % AES_BLOCK_SIZE;
+
+    memcpy(chain, iv, AES_BLOCK_SIZE);
+    aes_cbc_encrypt_blocks(ctx, chain, in, out, full);
+
+    // 最后一个分组：剩余明文 + PKCS#7 填充（正好整除时补一个完整的填充分组）
+    memcpy(last, in + full * AES_BLOCK_SIZE, rem);
+    memset(last + rem, (int) (AES_BLOCK_SIZE - rem), AES_BLOCK_SIZE - rem);
+    aes_cbc_encrypt_blocks(ctx, chain, last, out + full * AES_BLOCK_SIZE, 1);
+    secure_wipe(last, sizeof(last));
+
+    return (full + 1) * AES_BLOCK_SIZE;
+}
+
+int aes_cbc_decrypt(const aes_ctx *ctx, const unsigned char *iv, const unsigned char *in, size_t len,
+                    unsigned char *out, size_t *out_len) {
+    unsigned char chain[AES_BLOCK_SIZE];
+    unsigned char pad, bad;
+
+    if (len == 0 || len % AES_BLOCK_SIZE != 0) {
+        return -1;
+    }
+
+    memcpy(chain, iv, AES_BLOCK_SIZE);
+    aes_cbc_decrypt_blocks(ctx, chain, in, out, len / AES_BLOCK_SIZE);
+
+    // 检查填充时不按数据提前退出，避免通过时间差构成填充预言攻击
+    pad = out[len - 1];
+    bad = (unsigned char) ((pad == 0) | (pad > AES_BLOCK_SIZE));
+    for (unsigned int i = 1; i <= AES_BLOCK_SIZE; i++) {
+        unsigned char in_pad = (unsigned char) (i <= pad);
+        bad |= in_pad & (unsigned char) (out[len - i] != pad);
+    }
+    if (bad) {
+        memset(out, 0, len);
+        return -1;
+    }
+
+    *out_len = len - pad;
+    return 0;
+}
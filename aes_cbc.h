@@ -0,0 +1,37 @@
+//
+// AES-CBC 密码分组链接模式
+//
+
+#ifndef AES_CBC_H
+#define AES_CBC_H
+
+#include <stddef.h>
+
+#include "aes.h"
+
+// 解密时每批并行处理的分组数
+#define AES_CBC_BATCH 64
+
+// 加密 nblocks 个完整分组，iv 输入为初始向量，返回时为最后一个密文分组（可用于继续链接）
+// 加密每个分组都依赖上一个密文分组，只能逐个串行处理
+void aes_cbc_encrypt_blocks(const aes_ctx *ctx, unsigned char *iv, const unsigned char *in, unsigned char *out,
+                            size_t nblocks);
+
+// 解密 nblocks 个完整分组，iv 的含义同上；各分组的解密互不依赖，成批交给 aes_decrypt_blocks 并行处理
+// in 与 out 可以相同
+void aes_cbc_decrypt_blocks(const aes_ctx *ctx, unsigned char *iv, const unsigned char *in, unsigned char *out,
+                            size_t nblocks);
+
+// 返回 len 字节明文按 PKCS#7 填充后的密文长度
+size_t aes_cbc_padded_size(size_t len);
+
+// 加密 len 字节并按 PKCS#7 填充，out 至少要有 aes_cbc_padded_size(len) 字节，返回密文长度
+size_t aes_cbc_encrypt(const aes_ctx *ctx, const unsigned char *iv, const unsigned char *in, size_t len,
+                       unsigned char *out);
+
+// 解密并去掉 PKCS#7 填充，out 至少要有 len 字节，明文长度写入 out_len
+// 成功返回0；密文长度不是分组整数倍或填充无效时返回-1
+int aes_cbc_decrypt(const aes_ctx *ctx, const unsigned char *iv, const unsigned char *in, size_t len,
+                    unsigned char *out, size_t *out_len);
+
+#endif //AES_CBC_H
@@ -0,0 +1,123 @@
+//
+// AES-CTR 计数器模式
+//
+// 密钥流 = E(K, counter), E(K, counter + 1), ...，与明文异或得到密文。
+// 各分组的密钥流互不依赖，aes_ctr_blocks 成批生成计数器分组并行加密；
+// 大块数据再按计数器偏移拆给多个线程。本文件负责流式接口和多线程拆分。
+//
+
+#include "aes_ctr.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include "crypto_util.h"
+#include "parallel.h"
+
+// 计数器加 n (128位大端整数加法)
+static void counter_add(unsigned char counter[AES_BLOCK_SIZE], uint64_t n) {
+    uint64_t lo = load64_be(counter + 8) + n;
+
+    if (lo < n) {
+        store64_be(counter, load64_be(counter) + 1);
+    }
+    store64_be(counter + 8, lo);
+}
+
+// 多线程任务：所有线程共享起始计数器，各自从自己的分组偏移开始
+typedef struct {
+    const aes_ctx *aes;
+    const unsigned char *counter;
+    const unsigned char *in;
+    unsigned char *out;
+    size_t nblocks;
+} ctr_job;
+
+static void ctr_worker(void *arg, unsigned int index, unsigned int count) {
+    ctr_job *job = (ctr_job *) arg;
+    unsigned char counter[AES_BLOCK_SIZE];
+
+    // 以批为单位均分，保证每个线程内部都是满批
+    size_t batches = (job->nblocks + AES_CTR_BATCH - 1) / AES_CTR_BATCH;
+    size_t first = batches * index / count * AES_CTR_BATCH;
+    size_t last = batches * (index + 1) / count * AES_CTR_BATCH;
+
+    if (last > job->nblocks) {
+        last = job->nblocks;
+    }
+    if (first >= last) {
+        return;
+    }
+
+    memcpy(counter, job->counter, AES_BLOCK_SIZE);
+    counter_add(counter, first);
+    aes_ctr_blocks(job->aes, counter, job->in + first * AES_BLOCK_SIZE, job->out + first * AES_BLOCK_SIZE,
+                   last - first);
+}
+
+int aes_ctr_init_key(aes_ctr_ctx *ctx, const unsigned char *key, size_t key_len, const unsigned char *iv) {
+    if (aes_init_key(&ctx->aes, key, key_len) != 0) {
+        return -1;
+    }
+    memcpy(ctx->counter, iv, AES_BLOCK_SIZE);
+    memset(ctx->keystream, 0, AES_BLOCK_SIZE);
+    ctx->used = AES_BLOCK_SIZE;
+    ctx->mt_threshold = AES_CTR_DEFAULT_MT_THRESHOLD;
+    ctx->mt_threads = parallel_default_threads();
+    return 0;
+}
+
+void aes_ctr_init(aes_ctr_ctx *ctx, const unsigned char *key, const unsigned char *iv) {
+    aes_ctr_init_key(ctx, key, 16, iv);
+}
+
+void aes_ctr_set_parallel(aes_ctr_ctx *ctx, size_t threshold, unsigned int nthreads) {
+    ctx->mt_threshold = threshold;
+    ctx->mt_threads = nthreads;
+}
+
+void aes_ctr_crypt(aes_ctr_ctx *ctx, const unsigned char *in, unsigned char *out, size_t len) {
+    size_t nblocks;
+
+    // 1. 先用完上次调用剩下的密钥流
+    while (len > 0 && ctx->used < AES_BLOCK_SIZE) {
+        *out++ = *in++ ^ ctx->keystream[ctx->used++];
+        len--;
+    }
+
+    // 2. 完整分组，超过阈值时多线程处理
+    nblocks = len / AES_BLOCK_SIZE;
+    if (nblocks > 0) {
+        if (ctx->mt_threshold > 0 && ctx->mt_threads > 1 && len >= ctx->mt_threshold) {
+            ctr_job job;
+
+            job.aes = &ctx->aes;
+            job.counter = ctx->counter;
+            job.in = in;
+            job.out = out;
+            job.nblocks = nblocks;
+            parallel_run(ctx->mt_threads, ctr_worker, &job);
+            counter_add(ctx->counter, nblocks);
+        } else {
+            aes_ctr_blocks(&ctx->aes, ctx->counter, in, out, nblocks);
+        }
+        in += nblocks * AES_BLOCK_SIZE;
+        out += nblocks * AES_BLOCK_SIZE;
+        len -= nblocks * AES_BLOCK_SIZE;
+    }
+
+    // 3. 末尾不足一个分组：生成一个分组的密钥流，剩余部分留给下次调用
+    if (len > 0) {
+        aes_encrypt_blocks(&ctx->aes, ctx->counter, ctx->keystream, 1);
+        counter_add(ctx->counter, 1);
+        ctx->used = 0;
+        while (len > 0) {
+            *out++ = *in++ ^ ctx->keystream[ctx->used++];
+            len--;
+        }
+    }
+}
+
+void aes_ctr_wipe(aes_ctr_ctx *ctx) {
+    secure_wipe(ctx, sizeof(*ctx));
+}
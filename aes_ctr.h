@@ -0,0 +1,44 @@
+//
+// AES-CTR 计数器模式
+//
+
+#ifndef AES_CTR_H
+#define AES_CTR_H
+
+#include <stddef.h>
+
+#include "aes.h"
+
+// 多线程拆分的粒度（分组数）
+#define AES_CTR_BATCH 64
+
+// 默认的多线程阈值：单次调用超过该长度时按计数器偏移拆分给多个线程
+#define AES_CTR_DEFAULT_MT_THRESHOLD (1u << 20)
+
+// CTR 流式上下文 - 保存计数器和上次未用完的密钥流，可以分多次调用处理任意长度的数据
+typedef struct {
+    aes_ctx aes;                        // 分组密码上下文
+    unsigned char counter[AES_BLOCK_SIZE];   // 下一个要加密的计数器分组 (128位大端整数)
+    unsigned char keystream[AES_BLOCK_SIZE]; // 当前分组的密钥流
+    unsigned int used;                  // keystream 中已经用掉的字节数，16 表示已用完
+    size_t mt_threshold;                // 多线程阈值 (字节)，0 表示不使用多线程
+    unsigned int mt_threads;            // 多线程时的线程数
+} aes_ctr_ctx;
+
+// 用 key_len 字节 (16/24/32) 的密钥和16字节初始计数器初始化上下文，密钥长度无效返回-1
+int aes_ctr_init_key(aes_ctr_ctx *ctx, const unsigned char *key, size_t key_len, const unsigned char *iv);
+
+// 用128位密钥和16字节初始计数器初始化上下文
+void aes_ctr_init(aes_ctr_ctx *ctx, const unsigned char *key, const unsigned char *iv);
+
+// 设置多线程参数：单次调用长度不小于 threshold 时使用 nthreads 个线程，threshold 为0则禁用
+// 初始化后默认为 AES_CTR_DEFAULT_MT_THRESHOLD 和在线CPU核数；工作线程由 parallel.c 的线程池复用
+void aes_ctr_set_parallel(aes_ctr_ctx *ctx, size_t threshold, unsigned int nthreads);
+
+// 加密或解密 len 字节（CTR 模式两者相同），in 与 out 可以相同
+void aes_ctr_crypt(aes_ctr_ctx *ctx, const unsigned char *in, unsigned char *out, size_t len);
+
+// 清除上下文中的密钥和密钥流
+void aes_ctr_wipe(aes_ctr_ctx *ctx);
+
+#endif //AES_CTR_H
@@ -0,0 +1,454 @@
+//
+// AES-GCM 认证加密 (NIST SP 800-38D)
+//
+// 密文 = CTR(K, inc32(J0), 明文)，标签 = E(K, J0) ^ GHASH_H(A || C || len(A) || len(C))。
+// GHASH 是 GF(2^128) 上以 H 为参数的多项式求值，提供两种实现：
+//   - 查表：Shoup 4位表，每个字节两次查表，不依赖任何CPU特性
+//   - CLMUL：PCLMULQDQ 无进位乘法，每8个分组用 H^8..H^1 聚合后只做一次模约简
+// 数据按 AES_GCM_CHUNK 个分组为一段，CTR 加密完立刻对同一段做 GHASH，
+// 这一段还在L1缓存里，整条消息只需从内存读一遍。
+//
+
+#include "aes_gcm.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "cpu_features.h"
+#include "crypto_util.h"
+
+#if CPU_X86
+#include <emmintrin.h>
+#include <tmmintrin.h>
+#include <wmmintrin.h>
+#endif
+
+// ---------------------------------------------------------------------------
+// 查表 GHASH (Shoup 4位表)
+// ---------------------------------------------------------------------------
+
+// 右移4位时移出的4位对应的约简值（已左移48位前的高16位）
+static const uint64_t last4[16] = {
+    0x0000, 0x1c20, 0x3840, 0x2460, 0x7080, 0x6ca0, 0x48c0, 0x54e0,
+    0xe100, 0xfd20, 0xd940, 0xc560, 0x9180, 0x8da0, 0xa9c0, 0xb5e0
+};
+
+// 生成 H 与所有4位多项式的乘积表：hh/hl[i] 为 i*H 的高/低64位（GCM 位序）
+static void ghash_table_init(aes_gcm_ctx *ctx) {
+    uint64_t vh = load64_be(ctx->h);
+    uint64_t vl = load64_be(ctx->h + 8);
+
+    ctx->hh[8] = vh;
+    ctx->hl[8] = vl;
+    ctx->hh[0] = 0;
+    ctx->hl[0] = 0;
+
+    // 4、2、1 对应依次乘以 x
+    for (int i = 4; i > 0; i >>= 1) {
+        uint64_t t = (vl & 1) * 0xe100000000000000ULL;
+        vl = (vh << 63) | (vl >> 1);
+        vh = (vh >> 1) ^ t;
+        ctx->hh[i] = vh;
+        ctx->hl[i] = vl;
+    }
+
+    // 其余表项由线性组合得到
+    for (int i = 2; i <= 8; i *= 2) {
+        for (int j = 1; j < i; j++) {
+            ctx->hh[i + j] = ctx->hh[i] ^ ctx->hh[j];
+            ctx->hl[i + j] = ctx->hl[i] ^ ctx->hl[j];
+        }
+    }
+}
+
+// x = x * H
+static void ghash_table_mult(const aes_gcm_ctx *ctx, unsigned char x[AES_BLOCK_SIZE]) {
+    uint64_t zh, zl;
+    int lo = x[15] & 0xf;
+    int hi, rem;
+
+    zh = ctx->hh[lo];
+    zl = ctx->hl[lo];
+
+    for (int i = 15; i >= 0; i--) {
+        lo = x[i] & 0xf;
+        hi = x[i] >> 4;
+
+        if (i != 15) {
+            rem = (int) (zl & 0xf);
+            zl = (zh << 60) | (zl >> 4);
+            zh = (zh >> 4) ^ (last4[rem] << 48);
+            zh ^= ctx->hh[lo];
+            zl ^= ctx->hl[lo];
+        }
+
+        rem = (int) (zl & 0xf);
+        zl = (zh << 60) | (zl >> 4);
+        zh = (zh >> 4) ^ (last4[rem] << 48);
+        zh ^= ctx->hh[hi];
+        zl ^= ctx->hl[hi];
+    }
+
+    store64_be(x, zh);
+    store64_be(x + 8, zl);
+}
+
+static void ghash_table_blocks(const aes_gcm_ctx *ctx, unsigned char x[AES_BLOCK_SIZE],
+                               const unsigned char *data, size_t nblocks) {
+    while (nblocks-- > 0) {
+        for (int i = 0; i < AES_BLOCK_SIZE; i++) {
+            x[i] ^= data[i];
+        }
+        ghash_table_mult(ctx, x);
+        data += AES_BLOCK_SIZE;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// PCLMULQDQ GHASH
+// ---------------------------------------------------------------------------
+//
+// 分组按字节逆序载入后，GCM 的位反射乘法等价于普通无进位乘法结果左移1位再模约简
+// (Intel《Carry-Less Multiplication and Its Usage for Computing the GCM Mode》)。
+// 左移和约简都是线性的，所以8个乘积可以先累加成256位，再一起左移约简。
+
+#if CPU_X86
+
+#define CLMUL_TARGET __attribute__((target("pclmul,ssse3")))
+
+// 256位乘积累加：lo/hi 为低/高128位，mid 为两个交叉项之和（稍后拼入 lo/hi）
+CLMUL_TARGET
+static inline void clmul_acc(__m128i a, __m128i b, __m128i *lo, __m128i *mid, __m128i *hi) {
+    *lo = _mm_xor_si128(*lo, _mm_clmulepi64_si128(a, b, 0x00));
+    *hi = _mm_xor_si128(*hi, _mm_clmulepi64_si128(a, b, 0x11));
+    *mid = _mm_xor_si128(*mid, _mm_clmulepi64_si128(a, b, 0x10));
+    *mid = _mm_xor_si128(*mid, _mm_clmulepi64_si128(a, b, 0x01));
+}
+
+// 把累加好的256位乘积左移1位并模 x^128 + x^7 + x^2 + x + 1 约简
+CLMUL_TARGET
+static inline __m128i clmul_reduce(__m128i lo, __m128i mid, __m128i hi) {
+    __m128i t7, t8, t9;
+
+    lo = _mm_xor_si128(lo, _mm_slli_si128(mid, 8));
+    hi = _mm_xor_si128(hi, _mm_srli_si128(mid, 8));
+
+    // 256位整体左移1位
+    t7 = _mm_srli_epi32(lo, 31);
+    t8 = _mm_srli_epi32(hi, 31);
+    lo = _mm_slli_epi32(lo, 1);
+    hi = _mm_slli_epi32(hi, 1);
+    t9 = _mm_srli_si128(t7, 12);
+    t8 = _mm_slli_si128(t8, 4);
+    t7 = _mm_slli_si128(t7, 4);
+    lo = _mm_or_si128(lo, t7);
+    hi = _mm_or_si128(hi, t8);
+    hi = _mm_or_si128(hi, t9);
+
+    // 第一步约简
+    t7 = _mm_slli_epi32(lo, 31);
+    t8 = _mm_slli_epi32(lo, 30);
+    t9 = _mm_slli_epi32(lo, 25);
+    t7 = _mm_xor_si128(t7, t8);
+    t7 = _mm_xor_si128(t7, t9);
+    t8 = _mm_srli_si128(t7, 4);
+    t7 = _mm_slli_si128(t7, 12);
+    lo = _mm_xor_si128(lo, t7);
+
+    // 第二步约简
+    t9 = _mm_srli_epi32(lo, 1);
+    t7 = _mm_srli_epi32(lo, 2);
+    t9 = _mm_xor_si128(t9, t7);
+    t7 = _mm_srli_epi32(lo, 7);
+    t9 = _mm_xor_si128(t9, t7);
+    t9 = _mm_xor_si128(t9, t8);
+    lo = _mm_xor_si128(lo, t9);
+
+    return _mm_xor_si128(hi, lo);
+}
+
+CLMUL_TARGET
+static inline __m128i clmul_bswap(__m128i v) {
+    return _mm_shuffle_epi8(v, _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+}
+
+// 预先计算 H^1 .. H^8
+CLMUL_TARGET
+static void ghash_clmul_init(aes_gcm_ctx *ctx) {
+    __m128i h = clmul_bswap(_mm_loadu_si128((const __m128i *) ctx->h));
+    __m128i p = h;
+
+    for (int i = 0; i < AES_GCM_CHUNK; i++) {
+        __m128i lo = _mm_setzero_si128(), mid = _mm_setzero_si128(), hi = _mm_setzero_si128();
+
+        _mm_storeu_si128((__m128i *) ctx->hpow[i], p);
+        clmul_acc(p, h, &lo, &mid, &hi);
+        p = clmul_reduce(lo, mid, hi);
+    }
+}
+
+// 每8个分组：X' = (X ^ C1)·H^8 ^ C2·H^7 ^ ... ^ C8·H，只约简一次
+CLMUL_TARGET
+static void ghash_clmul_blocks(const aes_gcm_ctx *ctx, unsigned char x[AES_BLOCK_SIZE],
+                               const unsigned char *data, size_t nblocks) {
+    __m128i hp[AES_GCM_CHUNK];
+    __m128i acc = clmul_bswap(_mm_loadu_si128((const __m128i *) x));
+
+    for (int i = 0; i < AES_GCM_CHUNK; i++) {
+        hp[i] = _mm_loadu_si128((const __m128i *) ctx->hpow[i]);
+    }
+
+    while (nblocks >= AES_GCM_CHUNK) {
+        __m128i lo = _mm_setzero_si128(), mid = _mm_setzero_si128(), hi = _mm_setzero_si128();
+
+        for (int i = 0; i < AES_GCM_CHUNK; i++) {
+            __m128i d = clmul_bswap(_mm_loadu_si128((const __m128i *) (data + i * AES_BLOCK_SIZE)));
+            if (i == 0) {
+                d = _mm_xor_si128(d, acc);
+            }
+            clmul_acc(d, hp[AES_GCM_CHUNK - 1 - i], &lo, &mid, &hi);
+        }
+        acc = clmul_reduce(lo, mid, hi);
+
+        data += AES_GCM_CHUNK * AES_BLOCK_SIZE;
+        nblocks -= AES_GCM_CHUNK;
+    }
+
+    while (nblocks-- > 0) {
+        __m128i lo = _mm_setzero_si128(), mid = _mm_setzero_si128(), hi = _mm_setzero_si128();
+        __m128i d = clmul_bswap(_mm_loadu_si128((const __m128i *) data));
+
+        clmul_acc(_mm_xor_si128(d, acc), hp[0], &lo, &mid, &hi);
+        acc = clmul_reduce(lo, mid, hi);
+        data += AES_BLOCK_SIZE;
+    }
+
+    _mm_storeu_si128((__m128i *) x, clmul_bswap(acc));
+}
+
+#endif // CPU_X86
+
+// ---------------------------------------------------------------------------
+// GCM
+// ---------------------------------------------------------------------------
+
+// 对完整分组做 GHASH
+static void ghash_blocks(const aes_gcm_ctx *ctx, unsigned char x[AES_BLOCK_SIZE],
+                         const unsigned char *data, size_t nblocks) {
+#if CPU_X86
+    if (ctx->ghash == GHASH_IMPL_CLMUL) {
+        ghash_clmul_blocks(ctx, x, data, nblocks);
+        return;
+    }
+#endif
+    ghash_table_blocks(ctx, x, data, nblocks);
+}
+
+// 对任意长度的数据做 GHASH，末尾不足一个分组时补零
+static void ghash_update(const aes_gcm_ctx *ctx, unsigned char x[AES_BLOCK_SIZE],
+                         const unsigned char *data, size_t len) {
+    size_t nblocks = len / AES_BLOCK_SIZE;
+    size_t rem = len % AES_BLOCK_SIZE;
+
+    ghash_blocks(ctx, x, data, nblocks);
+    if (rem > 0) {
+        unsigned char block[AES_BLOCK_SIZE] = {0};
+
+        memcpy(block, data + nblocks * AES_BLOCK_SIZE, rem);
+        ghash_blocks(ctx, x, block, 1);
+    }
+}
+
+// GCM 计数器只对低32位加1 (inc32)，而 aes_ctr_blocks 做128位加法，
+// 所以在低32位回绕处拆开调用，并恢复高96位
+static void gcm_ctr_blocks(const aes_gcm_ctx *ctx, unsigned char ctr[AES_BLOCK_SIZE],
+                           const unsigned char *in, unsigned char *out, size_t nblocks) {
+    while (nblocks > 0) {
+        uint64_t room = 0x100000000ULL - load32_be(ctr + 12);
+        size_t n = (uint64_t) nblocks < room ? nblocks : (size_t) room;
+        unsigned char high[12];
+
+        memcpy(high, ctr, sizeof(high));
+        aes_ctr_blocks(&ctx->aes, ctr, in, out, n);
+        memcpy(ctr, high, sizeof(high));
+
+        in += n * AES_BLOCK_SIZE;
+        out += n * AES_BLOCK_SIZE;
+        nblocks -= n;
+    }
+}
+
+// 由 IV 得到初始计数器 J0：12字节 IV 直接拼接 0x00000001，其他长度经 GHASH 派生
+static void gcm_j0(const aes_gcm_ctx *ctx, const unsigned char *iv, size_t iv_len,
+                   unsigned char j0[AES_BLOCK_SIZE]) {
+    if (iv_len == 12) {
+        memcpy(j0, iv, 12);
+        j0[12] = 0;
+        j0[13] = 0;
+        j0[14] = 0;
+        j0[15] = 1;
+    } else {
+        unsigned char lens[AES_BLOCK_SIZE] = {0};
+
+        memset(j0, 0, AES_BLOCK_SIZE);
+        ghash_update(ctx, j0, iv, iv_len);
+        store64_be(lens + 8, (uint64_t) iv_len * 8);
+        ghash_blocks(ctx, j0, lens, 1);
+    }
+}
+
+// CTR 加解密与 GHASH 按段交替进行；GHASH 总是作用在密文上，
+// 所以解密时先哈希再解密（允许 in 与 out 相同）
+static void gcm_crypt(const aes_gcm_ctx *ctx, unsigned char ctr[AES_BLOCK_SIZE], unsigned char x[AES_BLOCK_SIZE],
+                      const unsigned char *in, unsigned char *out, size_t len, int decrypt) {
+    size_t nblocks = len / AES_BLOCK_SIZE;
+    size_t rem = len % AES_BLOCK_SIZE;
+
+    while (nblocks > 0) {
+        size_t n = nblocks < AES_GCM_CHUNK ? nblocks : AES_GCM_CHUNK;
+
+        if (decrypt) {
+            ghash_blocks(ctx, x, in, n);
+        }
+        gcm_ctr_blocks(ctx, ctr, in, out, n);
+        if (!decrypt) {
+            ghash_blocks(ctx, x, out, n);
+        }
+
+        in += n * AES_BLOCK_SIZE;
+        out += n * AES_BLOCK_SIZE;
+        nblocks -= n;
+    }
+
+    // 末尾不足一个分组：补零后处理，GHASH 的输入是补零的密文
+    if (rem > 0) {
+        unsigned char block[AES_BLOCK_SIZE] = {0};
+
+        memcpy(block, in, rem);
+        if (decrypt) {
+            ghash_blocks(ctx, x, block, 1);
+        }
+        gcm_ctr_blocks(ctx, ctr, block, block, 1);
+        memcpy(out, block, rem);
+        if (!decrypt) {
+            memset(block + rem, 0, AES_BLOCK_SIZE - rem);
+            ghash_blocks(ctx, x, block, 1);
+        }
+        secure_wipe(block, sizeof(block));
+    }
+}
+
+// 检查 SP 800-38D 的参数要求：IV 非空，标签长度为 4、8 或 12~16 字节
+static int gcm_params_valid(size_t iv_len, size_t tag_len) {
+    if (iv_len == 0) {
+        return 0;
+    }
+    return tag_len == 4 || tag_len == 8 || (tag_len >= 12 && tag_len <= AES_GCM_TAG_SIZE);
+}
+
+// 完整计算一次 GCM，输出16字节标签
+static void gcm_process(const aes_gcm_ctx *ctx, const unsigned char *iv, size_t iv_len,
+                        const unsigned char *aad, size_t aad_len,
+                        const unsigned char *in, unsigned char *out, size_t len,
+                        unsigned char tag[AES_BLOCK_SIZE], int decrypt) {
+    unsigned char j0[AES_BLOCK_SIZE], ctr[AES_BLOCK_SIZE];
+    unsigned char x[AES_BLOCK_SIZE] = {0};
+    unsigned char lens[AES_BLOCK_SIZE];
+
+    gcm_j0(ctx, iv, iv_len, j0);
+
+    ghash_update(ctx, x, aad, aad_len);
+
+    // 第一个数据分组使用 inc32(J0)
+    memcpy(ctr, j0, AES_BLOCK_SIZE);
+    for (int i = AES_BLOCK_SIZE - 1; i >= 12 && ++ctr[i] == 0; i--) {
+    }
+    gcm_crypt(ctx, ctr, x, in, out, len, decrypt);
+
+    store64_be(lens, (uint64_t) aad_len * 8);
+    store64_be(lens + 8, (uint64_t) len * 8);
+    ghash_blocks(ctx, x, lens, 1);
+
+    aes_encrypt_blocks(&ctx->aes, j0, tag, 1);
+    for (int i = 0; i < AES_BLOCK_SIZE; i++) {
+        tag[i] ^= x[i];
+    }
+}
+
+int aes_gcm_init_key(aes_gcm_ctx *ctx, const unsigned char *key, size_t key_len) {
+    const char *env = getenv("GHASH_IMPL");
+    int clmul = 0;
+
+    if (aes_init_key(&ctx->aes, key, key_len) != 0) {
+        return -1;
+    }
+
+    memset(ctx->h, 0, AES_BLOCK_SIZE);
+    aes_encrypt_blocks(&ctx->aes, ctx->h, ctx->h, 1);
+    ghash_table_init(ctx);
+    memset(ctx->hpow, 0, sizeof(ctx->hpow));
+
+#if CPU_X86
+    clmul = cpu_has(CPU_PCLMUL | CPU_SSSE3) && !(env && strcmp(env, "table") == 0);
+    if (clmul) {
+        ghash_clmul_init(ctx);
+    }
+#else
+    (void) env;
+#endif
+    ctx->ghash = clmul ? GHASH_IMPL_CLMUL : GHASH_IMPL_TABLE;
+    return 0;
+}
+
+void aes_gcm_init(aes_gcm_ctx *ctx, const unsigned char *key) {
+    aes_gcm_init_key(ctx, key, 16);
+}
+
+const char *aes_gcm_ghash_name(const aes_gcm_ctx *ctx) {
+    return ctx->ghash == GHASH_IMPL_CLMUL ? "clmul" : "table";
+}
+
+int aes_gcm_encrypt(const aes_gcm_ctx *ctx, const unsigned char *iv, size_t iv_len,
+                    const unsigned char *aad, size_t aad_len,
+                    const unsigned char *in, unsigned char *out, size_t len,
+                    unsigned char *tag, size_t tag_len) {
+    unsigned char full[AES_BLOCK_SIZE];
+
+    if (!gcm_params_valid(iv_len, tag_len)) {
+        return -1;
+    }
+    gcm_process(ctx, iv, iv_len, aad, aad_len, in, out, len, full, 0);
+    memcpy(tag, full, tag_len);
+    secure_wipe(full, sizeof(full));
+    return 0;
+}
+
+int aes_gcm_decrypt(const aes_gcm_ctx *ctx, const unsigned char *iv, size_t iv_len,
+                    const unsigned char *aad, size_t aad_len,
+                    const unsigned char *in, unsigned char *out, size_t len,
+                    const unsigned char *tag, size_t tag_len) {
+    unsigned char full[AES_BLOCK_SIZE];
+    unsigned char diff = 0;
+
+    if (!gcm_params_valid(iv_len, tag_len)) {
+        memset(out, 0, len);
+        return -1;
+    }
+
+    gcm_process(ctx, iv, iv_len, aad, aad_len, in, out, len, full, 1);
+
+    // 常数时间比较，避免泄露匹配的前缀长度
+    for (size_t i = 0; i < tag_len; i++) {
+        diff |= full[i] ^ tag[i];
+    }
+    secure_wipe(full, sizeof(full));
+    if (diff != 0) {
+        memset(out, 0, len);
+        return -1;
+    }
+    return 0;
+}
+
+void aes_gcm_wipe(aes_gcm_ctx *ctx) {
+    secure_wipe(ctx, sizeof(*ctx));
+}
@@ -0,0 +1,61 @@
+//
+// AES-GCM 认证加密 (NIST SP 800-38D)
+//
+
+#ifndef AES_GCM_H
+#define AES_GCM_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "aes.h"
+
+// 认证标签的最大长度（字节）
+#define AES_GCM_TAG_SIZE 16
+
+// CTR 加密与 GHASH 交替处理的粒度（分组数），与 AES-NI 的8路并行宽度一致
+#define AES_GCM_CHUNK 8
+
+// GHASH 实现
+typedef enum {
+    GHASH_IMPL_TABLE = 0,   // 4位查表 (Shoup)，纯C实现
+    GHASH_IMPL_CLMUL        // PCLMULQDQ 无进位乘法
+} ghash_impl_t;
+
+// GCM 上下文 - 初始化时计算哈希子密钥 H 及其查表/幂次，之后可反复用于不同的 IV 和消息
+typedef struct {
+    aes_ctx aes;                                    // 分组密码上下文
+    unsigned char h[AES_BLOCK_SIZE];                // 哈希子密钥 H = E(K, 0^128)
+    uint64_t hl[16], hh[16];                        // 查表实现：H 与各4位多项式之积
+    unsigned char hpow[AES_GCM_CHUNK][AES_BLOCK_SIZE]; // CLMUL 实现：H^1 .. H^8（字节逆序）
+    ghash_impl_t ghash;                             // 使用的 GHASH 实现
+} aes_gcm_ctx;
+
+// 用 key_len 字节 (16/24/32) 的密钥初始化上下文，密钥长度无效返回-1
+// GHASH 实现默认按CPU特性选择，环境变量 GHASH_IMPL=table/clmul 可以强制指定
+int aes_gcm_init_key(aes_gcm_ctx *ctx, const unsigned char *key, size_t key_len);
+
+// 用128位密钥初始化上下文
+void aes_gcm_init(aes_gcm_ctx *ctx, const unsigned char *key);
+
+// 返回 GHASH 实现的名字
+const char *aes_gcm_ghash_name(const aes_gcm_ctx *ctx);
+
+// 加密 len 字节并输出 tag_len 字节的认证标签，aad 只认证不加密，in 与 out 可以相同
+// tag_len 只能是 SP 800-38D 允许的 4、8、12~16；IV 不能为空，推荐使用12字节，其他长度按标准经 GHASH 派生初始计数器
+// 成功返回0，标签长度或 IV 长度无效返回-1 (不写 out 和 tag)
+int aes_gcm_encrypt(const aes_gcm_ctx *ctx, const unsigned char *iv, size_t iv_len,
+                     const unsigned char *aad, size_t aad_len,
+                     const unsigned char *in, unsigned char *out, size_t len,
+                     unsigned char *tag, size_t tag_len);
+
+// 解密并验证认证标签，成功返回0；标签不匹配，或标签长度、IV 长度无效 (要求同上) 返回-1，并把 out 清零
+int aes_gcm_decrypt(const aes_gcm_ctx *ctx, const unsigned char *iv, size_t iv_len,
+                    const unsigned char *aad, size_t aad_len,
+                    const unsigned char *in, unsigned char *out, size_t len,
+                    const unsigned char *tag, size_t tag_len);
+
+// 清除上下文中的密钥和哈希子密钥
+void aes_gcm_wipe(aes_gcm_ctx *ctx);
+
+#endif //AES_GCM_H
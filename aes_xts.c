@@ -0,0 +1,201 @@
+//
+// XTS-AES 存储扇区加密 (IEEE 1619 / NIST SP 800-38E)
+//
+// 扇区 s 的第 j 个分组：T = E(K2, s) · α^j，C = E(K1, P ^ T) ^ T，α 为 GF(2^128) 中的 x。
+// 各扇区完全独立：
+//   - 每 AES_XTS_LANES 个扇区的初始调整值用一次 aes_encrypt_blocks 成批计算
+//   - 扇区内的调整值用 SSE2 做 GF(2^128) 乘 x 连续生成，整段异或后交给 aes_encrypt_blocks
+//   - 大块数据按扇区拆给多个线程
+//
+
+#include "aes_xts.h"
+
+#include <string.h>
+
+#include "cpu_features.h"
+#include "crypto_util.h"
+#include "parallel.h"
+
+#if CPU_X86
+#include <emmintrin.h>
+#endif
+
+// 生成 n 个连续的调整值：tweaks[0] = t，之后每个乘以 x，返回时 t 为下一个调整值
+// 调整值为128位小端整数，乘 x 即左移1位，移出最高位时异或 0x87
+#if CPU_X86
+static void xts_tweaks(unsigned char t[AES_BLOCK_SIZE], unsigned char *tweaks, size_t n) {
+    const __m128i poly = _mm_set_epi32(0, 1, 0, 0x87);
+    __m128i x = _mm_loadu_si128((const __m128i *) t);
+
+    for (size_t i = 0; i < n; i++) {
+        __m128i carry;
+
+        _mm_storeu_si128((__m128i *) (tweaks + i * AES_BLOCK_SIZE), x);
+
+        // 两个64位半各自左移1位；低半的最高位进到高半，高半的最高位折回 0x87
+        carry = _mm_srai_epi32(_mm_shuffle_epi32(x, _MM_SHUFFLE(1, 1, 3, 3)), 31);
+        x = _mm_xor_si128(_mm_slli_epi64(x, 1), _mm_and_si128(carry, poly));
+    }
+    _mm_storeu_si128((__m128i *) t, x);
+}
+#else
+static void xts_tweaks(unsigned char t[AES_BLOCK_SIZE], unsigned char *tweaks, size_t n) {
+    uint64_t lo = load64_le(t);
+    uint64_t hi = load64_le(t + 8);
+
+    for (size_t i = 0; i < n; i++) {
+        uint64_t carry = hi >> 63;
+
+        store64_le(tweaks + i * AES_BLOCK_SIZE, lo);
+        store64_le(tweaks + i * AES_BLOCK_SIZE + 8, hi);
+        hi = (hi << 1) | (lo >> 63);
+        lo = (lo << 1) ^ (carry * 0x87);
+    }
+    store64_le(t, lo);
+    store64_le(t + 8, hi);
+}
+#endif
+
+static void xor_blocks(unsigned char *out, const unsigned char *a, const unsigned char *b, size_t nblocks) {
+    for (size_t i = 0; i < nblocks * AES_BLOCK_SIZE; i++) {
+        out[i] = a[i] ^ b[i];
+    }
+}
+
+// 处理一个扇区，t 为该扇区的初始调整值
+static void xts_sector(const aes_xts_ctx *ctx, unsigned char t[AES_BLOCK_SIZE], const unsigned char *in,
+                       unsigned char *out, int decrypt) {
+    unsigned char tweaks[AES_XTS_CHUNK * AES_BLOCK_SIZE];
+    size_t nblocks = ctx->sector_size / AES_BLOCK_SIZE;
+
+    while (nblocks > 0) {
+        size_t n = nblocks < AES_XTS_CHUNK ? nblocks : AES_XTS_CHUNK;
+
+        xts_tweaks(t, tweaks, n);
+        xor_blocks(out, in, tweaks, n);
+        if (decrypt) {
+            aes_decrypt_blocks(&ctx->data, out, out, n);
+        } else {
+            aes_encrypt_blocks(&ctx->data, out, out, n);
+        }
+        xor_blocks(out, out, tweaks, n);
+
+        in += n * AES_BLOCK_SIZE;
+        out += n * AES_BLOCK_SIZE;
+        nblocks -= n;
+    }
+    secure_wipe(tweaks, sizeof(tweaks));
+}
+
+// 单线程处理一串连续扇区：每 AES_XTS_LANES 个扇区先成批加密扇区号，再逐个处理扇区
+// 扇区号为128位整数 sector_hi:sector，低64位越过 2^64 时进位到高64位，不会重复使用调整值
+static void xts_sectors(const aes_xts_ctx *ctx, uint64_t sector, uint64_t sector_hi, const unsigned char *in,
+                        unsigned char *out, size_t nsectors, int decrypt) {
+    unsigned char t[AES_XTS_LANES][AES_BLOCK_SIZE];
+
+    while (nsectors > 0) {
+        size_t n = nsectors < AES_XTS_LANES ? nsectors : AES_XTS_LANES;
+
+        // 扇区号作为128位小端整数，前 n 个调整值的16字节都会写满
+        for (size_t i = 0; i < n; i++) {
+            uint64_t s = sector + i;
+            uint64_t hi = sector_hi + (s < sector);
+            for (int j = 0; j < 8; j++) {
+                t[i][j] = (unsigned char) (s >> (8 * j));
+                t[i][8 + j] = (unsigned char) (hi >> (8 * j));
+            }
+        }
+        aes_encrypt_blocks(&ctx->tweak, t[0], t[0], n);
+
+        for (size_t i = 0; i < n; i++) {
+            xts_sector(ctx, t[i], in, out, decrypt);
+            in += ctx->sector_size;
+            out += ctx->sector_size;
+        }
+
+        sector += n;
+        if (sector < n) {
+            sector_hi++;
+        }
+        nsectors -= n;
+    }
+    secure_wipe(t, sizeof(t));
+}
+
+// 多线程任务：每个线程处理一段连续的扇区
+typedef struct {
+    const aes_xts_ctx *ctx;
+    uint64_t sector;
+    const unsigned char *in;
+    unsigned char *out;
+    size_t nsectors;
+    int decrypt;
+} xts_job;
+
+static void xts_worker(void *arg, unsigned int index, unsigned int count) {
+    xts_job *job = (xts_job *) arg;
+    size_t first = job->nsectors * index / count;
+    size_t last = job->nsectors * (index + 1) / count;
+
+    if (first < last) {
+        uint64_t sector = job->sector + first;
+
+        xts_sectors(job->ctx, sector, sector < job->sector, job->in + first * job->ctx->sector_size,
+                    job->out + first * job->ctx->sector_size, last - first, job->decrypt);
+    }
+}
+
+static void xts_crypt(const aes_xts_ctx *ctx, uint64_t sector, const unsigned char *in, unsigned char *out,
+                      size_t nsectors, int decrypt) {
+    if (ctx->mt_threshold > 0 && ctx->mt_threads > 1 && nsectors > 1 &&
+        nsectors * ctx->sector_size >= ctx->mt_threshold) {
+        xts_job job;
+
+        job.ctx = ctx;
+        job.sector = sector;
+        job.in = in;
+        job.out = out;
+        job.nsectors = nsectors;
+        job.decrypt = decrypt;
+        parallel_run(nsectors < ctx->mt_threads ? (unsigned int) nsectors : ctx->mt_threads, xts_worker, &job);
+        return;
+    }
+    xts_sectors(ctx, sector, 0, in, out, nsectors, decrypt);
+}
+
+int aes_xts_init(aes_xts_ctx *ctx, const unsigned char *key, size_t key_len, size_t sector_size) {
+    size_t half = key_len / 2;
+
+    if ((key_len != 32 && key_len != 64) || sector_size == 0 || sector_size % AES_BLOCK_SIZE != 0) {
+        return -1;
+    }
+    // IEEE 1619-2007 要求 K1 与 K2 不同
+    if (memcmp(key, key + half, half) == 0) {
+        return -1;
+    }
+    aes_init_key(&ctx->data, key, half);
+    aes_init_key(&ctx->tweak, key + half, half);
+    ctx->sector_size = sector_size;
+    ctx->mt_threshold = AES_XTS_DEFAULT_MT_THRESHOLD;
+    ctx->mt_threads = parallel_default_threads();
+    return 0;
+}
+
+void aes_xts_set_parallel(aes_xts_ctx *ctx, size_t threshold, unsigned int nthreads) {
+    ctx->mt_threshold = threshold;
+    ctx->mt_threads = nthreads;
+}
+
+void aes_xts_encrypt_sectors(const aes_xts_ctx *ctx, uint64_t sector, const unsigned char *in, unsigned char *out,
+                             size_t nsectors) {
+    xts_crypt(ctx, sector, in, out, nsectors, 0);
+}
+
+void aes_xts_decrypt_sectors(const aes_xts_ctx *ctx, uint64_t sector, const unsigned char *in, unsigned char *out,
+                             size_t nsectors) {
+    xts_crypt(ctx, sector, in, out, nsectors, 1);
+}
+
+void aes_xts_wipe(aes_xts_ctx *ctx) {
+    secure_wipe(ctx, sizeof(*ctx));
+}
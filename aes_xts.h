@@ -0,0 +1,49 @@
+//
+// XTS-AES 存储扇区加密 (IEEE 1619 / NIST SP 800-38E)
+//
+
+#ifndef AES_XTS_H
+#define AES_XTS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "aes.h"
+
+// 每次成批计算初始调整值 (tweak) 的扇区数，与 AES-NI 的8路并行宽度一致
+#define AES_XTS_LANES 8
+
+// 扇区内每段处理的分组数：调整值先生成到缓冲区，再整段交给 aes_encrypt_blocks
+#define AES_XTS_CHUNK 64
+
+// 默认的多线程阈值：单次调用超过该长度时按扇区拆分给多个线程
+#define AES_XTS_DEFAULT_MT_THRESHOLD (1u << 20)
+
+// XTS 上下文 - 数据密钥 K1 和调整值密钥 K2 各自扩展一次
+typedef struct {
+    aes_ctx data;               // K1，加解密扇区数据
+    aes_ctx tweak;              // K2，加密扇区号得到初始调整值
+    size_t sector_size;         // 扇区大小（字节），16的整数倍
+    size_t mt_threshold;        // 多线程阈值 (字节)，0 表示不使用多线程
+    unsigned int mt_threads;    // 多线程时的线程数
+} aes_xts_ctx;
+
+// 初始化：key 为 K1 || K2，key_len 为32或64字节 (XTS-AES-128/256)
+// sector_size 必须是16的正整数倍；参数无效或 K1 与 K2 相同 (IEEE 1619-2007 不允许) 返回-1
+int aes_xts_init(aes_xts_ctx *ctx, const unsigned char *key, size_t key_len, size_t sector_size);
+
+// 设置多线程参数：单次调用长度不小于 threshold 时使用 nthreads 个线程，threshold 为0则禁用
+// 初始化后默认为 AES_XTS_DEFAULT_MT_THRESHOLD 和在线CPU核数
+void aes_xts_set_parallel(aes_xts_ctx *ctx, size_t threshold, unsigned int nthreads);
+
+// 加密/解密从扇区号 sector 开始的 nsectors 个连续扇区，数据长度为 nsectors * sector_size
+// 扇区号按128位小端整数作为调整值，一串扇区越过 2^64 时继续进位到高64位，in 与 out 可以相同
+void aes_xts_encrypt_sectors(const aes_xts_ctx *ctx, uint64_t sector, const unsigned char *in, unsigned char *out,
+                             size_t nsectors);
+void aes_xts_decrypt_sectors(const aes_xts_ctx *ctx, uint64_t sector, const unsigned char *in, unsigned char *out,
+                             size_t nsectors);
+
+// 清除上下文中的密钥
+void aes_xts_wipe(aes_xts_ctx *ctx);
+
+#endif //AES_XTS_H
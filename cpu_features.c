@@ -0,0 +1,67 @@
+//
+// CPU 特性检测
+//
+
+#include "cpu_features.h"
+
+#if CPU_X86
+#include <cpuid.h>
+
+// 读取扩展控制寄存器XCR0，判断操作系统是否保存了AVX/AVX-512寄存器状态
+static unsigned long long read_xcr0(void) {
+    unsigned int eax, edx;
+    __asm__ volatile ("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return ((unsigned long long) edx << 32) | eax;
+}
+
+// 通过CPUID检测特性
+static unsigned int detect_features(void) {
+    unsigned int eax, ebx, ecx, edx;
+    unsigned int features = 0;
+    unsigned long long xcr0 = 0;
+
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+        return 0;
+    }
+
+    if (edx & (1u << 26)) features |= CPU_SSE2;
+    if (ecx & (1u << 9)) features |= CPU_SSSE3;
+    if (ecx & (1u << 19)) features |= CPU_SSE41;
+    if (ecx & (1u << 25)) features |= CPU_AESNI;
+    if (ecx & (1u << 1)) features |= CPU_PCLMUL;
+
+    // OSXSAVE 置位时才能用 xgetbv 查询操作系统支持的寄存器状态
+    if (ecx & (1u << 27)) {
+        xcr0 = read_xcr0();
+    }
+
+    if (__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
+        // AVX2 需要操作系统保存 XMM/YMM 状态 (XCR0 位1、2)
+        if ((ebx & (1u << 5)) && (xcr0 & 0x6) == 0x6) features |= CPU_AVX2;
+        // AVX-512 还需要保存 opmask/ZMM 状态 (XCR0 位5、6、7)
+        if ((ebx & (1u << 16)) && (xcr0 & 0xe6) == 0xe6) features |= CPU_AVX512F;
+        if (ebx & (1u << 29)) features |= CPU_SHANI;
+    }
+
+    return features;
+}
+#else
+static unsigned int detect_features(void) {
+    return 0;
+}
+#endif
+
+unsigned int cpu_features(void) {
+    static int detected = 0;
+    static unsigned int features = 0;
+
+    if (!detected) {
+        features = detect_features();
+        detected = 1;
+    }
+    return features;
+}
+
+int cpu_has(unsigned int features) {
+    return (cpu_features() & features) == features;
+}
@@ -0,0 +1,31 @@
+//
+// CPU 特性检测 - 供各算法在运行时选择硬件加速实现
+//
+
+#ifndef CPU_FEATURES_H
+#define CPU_FEATURES_H
+
+// 是否为可使用 x86 内建函数和 target 属性的编译环境
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define CPU_X86 1
+#else
+#define CPU_X86 0
+#endif
+
+// 特性位
+#define CPU_SSE2     (1u << 0)
+#define CPU_SSSE3    (1u << 1)
+#define CPU_SSE41    (1u << 2)
+#define CPU_AESNI    (1u << 3)
+#define CPU_PCLMUL   (1u << 4)
+#define CPU_AVX2     (1u << 5)
+#define CPU_AVX512F  (1u << 6)
+#define CPU_SHANI    (1u << 7)
+
+// 返回当前CPU支持的特性位集合（第一次调用时通过CPUID检测，之后使用缓存结果）
+unsigned int cpu_features(void);
+
+// 判断是否同时支持 features 中的所有特性
+int cpu_has(unsigned int features);
+
+#endif //CPU_FEATURES_H
@@ -0,0 +1,95 @@
+//
+// 各算法共用的小工具 - 大小端读写和不会被优化掉的清零，只供内部使用
+//
+
+#ifndef CRYPTO_UTIL_H
+#define CRYPTO_UTIL_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__GNUC__) && defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define CRYPTO_LITTLE_ENDIAN 1
+#else
+#define CRYPTO_LITTLE_ENDIAN 0
+#endif
+
+// 按大端序读写32/64位字：小端机器上用一次 memcpy 加字节反转代替逐字节拼接
+static inline uint32_t load32_be(const unsigned char *p) {
+#if CRYPTO_LITTLE_ENDIAN
+    uint32_t v;
+    memcpy(&v, p, 4);
+    return __builtin_bswap32(v);
+#else
+    return ((uint32_t) p[0] << 24) | ((uint32_t) p[1] << 16) | ((uint32_t) p[2] << 8) | (uint32_t) p[3];
+#endif
+}
+
+static inline void store32_be(unsigned char *p, uint32_t v) {
+#if CRYPTO_LITTLE_ENDIAN
+    v = __builtin_bswap32(v);
+    memcpy(p, &v, 4);
+#else
+    p[0] = (unsigned char) (v >> 24);
+    p[1] = (unsigned char) (v >> 16);
+    p[2] = (unsigned char) (v >> 8);
+    p[3] = (unsigned char) v;
+#endif
+}
+
+static inline uint64_t load64_be(const unsigned char *p) {
+#if CRYPTO_LITTLE_ENDIAN
+    uint64_t v;
+    memcpy(&v, p, 8);
+    return __builtin_bswap64(v);
+#else
+    return ((uint64_t) load32_be(p) << 32) | load32_be(p + 4);
+#endif
+}
+
+static inline void store64_be(unsigned char *p, uint64_t v) {
+#if CRYPTO_LITTLE_ENDIAN
+    v = __builtin_bswap64(v);
+    memcpy(p, &v, 8);
+#else
+    store32_be(p, (uint32_t) (v >> 32));
+    store32_be(p + 4, (uint32_t) v);
+#endif
+}
+
+// 按小端序读写64位字
+static inline uint64_t load64_le(const unsigned char *p) {
+#if CRYPTO_LITTLE_ENDIAN
+    uint64_t v;
+    memcpy(&v, p, 8);
+    return v;
+#else
+    uint64_t v = 0;
+    for (int i = 7; i >= 0; i--) {
+        v = (v << 8) | p[i];
+    }
+    return v;
+#endif
+}
+
+static inline void store64_le(unsigned char *p, uint64_t v) {
+#if CRYPTO_LITTLE_ENDIAN
+    memcpy(p, &v, 8);
+#else
+    for (int i = 0; i < 8; i++) {
+        p[i] = (unsigned char) (v >> (8 * i));
+    }
+#endif
+}
+
+// 清除密钥等敏感数据 - 通过volatile指针写零，避免被编译器当作无用的写入优化掉
+static inline void secure_wipe(void *p, size_t len) {
+    volatile unsigned char *v = (volatile unsigned char *) p;
+
+    for (size_t i = 0; i < len; i++) {
+        v[i] = 0;
+    }
+}
+
+#endif //CRYPTO_UTIL_H
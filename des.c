@@ -1,111 +1,479 @@
 // des.c
 #include "des.h"
 
-// --- DES 标准中定义的常量表 ---
-
-// 初始置换表 (IP)
-static const uint8_t ip_table[64] = {
-    58, 50, 42, 34, 26, 18, 10, 2, 60, 52, 44, 36, 28, 20, 12, 4,
-    62, 54, 46, 38, 30, 22, 14, 6, 64, 56, 48, 40, 32, 24, 16, 8,
-    57, 49, 41, 33, 25, 17, 9, 1, 59, 51, 43, 35, 27, 19, 11, 3,
-    61, 53, 45, 37, 29, 21, 13, 5, 63, 55, 47, 39, 31, 23, 15, 7
-};
-
-// 最终置换表 (IP^-1)
-static const uint8_t fp_table[64] = {
-    40, 8, 48, 16, 56, 24, 64, 32, 39, 7, 47, 15, 55, 23, 63, 31,
-    38, 6, 46, 14, 54, 22, 62, 30, 37, 5, 45, 13, 53, 21, 61, 29,
-    36, 4, 44, 12, 52, 20, 60, 28, 35, 3, 43, 11, 51, 19, 59, 27,
-    34, 2, 42, 10, 50, 18, 58, 26, 33, 1, 41, 9, 49, 17, 57, 25
-};
+#include <string.h>
 
-// 扩展置换表 (E)
-static const uint8_t e_table[48] = {
-    32, 1, 2, 3, 4, 5, 4, 5, 6, 7, 8, 9,
-    8, 9, 10, 11, 12, 13, 12, 13, 14, 15, 16, 17,
-    16, 17, 18, 19, 20, 21, 20, 21, 22, 23, 24, 25,
-    24, 25, 26, 27, 28, 29, 28, 29, 30, 31, 32, 1
-};
+#include "crypto_util.h"
+#include "des_bitslice.h"
 
-// P-盒置换表
-static const uint8_t p_table[32] = {
-    16, 7, 20, 21, 29, 12, 28, 17, 1, 15, 23, 26, 5, 18, 31, 10,
-    2, 8, 24, 14, 32, 27, 3, 9, 19, 13, 30, 6, 22, 11, 4, 25
-};
+// --- DES 标准中定义的常量表 ---
 
-// 密钥置换选择表1 (PC-1)
-static const uint8_t pc1_table[56] = {
-    57, 49, 41, 33, 25, 17, 9, 1, 58, 50, 42, 34, 26, 18,
-    10, 2, 59, 51, 43, 35, 27, 19, 11, 3, 60, 52, 44, 36,
-    63, 55, 47, 39, 31, 23, 15, 7, 62, 54, 46, 38, 30, 22,
-    14, 6, 61, 53, 45, 37, 29, 21, 13, 5, 28, 20, 12, 4
+// PC-1 按4位查表：pc1_nibble[i][v] 为密钥第 i 个半字节 (从高位起) 取值 v 时对 C||D (56位) 的贡献
+static const uint64_t pc1_nibble[16][16] = {
+    {
+        0x00000000000000ULL, 0x00000000000001ULL, 0x00000100000000ULL, 0x00000100000001ULL,
+        0x00010000000000ULL, 0x00010000000001ULL, 0x00010100000000ULL, 0x00010100000001ULL,
+        0x01000000000000ULL, 0x01000000000001ULL, 0x01000100000000ULL, 0x01000100000001ULL,
+        0x01010000000000ULL, 0x01010000000001ULL, 0x01010100000000ULL, 0x01010100000001ULL
+    },
+    {
+        0x00000000000000ULL, 0x00000000000000ULL, 0x00000000100000ULL, 0x00000000100000ULL,
+        0x00000000001000ULL, 0x00000000001000ULL, 0x00000000101000ULL, 0x00000000101000ULL,
+        0x00000000000010ULL, 0x00000000000010ULL, 0x00000000100010ULL, 0x00000000100010ULL,
+        0x00000000001010ULL, 0x00000000001010ULL, 0x00000000101010ULL, 0x00000000101010ULL
+    },
+    {
+        0x00000000000000ULL, 0x00000000000002ULL, 0x00000200000000ULL, 0x00000200000002ULL,
+        0x00020000000000ULL, 0x00020000000002ULL, 0x00020200000000ULL, 0x00020200000002ULL,
+        0x02000000000000ULL, 0x02000000000002ULL, 0x02000200000000ULL, 0x02000200000002ULL,
+        0x02020000000000ULL, 0x02020000000002ULL, 0x02020200000000ULL, 0x02020200000002ULL
+    },
+    {
+        0x00000000000000ULL, 0x00000000000000ULL, 0x00000000200000ULL, 0x00000000200000ULL,
+        0x00000000002000ULL, 0x00000000002000ULL, 0x00000000202000ULL, 0x00000000202000ULL,
+        0x00000000000020ULL, 0x00000000000020ULL, 0x00000000200020ULL, 0x00000000200020ULL,
+        0x00000000002020ULL, 0x00000000002020ULL, 0x00000000202020ULL, 0x00000000202020ULL
+    },
+    {
+        0x00000000000000ULL, 0x00000000000004ULL, 0x00000400000000ULL, 0x00000400000004ULL,
+        0x00040000000000ULL, 0x00040000000004ULL, 0x00040400000000ULL, 0x00040400000004ULL,
+        0x04000000000000ULL, 0x04000000000004ULL, 0x04000400000000ULL, 0x04000400000004ULL,
+        0x04040000000000ULL, 0x04040000000004ULL, 0x04040400000000ULL, 0x04040400000004ULL
+    },
+    {
+        0x00000000000000ULL, 0x00000000000000ULL, 0x00000000400000ULL, 0x00000000400000ULL,
+        0x00000000004000ULL, 0x00000000004000ULL, 0x00000000404000ULL, 0x00000000404000ULL,
+        0x00000000000040ULL, 0x00000000000040ULL, 0x00000000400040ULL, 0x00000000400040ULL,
+        0x00000000004040ULL, 0x00000000004040ULL, 0x00000000404040ULL, 0x00000000404040ULL
+    },
+    {
+        0x00000000000000ULL, 0x00000000000008ULL, 0x00000800000000ULL, 0x00000800000008ULL,
+        0x00080000000000ULL, 0x00080000000008ULL, 0x00080800000000ULL, 0x00080800000008ULL,
+        0x08000000000000ULL, 0x08000000000008ULL, 0x08000800000000ULL, 0x08000800000008ULL,
+        0x08080000000000ULL, 0x08080000000008ULL, 0x08080800000000ULL, 0x08080800000008ULL
+    },
+    {
+        0x00000000000000ULL, 0x00000000000000ULL, 0x00000000800000ULL, 0x00000000800000ULL,
+        0x00000000008000ULL, 0x00000000008000ULL, 0x00000000808000ULL, 0x00000000808000ULL,
+        0x00000000000080ULL, 0x00000000000080ULL, 0x00000000800080ULL, 0x00000000800080ULL,
+        0x00000000008080ULL, 0x00000000008080ULL, 0x00000000808080ULL, 0x00000000808080ULL
+    },
+    {
+        0x00000000000000ULL, 0x00000010000000ULL, 0x00001000000000ULL, 0x00001010000000ULL,
+        0x00100000000000ULL, 0x00100010000000ULL, 0x00101000000000ULL, 0x00101010000000ULL,
+        0x10000000000000ULL, 0x10000010000000ULL, 0x10001000000000ULL, 0x10001010000000ULL,
+        0x10100000000000ULL, 0x10100010000000ULL, 0x10101000000000ULL, 0x10101010000000ULL
+    },
+    {
+        0x00000000000000ULL, 0x00000000000000ULL, 0x00000001000000ULL, 0x00000001000000ULL,
+        0x00000000010000ULL, 0x00000000010000ULL, 0x00000001010000ULL, 0x00000001010000ULL,
+        0x00000000000100ULL, 0x00000000000100ULL, 0x00000001000100ULL, 0x00000001000100ULL,
+        0x00000000010100ULL, 0x00000000010100ULL, 0x00000001010100ULL, 0x00000001010100ULL
+    },
+    {
+        0x00000000000000ULL, 0x00000020000000ULL, 0x00002000000000ULL, 0x00002020000000ULL,
+        0x00200000000000ULL, 0x00200020000000ULL, 0x00202000000000ULL, 0x00202020000000ULL,
+        0x20000000000000ULL, 0x20000020000000ULL, 0x20002000000000ULL, 0x20002020000000ULL,
+        0x20200000000000ULL, 0x20200020000000ULL, 0x20202000000000ULL, 0x20202020000000ULL
+    },
+    {
+        0x00000000000000ULL, 0x00000000000000ULL, 0x00000002000000ULL, 0x00000002000000ULL,
+        0x00000000020000ULL, 0x00000000020000ULL, 0x00000002020000ULL, 0x00000002020000ULL,
+        0x00000000000200ULL, 0x00000000000200ULL, 0x00000002000200ULL, 0x00000002000200ULL,
+        0x00000000020200ULL, 0x00000000020200ULL, 0x00000002020200ULL, 0x00000002020200ULL
+    },
+    {
+        0x00000000000000ULL, 0x00000040000000ULL, 0x00004000000000ULL, 0x00004040000000ULL,
+        0x00400000000000ULL, 0x00400040000000ULL, 0x00404000000000ULL, 0x00404040000000ULL,
+        0x40000000000000ULL, 0x40000040000000ULL, 0x40004000000000ULL, 0x40004040000000ULL,
+        0x40400000000000ULL, 0x40400040000000ULL, 0x40404000000000ULL, 0x40404040000000ULL
+    },
+    {
+        0x00000000000000ULL, 0x00000000000000ULL, 0x00000004000000ULL, 0x00000004000000ULL,
+        0x00000000040000ULL, 0x00000000040000ULL, 0x00000004040000ULL, 0x00000004040000ULL,
+        0x00000000000400ULL, 0x00000000000400ULL, 0x00000004000400ULL, 0x00000004000400ULL,
+        0x00000000040400ULL, 0x00000000040400ULL, 0x00000004040400ULL, 0x00000004040400ULL
+    },
+    {
+        0x00000000000000ULL, 0x00000080000000ULL, 0x00008000000000ULL, 0x00008080000000ULL,
+        0x00800000000000ULL, 0x00800080000000ULL, 0x00808000000000ULL, 0x00808080000000ULL,
+        0x80000000000000ULL, 0x80000080000000ULL, 0x80008000000000ULL, 0x80008080000000ULL,
+        0x80800000000000ULL, 0x80800080000000ULL, 0x80808000000000ULL, 0x80808080000000ULL
+    },
+    {
+        0x00000000000000ULL, 0x00000000000000ULL, 0x00000008000000ULL, 0x00000008000000ULL,
+        0x00000000080000ULL, 0x00000000080000ULL, 0x00000008080000ULL, 0x00000008080000ULL,
+        0x00000000000800ULL, 0x00000000000800ULL, 0x00000008000800ULL, 0x00000008000800ULL,
+        0x00000000080800ULL, 0x00000000080800ULL, 0x00000008080800ULL, 0x00000008080800ULL
+    }
 };
 
-// 密钥置换选择表2 (PC-2)
-static const uint8_t pc2_table[48] = {
-    14, 17, 11, 24, 1, 5, 3, 28, 15, 6, 21, 10,
-    23, 19, 12, 4, 26, 8, 16, 7, 27, 20, 13, 2,
-    41, 52, 31, 37, 47, 55, 30, 40, 51, 45, 33, 48,
-    44, 49, 39, 56, 34, 53, 46, 42, 50, 36, 29, 32
+// PC-2 按7位查表并直接输出F函数使用的子密钥布局：pc2_sp[i][v] 为 C||D 第 i 个7位组 (从高位起) 取值 v 时的贡献
+static const uint64_t pc2_sp[8][128] = {
+    {
+        0x0000000000000000ULL, 0x0000000000001000ULL, 0x0000000000040000ULL, 0x0000000000041000ULL,
+        0x0100000000000000ULL, 0x0100000000001000ULL, 0x0100000000040000ULL, 0x0100000000041000ULL,
+        0x0004000000000000ULL, 0x0004000000001000ULL, 0x0004000000040000ULL, 0x0004000000041000ULL,
+        0x0104000000000000ULL, 0x0104000000001000ULL, 0x0104000000040000ULL, 0x0104000000041000ULL,
+        0x0000000000200000ULL, 0x0000000000201000ULL, 0x0000000000240000ULL, 0x0000000000241000ULL,
+        0x0100000000200000ULL, 0x0100000000201000ULL, 0x0100000000240000ULL, 0x0100000000241000ULL,
+        0x0004000000200000ULL, 0x0004000000201000ULL, 0x0004000000240000ULL, 0x0004000000241000ULL,
+        0x0104000000200000ULL, 0x0104000000201000ULL, 0x0104000000240000ULL, 0x0104000000241000ULL,
+        0x0000000000000100ULL, 0x0000000000001100ULL, 0x0000000000040100ULL, 0x0000000000041100ULL,
+        0x0100000000000100ULL, 0x0100000000001100ULL, 0x0100000000040100ULL, 0x0100000000041100ULL,
+        0x0004000000000100ULL, 0x0004000000001100ULL, 0x0004000000040100ULL, 0x0004000000041100ULL,
+        0x0104000000000100ULL, 0x0104000000001100ULL, 0x0104000000040100ULL, 0x0104000000041100ULL,
+        0x0000000000200100ULL, 0x0000000000201100ULL, 0x0000000000240100ULL, 0x0000000000241100ULL,
+        0x0100000000200100ULL, 0x0100000000201100ULL, 0x0100000000240100ULL, 0x0100000000241100ULL,
+        0x0004000000200100ULL, 0x0004000000201100ULL, 0x0004000000240100ULL, 0x0004000000241100ULL,
+        0x0104000000200100ULL, 0x0104000000201100ULL, 0x0104000000240100ULL, 0x0104000000241100ULL,
+        0x0200000000000000ULL, 0x0200000000001000ULL, 0x0200000000040000ULL, 0x0200000000041000ULL,
+        0x0300000000000000ULL, 0x0300000000001000ULL, 0x0300000000040000ULL, 0x0300000000041000ULL,
+        0x0204000000000000ULL, 0x0204000000001000ULL, 0x0204000000040000ULL, 0x0204000000041000ULL,
+        0x0304000000000000ULL, 0x0304000000001000ULL, 0x0304000000040000ULL, 0x0304000000041000ULL,
+        0x0200000000200000ULL, 0x0200000000201000ULL, 0x0200000000240000ULL, 0x0200000000241000ULL,
+        0x0300000000200000ULL, 0x0300000000201000ULL, 0x0300000000240000ULL, 0x0300000000241000ULL,
+        0x0204000000200000ULL, 0x0204000000201000ULL, 0x0204000000240000ULL, 0x0204000000241000ULL,
+        0x0304000000200000ULL, 0x0304000000201000ULL, 0x0304000000240000ULL, 0x0304000000241000ULL,
+        0x0200000000000100ULL, 0x0200000000001100ULL, 0x0200000000040100ULL, 0x0200000000041100ULL,
+        0x0300000000000100ULL, 0x0300000000001100ULL, 0x0300000000040100ULL, 0x0300000000041100ULL,
+        0x0204000000000100ULL, 0x0204000000001100ULL, 0x0204000000040100ULL, 0x0204000000041100ULL,
+        0x0304000000000100ULL, 0x0304000000001100ULL, 0x0304000000040100ULL, 0x0304000000041100ULL,
+        0x0200000000200100ULL, 0x0200000000201100ULL, 0x0200000000240100ULL, 0x0200000000241100ULL,
+        0x0300000000200100ULL, 0x0300000000201100ULL, 0x0300000000240100ULL, 0x0300000000241100ULL,
+        0x0204000000200100ULL, 0x0204000000201100ULL, 0x0204000000240100ULL, 0x0204000000241100ULL,
+        0x0304000000200100ULL, 0x0304000000201100ULL, 0x0304000000240100ULL, 0x0304000000241100ULL
+    },
+    {
+        0x0000000000000000ULL, 0x2000000000000000ULL, 0x0000000000000200ULL, 0x2000000000000200ULL,
+        0x0008000000000000ULL, 0x2008000000000000ULL, 0x0008000000000200ULL, 0x2008000000000200ULL,
+        0x0800000000000000ULL, 0x2800000000000000ULL, 0x0800000000000200ULL, 0x2800000000000200ULL,
+        0x0808000000000000ULL, 0x2808000000000000ULL, 0x0808000000000200ULL, 0x2808000000000200ULL,
+        0x0000000000010000ULL, 0x2000000000010000ULL, 0x0000000000010200ULL, 0x2000000000010200ULL,
+        0x0008000000010000ULL, 0x2008000000010000ULL, 0x0008000000010200ULL, 0x2008000000010200ULL,
+        0x0800000000010000ULL, 0x2800000000010000ULL, 0x0800000000010200ULL, 0x2800000000010200ULL,
+        0x0808000000010000ULL, 0x2808000000010000ULL, 0x0808000000010200ULL, 0x2808000000010200ULL,
+        0x0000000000000000ULL, 0x2000000000000000ULL, 0x0000000000000200ULL, 0x2000000000000200ULL,
+        0x0008000000000000ULL, 0x2008000000000000ULL, 0x0008000000000200ULL, 0x2008000000000200ULL,
+        0x0800000000000000ULL, 0x2800000000000000ULL, 0x0800000000000200ULL, 0x2800000000000200ULL,
+        0x0808000000000000ULL, 0x2808000000000000ULL, 0x0808000000000200ULL, 0x2808000000000200ULL,
+        0x0000000000010000ULL, 0x2000000000010000ULL, 0x0000000000010200ULL, 0x2000000000010200ULL,
+        0x0008000000010000ULL, 0x2008000000010000ULL, 0x0008000000010200ULL, 0x2008000000010200ULL,
+        0x0800000000010000ULL, 0x2800000000010000ULL, 0x0800000000010200ULL, 0x2800000000010200ULL,
+        0x0808000000010000ULL, 0x2808000000010000ULL, 0x0808000000010200ULL, 0x2808000000010200ULL,
+        0x0001000000000000ULL, 0x2001000000000000ULL, 0x0001000000000200ULL, 0x2001000000000200ULL,
+        0x0009000000000000ULL, 0x2009000000000000ULL, 0x0009000000000200ULL, 0x2009000000000200ULL,
+        0x0801000000000000ULL, 0x2801000000000000ULL, 0x0801000000000200ULL, 0x2801000000000200ULL,
+        0x0809000000000000ULL, 0x2809000000000000ULL, 0x0809000000000200ULL, 0x2809000000000200ULL,
+        0x0001000000010000ULL, 0x2001000000010000ULL, 0x0001000000010200ULL, 0x2001000000010200ULL,
+        0x0009000000010000ULL, 0x2009000000010000ULL, 0x0009000000010200ULL, 0x2009000000010200ULL,
+        0x0801000000010000ULL, 0x2801000000010000ULL, 0x0801000000010200ULL, 0x2801000000010200ULL,
+        0x0809000000010000ULL, 0x2809000000010000ULL, 0x0809000000010200ULL, 0x2809000000010200ULL,
+        0x0001000000000000ULL, 0x2001000000000000ULL, 0x0001000000000200ULL, 0x2001000000000200ULL,
+        0x0009000000000000ULL, 0x2009000000000000ULL, 0x0009000000000200ULL, 0x2009000000000200ULL,
+        0x0801000000000000ULL, 0x2801000000000000ULL, 0x0801000000000200ULL, 0x2801000000000200ULL,
+        0x0809000000000000ULL, 0x2809000000000000ULL, 0x0809000000000200ULL, 0x2809000000000200ULL,
+        0x0001000000010000ULL, 0x2001000000010000ULL, 0x0001000000010200ULL, 0x2001000000010200ULL,
+        0x0009000000010000ULL, 0x2009000000010000ULL, 0x0009000000010200ULL, 0x2009000000010200ULL,
+        0x0801000000010000ULL, 0x2801000000010000ULL, 0x0801000000010200ULL, 0x2801000000010200ULL,
+        0x0809000000010000ULL, 0x2809000000010000ULL, 0x0809000000010200ULL, 0x2809000000010200ULL
+    },
+    {
+        0x0000000000000000ULL, 0x0000000000020000ULL, 0x0000000000000400ULL, 0x0000000000020400ULL,
+        0x0010000000000000ULL, 0x0010000000020000ULL, 0x0010000000000400ULL, 0x0010000000020400ULL,
+        0x0000000000000000ULL, 0x0000000000020000ULL, 0x0000000000000400ULL, 0x0000000000020400ULL,
+        0x0010000000000000ULL, 0x0010000000020000ULL, 0x0010000000000400ULL, 0x0010000000020400ULL,
+        0x1000000000000000ULL, 0x1000000000020000ULL, 0x1000000000000400ULL, 0x1000000000020400ULL,
+        0x1010000000000000ULL, 0x1010000000020000ULL, 0x1010000000000400ULL, 0x1010000000020400ULL,
+        0x1000000000000000ULL, 0x1000000000020000ULL, 0x1000000000000400ULL, 0x1000000000020400ULL,
+        0x1010000000000000ULL, 0x1010000000020000ULL, 0x1010000000000400ULL, 0x1010000000020400ULL,
+        0x0000000000002000ULL, 0x0000000000022000ULL, 0x0000000000002400ULL, 0x0000000000022400ULL,
+        0x0010000000002000ULL, 0x0010000000022000ULL, 0x0010000000002400ULL, 0x0010000000022400ULL,
+        0x0000000000002000ULL, 0x0000000000022000ULL, 0x0000000000002400ULL, 0x0000000000022400ULL,
+        0x0010000000002000ULL, 0x0010000000022000ULL, 0x0010000000002400ULL, 0x0010000000022400ULL,
+        0x1000000000002000ULL, 0x1000000000022000ULL, 0x1000000000002400ULL, 0x1000000000022400ULL,
+        0x1010000000002000ULL, 0x1010000000022000ULL, 0x1010000000002400ULL, 0x1010000000022400ULL,
+        0x1000000000002000ULL, 0x1000000000022000ULL, 0x1000000000002400ULL, 0x1000000000022400ULL,
+        0x1010000000002000ULL, 0x1010000000022000ULL, 0x1010000000002400ULL, 0x1010000000022400ULL,
+        0x0000000000080000ULL, 0x00000000000a0000ULL, 0x0000000000080400ULL, 0x00000000000a0400ULL,
+        0x0010000000080000ULL, 0x00100000000a0000ULL, 0x0010000000080400ULL, 0x00100000000a0400ULL,
+        0x0000000000080000ULL, 0x00000000000a0000ULL, 0x0000000000080400ULL, 0x00000000000a0400ULL,
+        0x0010000000080000ULL, 0x00100000000a0000ULL, 0x0010000000080400ULL, 0x00100000000a0400ULL,
+        0x1000000000080000ULL, 0x10000000000a0000ULL, 0x1000000000080400ULL, 0x10000000000a0400ULL,
+        0x1010000000080000ULL, 0x10100000000a0000ULL, 0x1010000000080400ULL, 0x10100000000a0400ULL,
+        0x1000000000080000ULL, 0x10000000000a0000ULL, 0x1000000000080400ULL, 0x10000000000a0400ULL,
+        0x1010000000080000ULL, 0x10100000000a0000ULL, 0x1010000000080400ULL, 0x10100000000a0400ULL,
+        0x0000000000082000ULL, 0x00000000000a2000ULL, 0x0000000000082400ULL, 0x00000000000a2400ULL,
+        0x0010000000082000ULL, 0x00100000000a2000ULL, 0x0010000000082400ULL, 0x00100000000a2400ULL,
+        0x0000000000082000ULL, 0x00000000000a2000ULL, 0x0000000000082400ULL, 0x00000000000a2400ULL,
+        0x0010000000082000ULL, 0x00100000000a2000ULL, 0x0010000000082400ULL, 0x00100000000a2400ULL,
+        0x1000000000082000ULL, 0x10000000000a2000ULL, 0x1000000000082400ULL, 0x10000000000a2400ULL,
+        0x1010000000082000ULL, 0x10100000000a2000ULL, 0x1010000000082400ULL, 0x10100000000a2400ULL,
+        0x1000000000082000ULL, 0x10000000000a2000ULL, 0x1000000000082400ULL, 0x10000000000a2400ULL,
+        0x1010000000082000ULL, 0x10100000000a2000ULL, 0x1010000000082400ULL, 0x10100000000a2400ULL
+    },
+    {
+        0x0000000000000000ULL, 0x0000000000100000ULL, 0x0000000000000800ULL, 0x0000000000100800ULL,
+        0x0002000000000000ULL, 0x0002000000100000ULL, 0x0002000000000800ULL, 0x0002000000100800ULL,
+        0x0000000000000000ULL, 0x0000000000100000ULL, 0x0000000000000800ULL, 0x0000000000100800ULL,
+        0x0002000000000000ULL, 0x0002000000100000ULL, 0x0002000000000800ULL, 0x0002000000100800ULL,
+        0x0400000000000000ULL, 0x0400000000100000ULL, 0x0400000000000800ULL, 0x0400000000100800ULL,
+        0x0402000000000000ULL, 0x0402000000100000ULL, 0x0402000000000800ULL, 0x0402000000100800ULL,
+        0x0400000000000000ULL, 0x0400000000100000ULL, 0x0400000000000800ULL, 0x0400000000100800ULL,
+        0x0402000000000000ULL, 0x0402000000100000ULL, 0x0402000000000800ULL, 0x0402000000100800ULL,
+        0x0020000000000000ULL, 0x0020000000100000ULL, 0x0020000000000800ULL, 0x0020000000100800ULL,
+        0x0022000000000000ULL, 0x0022000000100000ULL, 0x0022000000000800ULL, 0x0022000000100800ULL,
+        0x0020000000000000ULL, 0x0020000000100000ULL, 0x0020000000000800ULL, 0x0020000000100800ULL,
+        0x0022000000000000ULL, 0x0022000000100000ULL, 0x0022000000000800ULL, 0x0022000000100800ULL,
+        0x0420000000000000ULL, 0x0420000000100000ULL, 0x0420000000000800ULL, 0x0420000000100800ULL,
+        0x0422000000000000ULL, 0x0422000000100000ULL, 0x0422000000000800ULL, 0x0422000000100800ULL,
+        0x0420000000000000ULL, 0x0420000000100000ULL, 0x0420000000000800ULL, 0x0420000000100800ULL,
+        0x0422000000000000ULL, 0x0422000000100000ULL, 0x0422000000000800ULL, 0x0422000000100800ULL,
+        0x0000000000000000ULL, 0x0000000000100000ULL, 0x0000000000000800ULL, 0x0000000000100800ULL,
+        0x0002000000000000ULL, 0x0002000000100000ULL, 0x0002000000000800ULL, 0x0002000000100800ULL,
+        0x0000000000000000ULL, 0x0000000000100000ULL, 0x0000000000000800ULL, 0x0000000000100800ULL,
+        0x0002000000000000ULL, 0x0002000000100000ULL, 0x0002000000000800ULL, 0x0002000000100800ULL,
+        0x0400000000000000ULL, 0x0400000000100000ULL, 0x0400000000000800ULL, 0x0400000000100800ULL,
+        0x0402000000000000ULL, 0x0402000000100000ULL, 0x0402000000000800ULL, 0x0402000000100800ULL,
+        0x0400000000000000ULL, 0x0400000000100000ULL, 0x0400000000000800ULL, 0x0400000000100800ULL,
+        0x0402000000000000ULL, 0x0402000000100000ULL, 0x0402000000000800ULL, 0x0402000000100800ULL,
+        0x0020000000000000ULL, 0x0020000000100000ULL, 0x0020000000000800ULL, 0x0020000000100800ULL,
+        0x0022000000000000ULL, 0x0022000000100000ULL, 0x0022000000000800ULL, 0x0022000000100800ULL,
+        0x0020000000000000ULL, 0x0020000000100000ULL, 0x0020000000000800ULL, 0x0020000000100800ULL,
+        0x0022000000000000ULL, 0x0022000000100000ULL, 0x0022000000000800ULL, 0x0022000000100800ULL,
+        0x0420000000000000ULL, 0x0420000000100000ULL, 0x0420000000000800ULL, 0x0420000000100800ULL,
+        0x0422000000000000ULL, 0x0422000000100000ULL, 0x0422000000000800ULL, 0x0422000000100800ULL,
+        0x0420000000000000ULL, 0x0420000000100000ULL, 0x0420000000000800ULL, 0x0420000000100800ULL,
+        0x0422000000000000ULL, 0x0422000000100000ULL, 0x0422000000000800ULL, 0x0422000000100800ULL
+    },
+    {
+        0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000200000000ULL, 0x0000000200000000ULL,
+        0x0000000000000002ULL, 0x0000000000000002ULL, 0x0000000200000002ULL, 0x0000000200000002ULL,
+        0x0000000001000000ULL, 0x0000000001000000ULL, 0x0000000201000000ULL, 0x0000000201000000ULL,
+        0x0000000001000002ULL, 0x0000000001000002ULL, 0x0000000201000002ULL, 0x0000000201000002ULL,
+        0x0000080000000000ULL, 0x0000080000000000ULL, 0x0000080200000000ULL, 0x0000080200000000ULL,
+        0x0000080000000002ULL, 0x0000080000000002ULL, 0x0000080200000002ULL, 0x0000080200000002ULL,
+        0x0000080001000000ULL, 0x0000080001000000ULL, 0x0000080201000000ULL, 0x0000080201000000ULL,
+        0x0000080001000002ULL, 0x0000080001000002ULL, 0x0000080201000002ULL, 0x0000080201000002ULL,
+        0x0000000000000020ULL, 0x0000000000000020ULL, 0x0000000200000020ULL, 0x0000000200000020ULL,
+        0x0000000000000022ULL, 0x0000000000000022ULL, 0x0000000200000022ULL, 0x0000000200000022ULL,
+        0x0000000001000020ULL, 0x0000000001000020ULL, 0x0000000201000020ULL, 0x0000000201000020ULL,
+        0x0000000001000022ULL, 0x0000000001000022ULL, 0x0000000201000022ULL, 0x0000000201000022ULL,
+        0x0000080000000020ULL, 0x0000080000000020ULL, 0x0000080200000020ULL, 0x0000080200000020ULL,
+        0x0000080000000022ULL, 0x0000080000000022ULL, 0x0000080200000022ULL, 0x0000080200000022ULL,
+        0x0000080001000020ULL, 0x0000080001000020ULL, 0x0000080201000020ULL, 0x0000080201000020ULL,
+        0x0000080001000022ULL, 0x0000080001000022ULL, 0x0000080201000022ULL, 0x0000080201000022ULL,
+        0x0000000002000000ULL, 0x0000000002000000ULL, 0x0000000202000000ULL, 0x0000000202000000ULL,
+        0x0000000002000002ULL, 0x0000000002000002ULL, 0x0000000202000002ULL, 0x0000000202000002ULL,
+        0x0000000003000000ULL, 0x0000000003000000ULL, 0x0000000203000000ULL, 0x0000000203000000ULL,
+        0x0000000003000002ULL, 0x0000000003000002ULL, 0x0000000203000002ULL, 0x0000000203000002ULL,
+        0x0000080002000000ULL, 0x0000080002000000ULL, 0x0000080202000000ULL, 0x0000080202000000ULL,
+        0x0000080002000002ULL, 0x0000080002000002ULL, 0x0000080202000002ULL, 0x0000080202000002ULL,
+        0x0000080003000000ULL, 0x0000080003000000ULL, 0x0000080203000000ULL, 0x0000080203000000ULL,
+        0x0000080003000002ULL, 0x0000080003000002ULL, 0x0000080203000002ULL, 0x0000080203000002ULL,
+        0x0000000002000020ULL, 0x0000000002000020ULL, 0x0000000202000020ULL, 0x0000000202000020ULL,
+        0x0000000002000022ULL, 0x0000000002000022ULL, 0x0000000202000022ULL, 0x0000000202000022ULL,
+        0x0000000003000020ULL, 0x0000000003000020ULL, 0x0000000203000020ULL, 0x0000000203000020ULL,
+        0x0000000003000022ULL, 0x0000000003000022ULL, 0x0000000203000022ULL, 0x0000000203000022ULL,
+        0x0000080002000020ULL, 0x0000080002000020ULL, 0x0000080202000020ULL, 0x0000080202000020ULL,
+        0x0000080002000022ULL, 0x0000080002000022ULL, 0x0000080202000022ULL, 0x0000080202000022ULL,
+        0x0000080003000020ULL, 0x0000080003000020ULL, 0x0000080203000020ULL, 0x0000080203000020ULL,
+        0x0000080003000022ULL, 0x0000080003000022ULL, 0x0000080203000022ULL, 0x0000080203000022ULL
+    },
+    {
+        0x0000000000000000ULL, 0x0000000010000000ULL, 0x0000200000000000ULL, 0x0000200010000000ULL,
+        0x0000000000000010ULL, 0x0000000010000010ULL, 0x0000200000000010ULL, 0x0000200010000010ULL,
+        0x0000000800000000ULL, 0x0000000810000000ULL, 0x0000200800000000ULL, 0x0000200810000000ULL,
+        0x0000000800000010ULL, 0x0000000810000010ULL, 0x0000200800000010ULL, 0x0000200810000010ULL,
+        0x0000000000000000ULL, 0x0000000010000000ULL, 0x0000200000000000ULL, 0x0000200010000000ULL,
+        0x0000000000000010ULL, 0x0000000010000010ULL, 0x0000200000000010ULL, 0x0000200010000010ULL,
+        0x0000000800000000ULL, 0x0000000810000000ULL, 0x0000200800000000ULL, 0x0000200810000000ULL,
+        0x0000000800000010ULL, 0x0000000810000010ULL, 0x0000200800000010ULL, 0x0000200810000010ULL,
+        0x0000040000000000ULL, 0x0000040010000000ULL, 0x0000240000000000ULL, 0x0000240010000000ULL,
+        0x0000040000000010ULL, 0x0000040010000010ULL, 0x0000240000000010ULL, 0x0000240010000010ULL,
+        0x0000040800000000ULL, 0x0000040810000000ULL, 0x0000240800000000ULL, 0x0000240810000000ULL,
+        0x0000040800000010ULL, 0x0000040810000010ULL, 0x0000240800000010ULL, 0x0000240810000010ULL,
+        0x0000040000000000ULL, 0x0000040010000000ULL, 0x0000240000000000ULL, 0x0000240010000000ULL,
+        0x0000040000000010ULL, 0x0000040010000010ULL, 0x0000240000000010ULL, 0x0000240010000010ULL,
+        0x0000040800000000ULL, 0x0000040810000000ULL, 0x0000240800000000ULL, 0x0000240810000000ULL,
+        0x0000040800000010ULL, 0x0000040810000010ULL, 0x0000240800000010ULL, 0x0000240810000010ULL,
+        0x0000000004000000ULL, 0x0000000014000000ULL, 0x0000200004000000ULL, 0x0000200014000000ULL,
+        0x0000000004000010ULL, 0x0000000014000010ULL, 0x0000200004000010ULL, 0x0000200014000010ULL,
+        0x0000000804000000ULL, 0x0000000814000000ULL, 0x0000200804000000ULL, 0x0000200814000000ULL,
+        0x0000000804000010ULL, 0x0000000814000010ULL, 0x0000200804000010ULL, 0x0000200814000010ULL,
+        0x0000000004000000ULL, 0x0000000014000000ULL, 0x0000200004000000ULL, 0x0000200014000000ULL,
+        0x0000000004000010ULL, 0x0000000014000010ULL, 0x0000200004000010ULL, 0x0000200014000010ULL,
+        0x0000000804000000ULL, 0x0000000814000000ULL, 0x0000200804000000ULL, 0x0000200814000000ULL,
+        0x0000000804000010ULL, 0x0000000814000010ULL, 0x0000200804000010ULL, 0x0000200814000010ULL,
+        0x0000040004000000ULL, 0x0000040014000000ULL, 0x0000240004000000ULL, 0x0000240014000000ULL,
+        0x0000040004000010ULL, 0x0000040014000010ULL, 0x0000240004000010ULL, 0x0000240014000010ULL,
+        0x0000040804000000ULL, 0x0000040814000000ULL, 0x0000240804000000ULL, 0x0000240814000000ULL,
+        0x0000040804000010ULL, 0x0000040814000010ULL, 0x0000240804000010ULL, 0x0000240814000010ULL,
+        0x0000040004000000ULL, 0x0000040014000000ULL, 0x0000240004000000ULL, 0x0000240014000000ULL,
+        0x0000040004000010ULL, 0x0000040014000010ULL, 0x0000240004000010ULL, 0x0000240014000010ULL,
+        0x0000040804000000ULL, 0x0000040814000000ULL, 0x0000240804000000ULL, 0x0000240814000000ULL,
+        0x0000040804000010ULL, 0x0000040814000010ULL, 0x0000240804000010ULL, 0x0000240814000010ULL
+    },
+    {
+        0x0000000000000000ULL, 0x0000001000000000ULL, 0x0000000000000001ULL, 0x0000001000000001ULL,
+        0x0000020000000000ULL, 0x0000021000000000ULL, 0x0000020000000001ULL, 0x0000021000000001ULL,
+        0x0000000020000000ULL, 0x0000001020000000ULL, 0x0000000020000001ULL, 0x0000001020000001ULL,
+        0x0000020020000000ULL, 0x0000021020000000ULL, 0x0000020020000001ULL, 0x0000021020000001ULL,
+        0x0000000000000004ULL, 0x0000001000000004ULL, 0x0000000000000005ULL, 0x0000001000000005ULL,
+        0x0000020000000004ULL, 0x0000021000000004ULL, 0x0000020000000005ULL, 0x0000021000000005ULL,
+        0x0000000020000004ULL, 0x0000001020000004ULL, 0x0000000020000005ULL, 0x0000001020000005ULL,
+        0x0000020020000004ULL, 0x0000021020000004ULL, 0x0000020020000005ULL, 0x0000021020000005ULL,
+        0x0000002000000000ULL, 0x0000003000000000ULL, 0x0000002000000001ULL, 0x0000003000000001ULL,
+        0x0000022000000000ULL, 0x0000023000000000ULL, 0x0000022000000001ULL, 0x0000023000000001ULL,
+        0x0000002020000000ULL, 0x0000003020000000ULL, 0x0000002020000001ULL, 0x0000003020000001ULL,
+        0x0000022020000000ULL, 0x0000023020000000ULL, 0x0000022020000001ULL, 0x0000023020000001ULL,
+        0x0000002000000004ULL, 0x0000003000000004ULL, 0x0000002000000005ULL, 0x0000003000000005ULL,
+        0x0000022000000004ULL, 0x0000023000000004ULL, 0x0000022000000005ULL, 0x0000023000000005ULL,
+        0x0000002020000004ULL, 0x0000003020000004ULL, 0x0000002020000005ULL, 0x0000003020000005ULL,
+        0x0000022020000004ULL, 0x0000023020000004ULL, 0x0000022020000005ULL, 0x0000023020000005ULL,
+        0x0000000000000000ULL, 0x0000001000000000ULL, 0x0000000000000001ULL, 0x0000001000000001ULL,
+        0x0000020000000000ULL, 0x0000021000000000ULL, 0x0000020000000001ULL, 0x0000021000000001ULL,
+        0x0000000020000000ULL, 0x0000001020000000ULL, 0x0000000020000001ULL, 0x0000001020000001ULL,
+        0x0000020020000000ULL, 0x0000021020000000ULL, 0x0000020020000001ULL, 0x0000021020000001ULL,
+        0x0000000000000004ULL, 0x0000001000000004ULL, 0x0000000000000005ULL, 0x0000001000000005ULL,
+        0x0000020000000004ULL, 0x0000021000000004ULL, 0x0000020000000005ULL, 0x0000021000000005ULL,
+        0x0000000020000004ULL, 0x0000001020000004ULL, 0x0000000020000005ULL, 0x0000001020000005ULL,
+        0x0000020020000004ULL, 0x0000021020000004ULL, 0x0000020020000005ULL, 0x0000021020000005ULL,
+        0x0000002000000000ULL, 0x0000003000000000ULL, 0x0000002000000001ULL, 0x0000003000000001ULL,
+        0x0000022000000000ULL, 0x0000023000000000ULL, 0x0000022000000001ULL, 0x0000023000000001ULL,
+        0x0000002020000000ULL, 0x0000003020000000ULL, 0x0000002020000001ULL, 0x0000003020000001ULL,
+        0x0000022020000000ULL, 0x0000023020000000ULL, 0x0000022020000001ULL, 0x0000023020000001ULL,
+        0x0000002000000004ULL, 0x0000003000000004ULL, 0x0000002000000005ULL, 0x0000003000000005ULL,
+        0x0000022000000004ULL, 0x0000023000000004ULL, 0x0000022000000005ULL, 0x0000023000000005ULL,
+        0x0000002020000004ULL, 0x0000003020000004ULL, 0x0000002020000005ULL, 0x0000003020000005ULL,
+        0x0000022020000004ULL, 0x0000023020000004ULL, 0x0000022020000005ULL, 0x0000023020000005ULL
+    },
+    {
+        0x0000000000000000ULL, 0x0000000400000000ULL, 0x0000010000000000ULL, 0x0000010400000000ULL,
+        0x0000000000000000ULL, 0x0000000400000000ULL, 0x0000010000000000ULL, 0x0000010400000000ULL,
+        0x0000000100000000ULL, 0x0000000500000000ULL, 0x0000010100000000ULL, 0x0000010500000000ULL,
+        0x0000000100000000ULL, 0x0000000500000000ULL, 0x0000010100000000ULL, 0x0000010500000000ULL,
+        0x0000100000000000ULL, 0x0000100400000000ULL, 0x0000110000000000ULL, 0x0000110400000000ULL,
+        0x0000100000000000ULL, 0x0000100400000000ULL, 0x0000110000000000ULL, 0x0000110400000000ULL,
+        0x0000100100000000ULL, 0x0000100500000000ULL, 0x0000110100000000ULL, 0x0000110500000000ULL,
+        0x0000100100000000ULL, 0x0000100500000000ULL, 0x0000110100000000ULL, 0x0000110500000000ULL,
+        0x0000000000000008ULL, 0x0000000400000008ULL, 0x0000010000000008ULL, 0x0000010400000008ULL,
+        0x0000000000000008ULL, 0x0000000400000008ULL, 0x0000010000000008ULL, 0x0000010400000008ULL,
+        0x0000000100000008ULL, 0x0000000500000008ULL, 0x0000010100000008ULL, 0x0000010500000008ULL,
+        0x0000000100000008ULL, 0x0000000500000008ULL, 0x0000010100000008ULL, 0x0000010500000008ULL,
+        0x0000100000000008ULL, 0x0000100400000008ULL, 0x0000110000000008ULL, 0x0000110400000008ULL,
+        0x0000100000000008ULL, 0x0000100400000008ULL, 0x0000110000000008ULL, 0x0000110400000008ULL,
+        0x0000100100000008ULL, 0x0000100500000008ULL, 0x0000110100000008ULL, 0x0000110500000008ULL,
+        0x0000100100000008ULL, 0x0000100500000008ULL, 0x0000110100000008ULL, 0x0000110500000008ULL,
+        0x0000000008000000ULL, 0x0000000408000000ULL, 0x0000010008000000ULL, 0x0000010408000000ULL,
+        0x0000000008000000ULL, 0x0000000408000000ULL, 0x0000010008000000ULL, 0x0000010408000000ULL,
+        0x0000000108000000ULL, 0x0000000508000000ULL, 0x0000010108000000ULL, 0x0000010508000000ULL,
+        0x0000000108000000ULL, 0x0000000508000000ULL, 0x0000010108000000ULL, 0x0000010508000000ULL,
+        0x0000100008000000ULL, 0x0000100408000000ULL, 0x0000110008000000ULL, 0x0000110408000000ULL,
+        0x0000100008000000ULL, 0x0000100408000000ULL, 0x0000110008000000ULL, 0x0000110408000000ULL,
+        0x0000100108000000ULL, 0x0000100508000000ULL, 0x0000110108000000ULL, 0x0000110508000000ULL,
+        0x0000100108000000ULL, 0x0000100508000000ULL, 0x0000110108000000ULL, 0x0000110508000000ULL,
+        0x0000000008000008ULL, 0x0000000408000008ULL, 0x0000010008000008ULL, 0x0000010408000008ULL,
+        0x0000000008000008ULL, 0x0000000408000008ULL, 0x0000010008000008ULL, 0x0000010408000008ULL,
+        0x0000000108000008ULL, 0x0000000508000008ULL, 0x0000010108000008ULL, 0x0000010508000008ULL,
+        0x0000000108000008ULL, 0x0000000508000008ULL, 0x0000010108000008ULL, 0x0000010508000008ULL,
+        0x0000100008000008ULL, 0x0000100408000008ULL, 0x0000110008000008ULL, 0x0000110408000008ULL,
+        0x0000100008000008ULL, 0x0000100408000008ULL, 0x0000110008000008ULL, 0x0000110408000008ULL,
+        0x0000100108000008ULL, 0x0000100508000008ULL, 0x0000110108000008ULL, 0x0000110508000008ULL,
+        0x0000100108000008ULL, 0x0000100508000008ULL, 0x0000110108000008ULL, 0x0000110508000008ULL
+    }
 };
 
-// S-盒 (8个)
-static const uint8_t s_boxes[8][64] = {
+// S盒与P置换合并后的查表 (SPtrans)：sp_trans[i][x] 为第i个S盒输入6位 x 时，
+// 其4位输出经过P置换后在32位结果中的贡献。8次查表异或即得到 P(S(E(R) ^ K))
+static const uint32_t sp_trans[8][64] = {
     // S1
     {
-        14, 4, 13, 1, 2, 15, 11, 8, 3, 10, 6, 12, 5, 9, 0, 7,
-        0, 15, 7, 4, 14, 2, 13, 1, 10, 6, 12, 11, 9, 5, 3, 8,
-        4, 1, 14, 8, 13, 6, 2, 11, 15, 12, 9, 7, 3, 10, 5, 0,
-        15, 12, 8, 2, 4, 9, 1, 7, 5, 11, 3, 14, 10, 0, 6, 13
+        0x00808200, 0x00000000, 0x00008000, 0x00808202, 0x00808002, 0x00008202, 0x00000002, 0x00008000,
+        0x00000200, 0x00808200, 0x00808202, 0x00000200, 0x00800202, 0x00808002, 0x00800000, 0x00000002,
+        0x00000202, 0x00800200, 0x00800200, 0x00008200, 0x00008200, 0x00808000, 0x00808000, 0x00800202,
+        0x00008002, 0x00800002, 0x00800002, 0x00008002, 0x00000000, 0x00000202, 0x00008202, 0x00800000,
+        0x00008000, 0x00808202, 0x00000002, 0x00808000, 0x00808200, 0x00800000, 0x00800000, 0x00000200,
+        0x00808002, 0x00008000, 0x00008200, 0x00800002, 0x00000200, 0x00000002, 0x00800202, 0x00008202,
+        0x00808202, 0x00008002, 0x00808000, 0x00800202, 0x00800002, 0x00000202, 0x00008202, 0x00808200,
+        0x00000202, 0x00800200, 0x00800200, 0x00000000, 0x00008002, 0x00008200, 0x00000000, 0x00808002
     },
     // S2
     {
-        15, 1, 8, 14, 6, 11, 3, 4, 9, 7, 2, 13, 12, 0, 5, 10,
-        3, 13, 4, 7, 15, 2, 8, 14, 12, 0, 1, 10, 6, 9, 11, 5,
-        0, 14, 7, 11, 10, 4, 13, 1, 5, 8, 12, 6, 9, 3, 2, 15,
-        13, 8, 10, 1, 3, 15, 4, 2, 11, 6, 7, 12, 0, 5, 14, 9
+        0x40084010, 0x40004000, 0x00004000, 0x00084010, 0x00080000, 0x00000010, 0x40080010, 0x40004010,
+        0x40000010, 0x40084010, 0x40084000, 0x40000000, 0x40004000, 0x00080000, 0x00000010, 0x40080010,
+        0x00084000, 0x00080010, 0x40004010, 0x00000000, 0x40000000, 0x00004000, 0x00084010, 0x40080000,
+        0x00080010, 0x40000010, 0x00000000, 0x00084000, 0x00004010, 0x40084000, 0x40080000, 0x00004010,
+        0x00000000, 0x00084010, 0x40080010, 0x00080000, 0x40004010, 0x40080000, 0x40084000, 0x00004000,
+        0x40080000, 0x40004000, 0x00000010, 0x40084010, 0x00084010, 0x00000010, 0x00004000, 0x40000000,
+        0x00004010, 0x40084000, 0x00080000, 0x40000010, 0x00080010, 0x40004010, 0x40000010, 0x00080010,
+        0x00084000, 0x00000000, 0x40004000, 0x00004010, 0x40000000, 0x40080010, 0x40084010, 0x00084000
     },
     // S3
     {
-        10, 0, 9, 14, 6, 3, 15, 5, 1, 13, 12, 7, 11, 4, 2, 8,
-        13, 7, 0, 9, 3, 4, 6, 10, 2, 8, 5, 14, 12, 11, 15, 1,
-        13, 6, 4, 9, 8, 15, 3, 0, 11, 1, 2, 12, 5, 10, 14, 7,
-        1, 10, 13, 0, 6, 9, 8, 7, 4, 15, 14, 3, 11, 5, 2, 12
+        0x00000104, 0x04010100, 0x00000000, 0x04010004, 0x04000100, 0x00000000, 0x00010104, 0x04000100,
+        0x00010004, 0x04000004, 0x04000004, 0x00010000, 0x04010104, 0x00010004, 0x04010000, 0x00000104,
+        0x04000000, 0x00000004, 0x04010100, 0x00000100, 0x00010100, 0x04010000, 0x04010004, 0x00010104,
+        0x04000104, 0x00010100, 0x00010000, 0x04000104, 0x00000004, 0x04010104, 0x00000100, 0x04000000,
+        0x04010100, 0x04000000, 0x00010004, 0x00000104, 0x00010000, 0x04010100, 0x04000100, 0x00000000,
+        0x00000100, 0x00010004, 0x04010104, 0x04000100, 0x04000004, 0x00000100, 0x00000000, 0x04010004,
+        0x04000104, 0x00010000, 0x04000000, 0x04010104, 0x00000004, 0x00010104, 0x00010100, 0x04000004,
+        0x04010000, 0x04000104, 0x00000104, 0x04010000, 0x00010104, 0x00000004, 0x04010004, 0x00010100
     },
     // S4
     {
-        7, 13, 14, 3, 0, 6, 9, 10, 1, 2, 8, 5, 11, 12, 4, 15,
-        13, 8, 11, 5, 6, 15, 0, 3, 4, 7, 2, 12, 1, 10, 14, 9,
-        10, 6, 9, 0, 12, 11, 7, 13, 15, 1, 3, 14, 5, 2, 8, 4,
-        3, 15, 0, 6, 10, 1, 13, 8, 9, 4, 5, 11, 12, 7, 2, 14
+        0x80401000, 0x80001040, 0x80001040, 0x00000040, 0x00401040, 0x80400040, 0x80400000, 0x80001000,
+        0x00000000, 0x00401000, 0x00401000, 0x80401040, 0x80000040, 0x00000000, 0x00400040, 0x80400000,
+        0x80000000, 0x00001000, 0x00400000, 0x80401000, 0x00000040, 0x00400000, 0x80001000, 0x00001040,
+        0x80400040, 0x80000000, 0x00001040, 0x00400040, 0x00001000, 0x00401040, 0x80401040, 0x80000040,
+        0x00400040, 0x80400000, 0x00401000, 0x80401040, 0x80000040, 0x00000000, 0x00000000, 0x00401000,
+        0x00001040, 0x00400040, 0x80400040, 0x80000000, 0x80401000, 0x80001040, 0x80001040, 0x00000040,
+        0x80401040, 0x80000040, 0x80000000, 0x00001000, 0x80400000, 0x80001000, 0x00401040, 0x80400040,
+        0x80001000, 0x00001040, 0x00400000, 0x80401000, 0x00000040, 0x00400000, 0x00001000, 0x00401040
     },
     // S5
     {
-        2, 12, 4, 1, 7, 10, 11, 6, 8, 5, 3, 15, 13, 0, 14, 9,
-        14, 11, 2, 12, 4, 7, 13, 1, 5, 0, 15, 10, 3, 9, 8, 6,
-        4, 2, 1, 11, 10, 13, 7, 8, 15, 9, 12, 5, 6, 3, 0, 14,
-        11, 8, 12, 7, 1, 14, 2, 13, 6, 15, 0, 9, 10, 4, 5, 3
+        0x00000080, 0x01040080, 0x01040000, 0x21000080, 0x00040000, 0x00000080, 0x20000000, 0x01040000,
+        0x20040080, 0x00040000, 0x01000080, 0x20040080, 0x21000080, 0x21040000, 0x00040080, 0x20000000,
+        0x01000000, 0x20040000, 0x20040000, 0x00000000, 0x20000080, 0x21040080, 0x21040080, 0x01000080,
+        0x21040000, 0x20000080, 0x00000000, 0x21000000, 0x01040080, 0x01000000, 0x21000000, 0x00040080,
+        0x00040000, 0x21000080, 0x00000080, 0x01000000, 0x20000000, 0x01040000, 0x21000080, 0x20040080,
+        0x01000080, 0x20000000, 0x21040000, 0x01040080, 0x20040080, 0x00000080, 0x01000000, 0x21040000,
+        0x21040080, 0x00040080, 0x21000000, 0x21040080, 0x01040000, 0x00000000, 0x20040000, 0x21000000,
+        0x00040080, 0x01000080, 0x20000080, 0x00040000, 0x00000000, 0x20040000, 0x01040080, 0x20000080
     },
     // S6
     {
-        12, 1, 10, 15, 9, 2, 6, 8, 0, 13, 3, 4, 14, 7, 5, 11,
-        10, 15, 4, 2, 7, 12, 9, 5, 6, 1, 13, 14, 0, 11, 3, 8,
-        9, 14, 15, 5, 2, 8, 12, 3, 7, 0, 4, 10, 1, 13, 11, 6,
-        4, 3, 2, 12, 9, 5, 15, 10, 11, 14, 1, 7, 6, 0, 8, 13
+        0x10000008, 0x10200000, 0x00002000, 0x10202008, 0x10200000, 0x00000008, 0x10202008, 0x00200000,
+        0x10002000, 0x00202008, 0x00200000, 0x10000008, 0x00200008, 0x10002000, 0x10000000, 0x00002008,
+        0x00000000, 0x00200008, 0x10002008, 0x00002000, 0x00202000, 0x10002008, 0x00000008, 0x10200008,
+        0x10200008, 0x00000000, 0x00202008, 0x10202000, 0x00002008, 0x00202000, 0x10202000, 0x10000000,
+        0x10002000, 0x00000008, 0x10200008, 0x00202000, 0x10202008, 0x00200000, 0x00002008, 0x10000008,
+        0x00200000, 0x10002000, 0x10000000, 0x00002008, 0x10000008, 0x10202008, 0x00202000, 0x10200000,
+        0x00202008, 0x10202000, 0x00000000, 0x10200008, 0x00000008, 0x00002000, 0x10200000, 0x00202008,
+        0x00002000, 0x00200008, 0x10002008, 0x00000000, 0x10202000, 0x10000000, 0x00200008, 0x10002008
     },
     // S7
     {
-        4, 11, 2, 14, 15, 0, 8, 13, 3, 12, 9, 7, 5, 10, 6, 1,
-        13, 0, 11, 7, 4, 9, 1, 10, 14, 3, 5, 12, 2, 15, 8, 6,
-        1, 4, 11, 13, 12, 3, 7, 14, 10, 15, 6, 8, 0, 5, 9, 2,
-        6, 11, 13, 8, 1, 4, 10, 7, 9, 5, 0, 15, 14, 2, 3, 12
+        0x00100000, 0x02100001, 0x02000401, 0x00000000, 0x00000400, 0x02000401, 0x00100401, 0x02100400,
+        0x02100401, 0x00100000, 0x00000000, 0x02000001, 0x00000001, 0x02000000, 0x02100001, 0x00000401,
+        0x02000400, 0x00100401, 0x00100001, 0x02000400, 0x02000001, 0x02100000, 0x02100400, 0x00100001,
+        0x02100000, 0x00000400, 0x00000401, 0x02100401, 0x00100400, 0x00000001, 0x02000000, 0x00100400,
+        0x02000000, 0x00100400, 0x00100000, 0x02000401, 0x02000401, 0x02100001, 0x02100001, 0x00000001,
+        0x00100001, 0x02000000, 0x02000400, 0x00100000, 0x02100400, 0x00000401, 0x00100401, 0x02100400,
+        0x00000401, 0x02000001, 0x02100401, 0x02100000, 0x00100400, 0x00000000, 0x00000001, 0x02100401,
+        0x00000000, 0x00100401, 0x02100000, 0x00000400, 0x02000001, 0x02000400, 0x00000400, 0x00100001
     },
     // S8
     {
-        13, 2, 8, 4, 6, 15, 11, 1, 10, 9, 3, 14, 5, 0, 12, 7,
-        1, 15, 13, 8, 10, 3, 7, 4, 12, 5, 6, 11, 0, 14, 9, 2,
-        7, 11, 4, 1, 9, 12, 14, 2, 0, 6, 10, 13, 15, 3, 5, 8,
-        2, 1, 14, 7, 4, 10, 8, 13, 15, 12, 9, 0, 3, 5, 6, 11
+        0x08000820, 0x00000800, 0x00020000, 0x08020820, 0x08000000, 0x08000820, 0x00000020, 0x08000000,
+        0x00020020, 0x08020000, 0x08020820, 0x00020800, 0x08020800, 0x00020820, 0x00000800, 0x00000020,
+        0x08020000, 0x08000020, 0x08000800, 0x00000820, 0x00020800, 0x00020020, 0x08020020, 0x08020800,
+        0x00000820, 0x00000000, 0x00000000, 0x08020020, 0x08000020, 0x08000800, 0x00020820, 0x00020000,
+        0x00020820, 0x00020000, 0x08020800, 0x00000800, 0x00000020, 0x08020020, 0x00000800, 0x00020820,
+        0x08000800, 0x00000020, 0x08000020, 0x08020000, 0x08020020, 0x08000000, 0x00020000, 0x08000820,
+        0x00000000, 0x08020820, 0x00020020, 0x08000020, 0x08020000, 0x08000800, 0x08000820, 0x00000000,
+        0x08020820, 0x00020800, 0x00020800, 0x00000820, 0x00000820, 0x00020020, 0x08000000, 0x08020800
     }
 };
 
@@ -116,16 +484,30 @@ static const uint8_t key_shifts[16] = {
 
 // --- 辅助函数 ---
 
-// 通用置换函数
-static uint64_t permute(uint64_t input, const uint8_t *table, int size) {
-    uint64_t output = 0;
-    for (int i = 0; i < size; ++i) {
-        // table中的值是1-64，需要-1来作为位索引
-        if ((input >> (64 - table[i])) & 1) {
-            output |= (1ULL << (size - 1 - i));
-        }
-    }
-    return output;
+// 交换位 (delta swap)：a 中被 (m << n) 选中的位与 b 中被 m 选中的位互换
+#define DELTA_SWAP(a, b, n, m) do { \
+    uint32_t t_ = (((a) >> (n)) ^ (b)) & (m); \
+    (b) ^= t_; \
+    (a) ^= t_ << (n); \
+} while (0)
+
+// 初始置换 (IP)：l/r 为输入分组的高/低32位 (大端)，返回时为 L0/R0
+// IP 可以分解为5次位交换，代替逐位查 64 项置换表
+static inline void des_ip(uint32_t *l, uint32_t *r) {
+    DELTA_SWAP(*l, *r, 4, 0x0F0F0F0F);
+    DELTA_SWAP(*l, *r, 16, 0x0000FFFF);
+    DELTA_SWAP(*r, *l, 2, 0x33333333);
+    DELTA_SWAP(*r, *l, 8, 0x00FF00FF);
+    DELTA_SWAP(*l, *r, 1, 0x55555555);
+}
+
+// 最终置换 (IP^-1)：位交换是对合，按相反顺序执行同样的5步即为逆置换
+static inline void des_fp(uint32_t *l, uint32_t *r) {
+    DELTA_SWAP(*l, *r, 1, 0x55555555);
+    DELTA_SWAP(*r, *l, 8, 0x00FF00FF);
+    DELTA_SWAP(*r, *l, 2, 0x33333333);
+    DELTA_SWAP(*l, *r, 16, 0x0000FFFF);
+    DELTA_SWAP(*l, *r, 4, 0x0F0F0F0F);
 }
 
 // 28位循环左移
@@ -133,58 +515,98 @@ static uint32_t rol28(uint32_t val, int shift) {
     return ((val << shift) | (val >> (28 - shift))) & 0x0FFFFFFF;
 }
 
+// 32位循环右移
+static uint32_t ror32(uint32_t val, int shift) {
+    return (val >> shift) | (val << (32 - shift));
+}
+
 // DES核心的F函数
+// E扩展的第i组6位正是 R 循环右移 (27 - 4i) 位后的低6位，所以 R 右移3位后的4个字节
+// 依次对应 S1/S3/S5/S7 的输入，右移7位后依次对应 S8/S2/S4/S6 的输入；
+// 与同样布局的子密钥异或后，8次 sp_trans 查表同时完成S盒代换和P置换
 static uint32_t des_f_function(uint32_t r, uint64_t subkey) {
-    // 1. 扩展置换 E: 32位 -> 48位
-    uint64_t expanded_r = 0;
-    for (int i = 0; i < 48; ++i) {
-        if ((r >> (32 - e_table[i])) & 1) {
-            expanded_r |= (1ULL << (47 - i));
-        }
+    uint32_t u = ror32(r, 3) ^ (uint32_t) (subkey >> 32);
+    uint32_t t = ror32(r, 7) ^ (uint32_t) subkey;
+
+    return sp_trans[0][(u >> 24) & 0x3F] ^ sp_trans[2][(u >> 16) & 0x3F] ^
+           sp_trans[4][(u >> 8) & 0x3F] ^ sp_trans[6][u & 0x3F] ^
+           sp_trans[7][(t >> 24) & 0x3F] ^ sp_trans[1][(t >> 16) & 0x3F] ^
+           sp_trans[3][(t >> 8) & 0x3F] ^ sp_trans[5][t & 0x3F];
+}
+
+// 16轮 Feistel 网络：子密钥从 k 开始以 step (1 或 -1) 为步长依次读取，方向在调用前确定，轮内不再判断
+// 每次迭代做两轮，左右两半轮流更新而不交换；返回时 *l、*r 分别为 L16、R16
+static inline void des_rounds(uint32_t *l, uint32_t *r, const uint64_t *k, ptrdiff_t step) {
+    uint32_t a = *l, b = *r;
+
+    for (int i = 0; i < 8; ++i) {
+        a ^= des_f_function(b, k[0]);
+        b ^= des_f_function(a, k[step]);
+        k += 2 * step;
     }
+    *l = a;
+    *r = b;
+}
 
-    // 2. 与子密钥异或
-    expanded_r ^= subkey;
+// 按本次方向排好16个子密钥 (解密时逆序)，之后的分组循环只按顺序读取
+static void des_orient(const DES_key_schedule *schedule, int enc, uint64_t k[16]) {
+    for (int i = 0; i < 16; ++i) {
+        k[i] = schedule->subkeys[enc == DES_ENCRYPT ? i : 15 - i];
+    }
+}
 
-    // 3. S-盒代换: 48位 -> 32位
-    uint32_t s_output = 0;
+// 用已排好方向的子密钥处理一个分组
+static inline void des_block(const uint64_t k[16], const unsigned char *in, unsigned char *out) {
+    uint32_t l = load32_be(in);
+    uint32_t r = load32_be(in + 4);
+
+    des_ip(&l, &r);
+    des_rounds(&l, &r, k, 1);
+    des_fp(&r, &l);
+    store32_be(out, r);
+    store32_be(out + 4, l);
+}
+
+// 交错处理两个互相独立的分组：两条 Feistel 链的查表和异或可以在流水线中重叠
+static inline void des_block2(const uint64_t k[16], const unsigned char *in, unsigned char *out) {
+    uint32_t l0 = load32_be(in), r0 = load32_be(in + 4);
+    uint32_t l1 = load32_be(in + 8), r1 = load32_be(in + 12);
+
+    des_ip(&l0, &r0);
+    des_ip(&l1, &r1);
+    for (int i = 0; i < 16; i += 2) {
+        l0 ^= des_f_function(r0, k[i]);
+        l1 ^= des_f_function(r1, k[i]);
+        r0 ^= des_f_function(l0, k[i + 1]);
+        r1 ^= des_f_function(l1, k[i + 1]);
+    }
+    des_fp(&r0, &l0);
+    des_fp(&r1, &l1);
+    store32_be(out, r0);
+    store32_be(out + 4, l0);
+    store32_be(out + 8, r1);
+    store32_be(out + 12, l1);
+}
+
+static void xor_block8(unsigned char *out, const unsigned char *a, const unsigned char *b) {
     for (int i = 0; i < 8; ++i) {
-        // 提取6位输入
-        uint8_t six_bits = (expanded_r >> (42 - i * 6)) & 0x3F;
-        // 第1位和第6位组成行号
-        uint8_t row = ((six_bits & 0x20) >> 4) | (six_bits & 0x01);
-        // 中间4位组成列号
-        uint8_t col = (six_bits >> 1) & 0x0F;
-        // 查S盒
-        uint8_t val = s_boxes[i][row * 16 + col];
-        s_output |= (val << (28 - i * 4));
-    }
-
-    // 4. P-盒置换
-    uint32_t p_output = 0;
-    for (int i = 0; i < 32; ++i) {
-        if ((s_output >> (32 - p_table[i])) & 1) {
-            p_output |= (1U << (31 - i));
-        }
+        out[i] = a[i] ^ b[i];
     }
-    return p_output;
 }
 
 // --- API 函数实现 ---
 
 int DES_set_key(const DES_cblock *key, DES_key_schedule *schedule) {
-    uint64_t key64 = 0;
-    // 将8字节的key数组转为64位整数 (大端)
+    uint64_t cd = 0;
+
+    // 1. PC-1置换: 64位 -> 56位，每个半字节查一次表
     for (int i = 0; i < 8; ++i) {
-        key64 = (key64 << 8) | (*key)[i];
+        cd |= pc1_nibble[2 * i][(*key)[i] >> 4] | pc1_nibble[2 * i + 1][(*key)[i] & 0x0F];
     }
 
-    // 1. PC-1置换: 64位 -> 56位
-    uint64_t key56 = permute(key64, pc1_table, 56);
-
     // 2. 分成左右两部分 C0 和 D0 (各28位)
-    uint32_t c = (key56 >> 28) & 0x0FFFFFFF;
-    uint32_t d = key56 & 0x0FFFFFFF;
+    uint32_t c = (uint32_t) (cd >> 28) & 0x0FFFFFFF;
+    uint32_t d = (uint32_t) cd & 0x0FFFFFFF;
 
     // 3. 16轮迭代生成子密钥
     for (int i = 0; i < 16; ++i) {
@@ -192,60 +614,182 @@ int DES_set_key(const DES_cblock *key, DES_key_schedule *schedule) {
         c = rol28(c, key_shifts[i]);
         d = rol28(d, key_shifts[i]);
 
-        // 合并为56位
-        uint64_t cd = ((uint64_t) c << 28) | d;
-
-        // PC-2置换: 56位 -> 48位，得到子密钥
-        schedule->subkeys[i] = 0;
-        for (int j = 0; j < 48; ++j) {
-            if ((cd >> (56 - pc2_table[j])) & 1) {
-                schedule->subkeys[i] |= (1ULL << (47 - j));
-            }
-        }
+        // PC-2置换: 56位 -> 48位，C、D 各分4个7位组查表，直接得到F函数使用的布局
+        schedule->subkeys[i] = pc2_sp[0][c >> 21] | pc2_sp[1][(c >> 14) & 0x7F] |
+                               pc2_sp[2][(c >> 7) & 0x7F] | pc2_sp[3][c & 0x7F] |
+                               pc2_sp[4][d >> 21] | pc2_sp[5][(d >> 14) & 0x7F] |
+                               pc2_sp[6][(d >> 7) & 0x7F] | pc2_sp[7][d & 0x7F];
     }
     return 0; // 成功
 }
 
 void DES_ecb_encrypt(const DES_cblock *input, DES_cblock *output, DES_key_schedule *schedule, int enc) {
-    uint64_t block64 = 0;
-    // 将8字节的输入块转为64位整数 (大端)
-    for (int i = 0; i < 8; ++i) {
-        block64 = (block64 << 8) | (*input)[i];
+    // 读入大端的左右两半并做初始置换 (IP)，得到 L0 和 R0
+    uint32_t l = load32_be(*input);
+    uint32_t r = load32_be(*input + 4);
+    des_ip(&l, &r);
+
+    // 16轮 Feistel 网络，解密时子密钥逆序使用
+    if (enc == DES_ENCRYPT) {
+        des_rounds(&l, &r, schedule->subkeys, 1);
+    } else {
+        des_rounds(&l, &r, schedule->subkeys + 15, -1);
     }
 
-    // 1. 初始置换 (IP)
-    uint64_t permuted_block = permute(block64, ip_table, 64);
+    // 最终合并 (注意：先R后L)，再做最终置换 (IP^-1) 并按大端写出
+    des_fp(&r, &l);
+    store32_be(*output, r);
+    store32_be(*output + 4, l);
+}
 
-    // 2. 分成左右两部分 L0 和 R0 (各32位)
-    uint32_t l = (permuted_block >> 32) & 0xFFFFFFFF;
-    uint32_t r = permuted_block & 0xFFFFFFFF;
+void DES_ecb_encrypt_blocks(const unsigned char *input, unsigned char *output, size_t nblocks,
+                            const DES_key_schedule *schedule, int enc) {
+    uint64_t k[16];
+    unsigned int lanes = DES_bs_lanes();
+
+    // 至少凑满一批时，整批部分交给128/256路的位切片内核
+    if (lanes >= DES_BITSLICE_MIN_LANES && nblocks >= lanes) {
+        size_t n = nblocks - nblocks % lanes;
+
+        DES_bs_ecb_encrypt(input, output, n, schedule, enc);
+        input += n * 8;
+        output += n * 8;
+        nblocks -= n;
+        if (nblocks == 0) {
+            return;
+        }
+    }
 
-    // 3. 16轮 Feistel 网络
-    for (int i = 0; i < 16; ++i) {
-        uint32_t temp_r = r;
-        uint64_t subkey;
-
-        if (enc == DES_ENCRYPT) {
-            subkey = schedule->subkeys[i];
-        } else {
-            // 解密时，子密钥逆序使用
-            subkey = schedule->subkeys[15 - i];
+    des_orient(schedule, enc, k);
+    for (; nblocks >= 2; nblocks -= 2) {
+        des_block2(k, input, output);
+        input += 16;
+        output += 16;
+    }
+    if (nblocks > 0) {
+        des_block(k, input, output);
+    }
+    secure_wipe(k, sizeof(k));
+}
+
+void DES_cbc_encrypt_blocks(const unsigned char *input, unsigned char *output, size_t nblocks,
+                            const DES_key_schedule *schedule, DES_cblock *ivec, int enc) {
+    if (enc == DES_ENCRYPT) {
+        // 加密是串行依赖链，只能逐块处理
+        uint64_t k[16];
+        unsigned char block[8];
+
+        des_orient(schedule, enc, k);
+        memcpy(block, *ivec, 8);
+        for (size_t i = 0; i < nblocks; ++i) {
+            xor_block8(block, block, input + i * 8);
+            des_block(k, block, block);
+            memcpy(output + i * 8, block, 8);
+        }
+        memcpy(*ivec, block, 8);
+        secure_wipe(k, sizeof(k));
+        secure_wipe(block, sizeof(block));
+    } else {
+        // 解密的各分组互相独立：整段解密后再与前一个密文分组异或
+        unsigned char tmp[DES_CBC_BATCH * 8];
+        unsigned char next_iv[8];
+
+        while (nblocks > 0) {
+            size_t n = nblocks < DES_CBC_BATCH ? nblocks : DES_CBC_BATCH;
+
+            DES_ecb_encrypt_blocks(input, tmp, n, schedule, DES_DECRYPT);
+            memcpy(next_iv, input + (n - 1) * 8, 8);
+
+            // 从后往前异或，input 与 output 相同时前一个密文分组在用到之前不会被覆盖
+            for (size_t i = n - 1; i > 0; i--) {
+                xor_block8(output + i * 8, tmp + i * 8, input + (i - 1) * 8);
+            }
+            xor_block8(output, tmp, *ivec);
+            memcpy(*ivec, next_iv, 8);
+
+            input += n * 8;
+            output += n * 8;
+            nblocks -= n;
+        }
+        secure_wipe(tmp, sizeof(tmp));
+    }
+}
+
+void DES_ctr_encrypt(const unsigned char *input, unsigned char *output, size_t length,
+                     const DES_key_schedule *schedule, DES_cblock *counter) {
+    unsigned char ks[DES_CBC_BATCH * 8];
+    uint32_t hi = load32_be(*counter), lo = load32_be(*counter + 4);
+
+    while (length > 0) {
+        size_t nbytes = length < sizeof(ks) ? length : sizeof(ks);
+        size_t n = (nbytes + 7) / 8;
+
+        // 先写出一段连续的计数器分组，再整段加密成密钥流
+        for (size_t i = 0; i < n; ++i) {
+            store32_be(ks + i * 8, hi);
+            store32_be(ks + i * 8 + 4, lo);
+            if (++lo == 0) {
+                ++hi;
+            }
+        }
+        DES_ecb_encrypt_blocks(ks, ks, n, schedule, DES_ENCRYPT);
+        for (size_t i = 0; i < nbytes; ++i) {
+            output[i] = input[i] ^ ks[i];
         }
 
-        // F函数的计算结果与L异或
-        r = l ^ des_f_function(r, subkey);
-        l = temp_r;
+        input += nbytes;
+        output += nbytes;
+        length -= nbytes;
     }
+    store32_be(*counter, hi);
+    store32_be(*counter + 4, lo);
+    secure_wipe(ks, sizeof(ks));
+}
 
-    // 4. 最终合并 (注意：先R后L)
-    uint64_t pre_output = ((uint64_t) r << 32) | l;
+int DES_set_key_ede3(const DES_cblock *key1, const DES_cblock *key2, const DES_cblock *key3,
+                     DES_EDE_key_schedule *schedule) {
+    DES_key_schedule ks;
 
-    // 5. 最终置换 (IP^-1)
-    uint64_t final_block = permute(pre_output, fp_table, 64);
+    // 加密顺序为 E(K1)、D(K2)、E(K3)：K2 的子密钥逆序存放
+    DES_set_key(key1, &ks);
+    memcpy(schedule->subkeys, ks.subkeys, sizeof(ks.subkeys));
+    DES_set_key(key2, &ks);
+    for (int i = 0; i < 16; ++i) {
+        schedule->subkeys[16 + i] = ks.subkeys[15 - i];
+    }
+    DES_set_key(key3, &ks);
+    memcpy(schedule->subkeys + 32, ks.subkeys, sizeof(ks.subkeys));
 
-    // 6. 将64位整数转回8字节的输出块 (大端)
-    for (int i = 0; i < 8; ++i) {
-        (*output)[7 - i] = final_block & 0xFF;
-        final_block >>= 8;
+    secure_wipe(&ks, sizeof(ks));
+    return 0;
+}
+
+int DES_set_key_ede2(const DES_cblock *key1, const DES_cblock *key2, DES_EDE_key_schedule *schedule) {
+    return DES_set_key_ede3(key1, key2, key1, schedule);
+}
+
+void DES_ede3_ecb_encrypt(const DES_cblock *input, DES_cblock *output, const DES_EDE_key_schedule *schedule,
+                          int enc) {
+    const uint64_t *k = schedule->subkeys;
+    ptrdiff_t step = 1;
+
+    // 解密即把48个子密钥整体逆序使用
+    if (enc != DES_ENCRYPT) {
+        k += 47;
+        step = -1;
     }
+
+    uint32_t l = load32_be(*input);
+    uint32_t r = load32_be(*input + 4);
+    des_ip(&l, &r);
+
+    // 相邻两次 DES 之间的 FP 与 IP 互相抵消，只剩左右交换：
+    // 每段结束时 (L16, R16) 交换后即为下一段的 (L0, R0)，所以下一段直接以 (r, l) 的角色继续
+    des_rounds(&l, &r, k, step);
+    des_rounds(&r, &l, k + 16 * step, step);
+    des_rounds(&l, &r, k + 32 * step, step);
+
+    des_fp(&r, &l);
+    store32_be(*output, r);
+    store32_be(*output + 4, l);
 }
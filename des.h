@@ -9,14 +9,29 @@
 #define DES_ENCRYPT 1
 #define DES_DECRYPT 0
 
+// 多分组接口使用位切片内核 (des_bitslice.h) 所需的最小宽度：64路内核只在大批量时与
+// 双分组交错的标量路径持平，批量较小时更慢，所以只用128/256路内核，
+// 且只把 DES_bs_lanes() 的整数倍交给它，剩余分组仍走标量路径
+#define DES_BITSLICE_MIN_LANES 128
+
+// CBC 解密和 CTR 每次成批处理的分组数
+#define DES_CBC_BATCH 256
+
 // DES 使用 64 位 (8 字节) 的块
 typedef unsigned char DES_cblock[8];
 
 // DES 密钥计划结构，用于存储16个48位的子密钥
+// 子密钥按F函数的查表布局存放：8组6位分别位于两个32位字的各字节低6位 (见 des.c)
 typedef struct {
     uint64_t subkeys[16];
 } DES_key_schedule;
 
+// 3DES (EDE) 密钥计划：三组子密钥按加密时的使用顺序连续存放，
+// 即 K1 正序、K2 逆序、K3 正序共48个；解密时整体逆序使用
+typedef struct {
+    uint64_t subkeys[48];
+} DES_EDE_key_schedule;
+
 /**
  * @brief 设置 DES 密钥，并根据密钥生成16轮的子密钥。
  * @param key 指向 8 字节密钥的指针。DES会忽略每个字节的最低位，因此有效密钥长度为56位。
@@ -34,4 +49,71 @@ int DES_set_key(const DES_cblock *key, DES_key_schedule *schedule);
  */
 void DES_ecb_encrypt(const DES_cblock *input, DES_cblock *output, DES_key_schedule *schedule, int enc);
 
+/**
+ * @brief 使用 ECB 模式加密或解密 nblocks 个连续的 8 字节分组。
+ * 子密钥按方向排好一次后逐块处理，相邻两块交错计算；分组较多时改用位切片内核。
+ * @param input 输入数据，长度为 nblocks * 8 字节。
+ * @param output 输出数据，可以与 input 相同。
+ * @param nblocks 分组数。
+ * @param schedule 已初始化的密钥计划。
+ * @param enc DES_ENCRYPT (1) 表示加密, DES_DECRYPT (0) 表示解密。
+ */
+void DES_ecb_encrypt_blocks(const unsigned char *input, unsigned char *output, size_t nblocks,
+                            const DES_key_schedule *schedule, int enc);
+
+/**
+ * @brief 使用 CBC 模式加密或解密 nblocks 个连续的 8 字节分组 (不做填充)。
+ * 加密只能逐块串行；解密各块互相独立，成批解密后再与前一密文块异或。
+ * @param input 输入数据，长度为 nblocks * 8 字节。
+ * @param output 输出数据，可以与 input 相同。
+ * @param nblocks 分组数。
+ * @param schedule 已初始化的密钥计划。
+ * @param ivec 初始向量，返回时更新为最后一个密文分组，可用于继续处理后续数据。
+ * @param enc DES_ENCRYPT (1) 表示加密, DES_DECRYPT (0) 表示解密。
+ */
+void DES_cbc_encrypt_blocks(const unsigned char *input, unsigned char *output, size_t nblocks,
+                            const DES_key_schedule *schedule, DES_cblock *ivec, int enc);
+
+/**
+ * @brief 使用 CTR 模式加密或解密任意长度的数据 (加解密相同)。
+ * @param input 输入数据。
+ * @param output 输出数据，可以与 input 相同。
+ * @param length 数据长度 (字节)，不必是 8 的倍数。
+ * @param schedule 已初始化的密钥计划。
+ * @param counter 64 位大端计数器，返回时前进本次使用的分组数 (最后不足一块也计为一块)。
+ */
+void DES_ctr_encrypt(const unsigned char *input, unsigned char *output, size_t length,
+                     const DES_key_schedule *schedule, DES_cblock *counter);
+
+/**
+ * @brief 设置三密钥 3DES (EDE3) 的密钥计划，加密为 E(K3, D(K2, E(K1, P)))。
+ * @param key1 第一个 8 字节密钥。
+ * @param key2 第二个 8 字节密钥。
+ * @param key3 第三个 8 字节密钥。
+ * @param schedule 指向 DES_EDE_key_schedule 结构的指针，用于存储48个子密钥。
+ * @return 0 表示成功。
+ */
+int DES_set_key_ede3(const DES_cblock *key1, const DES_cblock *key2, const DES_cblock *key3,
+                     DES_EDE_key_schedule *schedule);
+
+/**
+ * @brief 设置双密钥 3DES (EDE2) 的密钥计划，等同于 K3 = K1 的 EDE3。
+ * @param key1 第一个 8 字节密钥，同时用作第三段密钥。
+ * @param key2 第二个 8 字节密钥。
+ * @param schedule 指向 DES_EDE_key_schedule 结构的指针。
+ * @return 0 表示成功。
+ */
+int DES_set_key_ede2(const DES_cblock *key1, const DES_cblock *key2, DES_EDE_key_schedule *schedule);
+
+/**
+ * @brief 使用 ECB 模式对单个 8 字节块进行 3DES 加密或解密。
+ * 三段 DES 之间的 FP/IP 互相抵消，内部只做一次 IP 和一次 FP，中间连续执行48轮。
+ * @param input 指向 8 字节输入数据块的指针。
+ * @param output 指向 8 字节输出数据块的指针。
+ * @param schedule 指向已通过 DES_set_key_ede2/DES_set_key_ede3 初始化的密钥计划。
+ * @param enc DES_ENCRYPT (1) 表示加密, DES_DECRYPT (0) 表示解密。
+ */
+void DES_ede3_ecb_encrypt(const DES_cblock *input, DES_cblock *output, const DES_EDE_key_schedule *schedule,
+                          int enc);
+
 #endif // DES_H
\ No newline at end of file
@@ -0,0 +1,300 @@
+//
+// 位切片 DES
+//
+// 把 N 个分组的同一位收集到一个 N 位的字里 (切片)，64个切片就表示 N 个分组。
+// 此时 IP、E、P 这些置换只是切片的重新编号，S盒用与/或/异或/非组成的电路计算，
+// 一次逻辑运算同时作用于全部 N 个分组，没有查表，执行时间与数据和密钥无关。
+// 内核 (des_bitslice_kernel.h) 按 uint64_t、SSE2、AVX2 三种宽度各实例化一次。
+//
+
+#include "des_bitslice.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cpu_features.h"
+#include "crypto_util.h"
+
+// 以下置换表为 DES 标准表减1 (从0开始的位序号)
+// 初始置换 (IP)：L0 的第 i 位取自输入第 bs_ip[i] 位，R0 的第 i 位取自 bs_ip[32 + i]
+static const uint8_t bs_ip[64] = {
+    57, 49, 41, 33, 25, 17,  9,  1, 59, 51, 43, 35, 27, 19, 11,  3,
+    61, 53, 45, 37, 29, 21, 13,  5, 63, 55, 47, 39, 31, 23, 15,  7,
+    56, 48, 40, 32, 24, 16,  8,  0, 58, 50, 42, 34, 26, 18, 10,  2,
+    60, 52, 44, 36, 28, 20, 12,  4, 62, 54, 46, 38, 30, 22, 14,  6
+};
+
+// E扩展：S盒输入的第 j 位取自 R 的第 bs_e[j] 位
+static const uint8_t bs_e[48] = {
+    31,  0,  1,  2,  3,  4,  3,  4,  5,  6,  7,  8,  7,  8,  9, 10,
+    11, 12, 11, 12, 13, 14, 15, 16, 15, 16, 17, 18, 19, 20, 19, 20,
+    21, 22, 23, 24, 23, 24, 25, 26, 27, 28, 27, 28, 29, 30, 31,  0
+};
+
+// P置换：F函数输出的第 i 位取自S盒输出的第 bs_p[i] 位
+static const uint8_t bs_p[32] = {
+    15,  6, 19, 20, 28, 11, 27, 16,  0, 14, 22, 25,  4, 17, 30,  9,
+     1,  7, 23, 13, 31, 26,  2,  8, 18, 12, 29,  5, 21, 10,  3, 24
+};
+
+// 最终置换 (IP^-1)：输出的第 j 位取自 R16 || L16 的第 bs_fp[j] 位
+static const uint8_t bs_fp[64] = {
+    39,  7, 47, 15, 55, 23, 63, 31, 38,  6, 46, 14, 54, 22, 62, 30,
+    37,  5, 45, 13, 53, 21, 61, 29, 36,  4, 44, 12, 52, 20, 60, 28,
+    35,  3, 43, 11, 51, 19, 59, 27, 34,  2, 42, 10, 50, 18, 58, 26,
+    33,  1, 41,  9, 49, 17, 57, 25, 32,  0, 40,  8, 48, 16, 56, 24
+};
+
+// S1..S8 的6位子密钥在 DES_key_schedule 查表布局 (见 des.c) 中的位置
+static const uint8_t sp_key_shift[8] = {56, 16, 48, 8, 40, 0, 32, 24};
+
+// 密钥序号第 t 位 (从最低位起) 对应的密钥位 (DES 位序，0为最高位)：56个非校验位按从低到高排列
+static const uint8_t bs_index_bit[56] = {
+    62, 61, 60, 59, 58, 57, 56, 54, 53, 52, 51, 50, 49, 48,
+    46, 45, 44, 43, 42, 41, 40, 38, 37, 36, 35, 34, 33, 32,
+    30, 29, 28, 27, 26, 25, 24, 22, 21, 20, 19, 18, 17, 16,
+    14, 13, 12, 11, 10,  9,  8,  6,  5,  4,  3,  2,  1,  0
+};
+
+// 64x64 位矩阵原地转置 (位从最高位开始编号)：每步交换对角线两侧的子块，共6步
+static void transpose64(uint64_t a[64]) {
+    uint64_t m = 0x00000000FFFFFFFFULL;
+
+    for (int j = 32; j != 0; j >>= 1, m ^= m << j) {
+        for (int k = 0; k < 64; k = (k + j + 1) & ~j) {
+            uint64_t t = (a[k] ^ (a[k + j] >> j)) & m;
+            a[k] ^= t;
+            a[k + j] ^= t << j;
+        }
+    }
+}
+
+// 把 n 个分组转置为切片：每64个分组一组，rows[j * groups + g] 为第 g 组所有分组第 j 位组成的字
+static void bs_load(const unsigned char *in, size_t n, uint64_t *rows, size_t groups) {
+    uint64_t m[64];
+
+    for (size_t g = 0; g < groups; g++) {
+        for (size_t b = 0; b < 64; b++) {
+            size_t idx = g * 64 + b;
+            m[b] = idx < n ? load64_be(in + idx * 8) : 0;
+        }
+        transpose64(m);
+        for (size_t j = 0; j < 64; j++) {
+            rows[j * groups + g] = m[j];
+        }
+    }
+}
+
+// bs_load 的逆过程，只写出前 n 个分组
+static void bs_store(const uint64_t *rows, unsigned char *out, size_t n, size_t groups) {
+    uint64_t m[64];
+
+    for (size_t g = 0; g < groups && g * 64 < n; g++) {
+        for (size_t j = 0; j < 64; j++) {
+            m[j] = rows[j * groups + g];
+        }
+        transpose64(m);
+        for (size_t b = 0; b < 64 && g * 64 + b < n; b++) {
+            store64_be(out + (g * 64 + b) * 8, m[b]);
+        }
+    }
+}
+
+// --- 内核实例化 ---
+
+// 64路：可移植的 uint64_t
+#define BS_T uint64_t
+#define BS_FN(name) name##_u64
+#define BS_TARGET
+#include "des_bitslice_kernel.h"
+#undef BS_T
+#undef BS_FN
+#undef BS_TARGET
+
+#if CPU_X86
+typedef unsigned long long bs_v128 __attribute__((vector_size(16)));
+typedef unsigned long long bs_v256 __attribute__((vector_size(32)));
+
+// 128路：SSE2
+#define BS_T bs_v128
+#define BS_FN(name) name##_sse2
+#define BS_TARGET __attribute__((target("sse2")))
+#include "des_bitslice_kernel.h"
+#undef BS_T
+#undef BS_FN
+#undef BS_TARGET
+
+// 256路：AVX2
+#define BS_T bs_v256
+#define BS_FN(name) name##_avx2
+#define BS_TARGET __attribute__((target("avx2")))
+#include "des_bitslice_kernel.h"
+#undef BS_T
+#undef BS_FN
+#undef BS_TARGET
+#endif
+
+// --- 宽度选择 ---
+
+static int lanes_available(unsigned int lanes) {
+    switch (lanes) {
+        case 64:
+            return 1;
+#if CPU_X86
+        case 128:
+            return cpu_has(CPU_SSE2);
+        case 256:
+            return cpu_has(CPU_AVX2);
+#endif
+        default:
+            return 0;
+    }
+}
+
+static unsigned int max_lanes = 0; // 0 表示尚未选择
+
+// 选定每批最多并行的分组数：环境变量 DES_BS_LANES 优先，否则取CPU支持的最宽内核
+static unsigned int resolve_lanes(void) {
+    if (max_lanes == 0) {
+        const char *env = getenv("DES_BS_LANES");
+        unsigned int lanes = env ? (unsigned int) strtoul(env, NULL, 10) : 0;
+
+        if (!lanes_available(lanes)) {
+            lanes = lanes_available(256) ? 256 : lanes_available(128) ? 128 : 64;
+        }
+        max_lanes = lanes;
+    }
+    return max_lanes;
+}
+
+int DES_bs_set_lanes(unsigned int lanes) {
+    if (lanes != 0 && !lanes_available(lanes)) {
+        return -1;
+    }
+    max_lanes = lanes;
+    return 0;
+}
+
+unsigned int DES_bs_lanes(void) {
+    return resolve_lanes();
+}
+
+// 展开子密钥的每一位，按本次使用的轮顺序排列 (解密时逆序)
+static void schedule_bits(const DES_key_schedule *schedule, int enc, uint8_t kbits[16][48]) {
+    for (int i = 0; i < 16; i++) {
+        uint64_t subkey = schedule->subkeys[enc == DES_ENCRYPT ? i : 15 - i];
+
+        for (int s = 0; s < 8; s++) {
+            unsigned int chunk = (unsigned int) (subkey >> sp_key_shift[s]) & 0x3F;
+            for (int b = 0; b < 6; b++) {
+                kbits[i][s * 6 + b] = (uint8_t) ((chunk >> (5 - b)) & 1);
+            }
+        }
+    }
+}
+
+void DES_bs_ecb_encrypt(const unsigned char *input, unsigned char *output, size_t nblocks,
+                        const DES_key_schedule *schedule, int enc) {
+    uint8_t kbits[16][48];
+    unsigned int lanes = resolve_lanes();
+
+    schedule_bits(schedule, enc, kbits);
+
+    // 先用最宽的内核处理整批，剩余部分交给能容纳它的最窄内核，避免补齐浪费
+    while (nblocks > 0) {
+        size_t n = nblocks;
+        unsigned int width = lanes;
+
+        if (n >= lanes) {
+            n -= n % lanes;
+        } else {
+            while (width > 64 && n <= width / 2) {
+                width /= 2;
+            }
+        }
+
+        switch (width) {
+#if CPU_X86
+            case 256:
+                des_bs_blocks_avx2(kbits, input, output, n);
+                break;
+            case 128:
+                des_bs_blocks_sse2(kbits, input, output, n);
+                break;
+#endif
+            default:
+                des_bs_blocks_u64(kbits, input, output, n);
+                break;
+        }
+
+        input += n * 8;
+        output += n * 8;
+        nblocks -= n;
+    }
+    secure_wipe(kbits, sizeof(kbits));
+}
+
+// --- 密钥搜索 ---
+
+// 密钥计划是密钥位的置换：逐个只置一位密钥调用 DES_set_key，就能得到每个子密钥位来自哪个密钥位
+static void build_keymap(uint8_t keymap[16][48]) {
+    for (int t = 0; t < 56; t++) {
+        int q = bs_index_bit[t];
+        DES_cblock key = {0};
+        DES_key_schedule schedule;
+        uint8_t kbits[16][48];
+
+        key[q / 8] = (unsigned char) (0x80 >> (q % 8));
+        DES_set_key(&key, &schedule);
+        schedule_bits(&schedule, DES_ENCRYPT, kbits);
+        for (int i = 0; i < 16; i++) {
+            for (int j = 0; j < 48; j++) {
+                if (kbits[i][j]) {
+                    keymap[i][j] = (uint8_t) q;
+                }
+            }
+        }
+    }
+}
+
+void DES_bs_index_to_key(uint64_t index, DES_cblock *key) {
+    for (int i = 0; i < 8; i++) {
+        unsigned int b = (unsigned int) (index >> (49 - 7 * i)) & 0x7F;
+        // 最低位为奇校验位
+        (*key)[i] = (unsigned char) ((b << 1) | ((__builtin_popcount(b) & 1) ^ 1));
+    }
+}
+
+uint64_t DES_bs_key_to_index(const DES_cblock *key) {
+    uint64_t index = 0;
+
+    for (int i = 0; i < 8; i++) {
+        index = (index << 7) | ((*key)[i] >> 1);
+    }
+    return index;
+}
+
+int DES_bs_search_keys(const DES_cblock *plaintext, const DES_cblock *ciphertext, uint64_t first, uint64_t count,
+                       uint64_t *index) {
+    uint8_t keymap[16][48];
+
+    if (count == 0 || first >= DES_BS_KEYSPACE) {
+        return 0;
+    }
+    if (count > DES_BS_KEYSPACE - first) {
+        count = DES_BS_KEYSPACE - first;
+    }
+    build_keymap(keymap);
+
+    switch (resolve_lanes()) {
+#if CPU_X86
+        case 256:
+            return des_bs_search_avx2(keymap, *plaintext, *ciphertext, first, count, index);
+        case 128:
+            return des_bs_search_sse2(keymap, *plaintext, *ciphertext, first, count, index);
+#endif
+        default:
+            return des_bs_search_u64(keymap, *plaintext, *ciphertext, first, count, index);
+    }
+}
@@ -0,0 +1,56 @@
+//
+// 位切片 DES - 用布尔电路代替S盒查表，一次并行处理64/128/256个互相独立的分组
+//
+
+#ifndef DES_BITSLICE_H
+#define DES_BITSLICE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "des.h"
+
+// 每批最多并行的分组数 (AVX2)
+#define DES_BS_MAX_LANES 256
+
+// 限制每批的分组数：64 (uint64_t)、128 (SSE2)、256 (AVX2)，0 表示自动；CPU 不支持或数值无效返回-1
+// 自动模式下使用CPU支持的最宽内核，剩余分组不足一批时换用能容纳它们的较窄内核；
+// 环境变量 DES_BS_LANES=64/128/256 可强制指定
+int DES_bs_set_lanes(unsigned int lanes);
+
+// 返回当前每批最多并行的分组数
+unsigned int DES_bs_lanes(void);
+
+/**
+ * @brief 用位切片内核对 nblocks 个 8 字节分组做 DES ECB 加密或解密。
+ * @param input 输入数据，长度为 nblocks * 8 字节。
+ * @param output 输出数据，可以与 input 相同。
+ * @param nblocks 分组数，任意数量，内部按批处理。
+ * @param schedule 已通过 DES_set_key 初始化的密钥计划，所有分组共用。
+ * @param enc DES_ENCRYPT (1) 表示加密, DES_DECRYPT (0) 表示解密。
+ * 分组与切片之间的位矩阵转置在内部完成，结果与逐块调用 DES_ecb_encrypt 相同。
+ */
+void DES_bs_ecb_encrypt(const unsigned char *input, unsigned char *output, size_t nblocks,
+                        const DES_key_schedule *schedule, int enc);
+
+// 有效密钥空间大小 (56位)
+#define DES_BS_KEYSPACE (1ULL << 56)
+
+// 密钥序号与8字节密钥的对应：序号的56位从高到低依次填入各字节的高7位，最低位补为奇校验位
+void DES_bs_index_to_key(uint64_t index, DES_cblock *key);
+uint64_t DES_bs_key_to_index(const DES_cblock *key);
+
+/**
+ * @brief 已知明文密钥搜索：在密钥序号 [first, first + count) 中查找把 plaintext 加密为 ciphertext 的密钥。
+ * 每个 lane 使用不同的密钥，一次内核调用同时检验 DES_bs_lanes() 个候选密钥。
+ * @param plaintext 已知明文分组。
+ * @param ciphertext 对应的密文分组。
+ * @param first 起始密钥序号。
+ * @param count 检验的密钥个数。
+ * @param index 找到时写入命中的密钥序号。
+ * @return 找到返回1，否则返回0。
+ */
+int DES_bs_search_keys(const DES_cblock *plaintext, const DES_cblock *ciphertext, uint64_t first, uint64_t count,
+                       uint64_t *index);
+
+#endif //DES_BITSLICE_H
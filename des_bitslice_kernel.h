@@ -0,0 +1,781 @@
+//
+// 位切片 DES 内核模板 - 由 des_bitslice.c 按不同向量宽度多次包含，不单独使用
+//
+// 包含前需定义：
+//   BS_T       切片类型 (uint64_t 或 GCC 向量类型)，每一位对应一个分组
+//   BS_FN(n)   给函数名加上宽度后缀
+//   BS_TARGET  函数的 target 属性 (可为空)
+// S盒电路由真值表按6个输入逐一展开为选择器网络、合并相同子函数后生成，已对全部64个输入穷举验证
+//
+
+#define BS_INLINE static inline __attribute__((always_inline)) BS_TARGET
+
+// S1：115 个逻辑运算
+BS_INLINE void BS_FN(s1)(BS_T a1, BS_T a2, BS_T a3, BS_T a4, BS_T a5, BS_T a6,
+                          BS_T *o1, BS_T *o2, BS_T *o3, BS_T *o4) {
+    BS_T t0 = ~a5;
+    BS_T t1 = a2 ^ t0;
+    BS_T t2 = ~a2;
+    BS_T t3 = t1 ^ (a3 & t2);
+    BS_T t4 = t1 ^ (a3 & a5);
+    BS_T t5 = t3 ^ t4;
+    BS_T t6 = t3 ^ (a4 & t5);
+    BS_T t7 = ~t3;
+    BS_T t8 = a2 ^ (a3 & t0);
+    BS_T t9 = t7 ^ t8;
+    BS_T t10 = t7 ^ (a4 & t9);
+    BS_T t11 = t6 ^ t10;
+    BS_T t12 = t6 ^ (a6 & t11);
+    BS_T t13 = ~a2 | t0;
+    BS_T t14 = t13 ^ (a3 & t0);
+    BS_T t15 = t8 ^ t14;
+    BS_T t16 = t8 ^ (a4 & t15);
+    BS_T t17 = ~t1;
+    BS_T t18 = t15 ^ t17;
+    BS_T t19 = t15 ^ (a3 & t18);
+    BS_T t20 = ~t13;
+    BS_T t21 = t1 ^ t20;
+    BS_T t22 = t1 ^ (a3 & t21);
+    BS_T t23 = t19 ^ t22;
+    BS_T t24 = t19 ^ (a4 & t23);
+    BS_T t25 = t16 ^ t24;
+    BS_T t26 = t16 ^ (a6 & t25);
+    BS_T t27 = t12 ^ t26;
+    BS_T t28 = t12 ^ (a1 & t27);
+    BS_T t29 = ~t8;
+    BS_T t30 = ~t21;
+    BS_T t31 = t29 ^ (a4 & t30);
+    BS_T t32 = a5 ^ (a3 & t2);
+    BS_T t33 = t13 ^ (a3 & t17);
+    BS_T t34 = t32 ^ t33;
+    BS_T t35 = t32 ^ (a4 & t34);
+    BS_T t36 = t31 ^ t35;
+    BS_T t37 = t31 ^ (a6 & t36);
+    BS_T t38 = t18 ^ (a3 & t30);
+    BS_T t39 = t1 ^ (a3 & t18);
+    BS_T t40 = t38 ^ t39;
+    BS_T t41 = t38 ^ (a4 & t40);
+    BS_T t42 = a4 ^ t33;
+    BS_T t43 = t41 ^ t42;
+    BS_T t44 = t41 ^ (a6 & t43);
+    BS_T t45 = t37 ^ t44;
+    BS_T t46 = t37 ^ (a1 & t45);
+    BS_T t47 = t38 ^ (a4 & t3);
+    BS_T t48 = t30 ^ (a3 & t18);
+    BS_T t49 = t48 ^ (a4 & t13);
+    BS_T t50 = t47 ^ t49;
+    BS_T t51 = t47 ^ (a6 & t50);
+    BS_T t52 = ~t15;
+    BS_T t53 = t52 ^ (a3 & a5);
+    BS_T t54 = t53 ^ (a4 & t18);
+    BS_T t55 = t39 ^ (a4 & t14);
+    BS_T t56 = t54 ^ t55;
+    BS_T t57 = t54 ^ (a6 & t56);
+    BS_T t58 = t51 ^ t57;
+    BS_T t59 = t51 ^ (a1 & t58);
+    BS_T t60 = t53 ^ (a4 & t13);
+    BS_T t61 = ~t38;
+    BS_T t62 = t61 ^ (a4 & t15);
+    BS_T t63 = t60 ^ t62;
+    BS_T t64 = t60 ^ (a6 & t63);
+    BS_T t65 = a2 ^ (a3 & a5);
+    BS_T t66 = t7 ^ t65;
+    BS_T t67 = t7 ^ (a4 & t66);
+    BS_T t68 = a3 ^ t18;
+    BS_T t69 = t68 ^ (a4 & t1);
+    BS_T t70 = t67 ^ t69;
+    BS_T t71 = t67 ^ (a6 & t70);
+    BS_T t72 = t64 ^ t71;
+    BS_T t73 = t64 ^ (a1 & t72);
+    *o1 = t28;
+    *o2 = t46;
+    *o3 = t59;
+    *o4 = t73;
+}
+
+// S2：105 个逻辑运算
+BS_INLINE void BS_FN(s2)(BS_T a1, BS_T a2, BS_T a3, BS_T a4, BS_T a5, BS_T a6,
+                          BS_T *o1, BS_T *o2, BS_T *o3, BS_T *o4) {
+    BS_T t0 = ~a6;
+    BS_T t1 = a5 ^ t0;
+    BS_T t2 = a3 ^ t1;
+    BS_T t3 = t2 ^ (a4 & a5);
+    BS_T t4 = a5 | a6;
+    BS_T t5 = t4 ^ t1;
+    BS_T t6 = t4 ^ (a3 & t5);
+    BS_T t7 = ~t5;
+    BS_T t8 = t6 ^ (a4 & t7);
+    BS_T t9 = t3 ^ t8;
+    BS_T t10 = t3 ^ (a1 & t9);
+    BS_T t11 = ~a5;
+    BS_T t12 = t11 ^ (a3 & a6);
+    BS_T t13 = a4 ^ t12;
+    BS_T t14 = ~t1;
+    BS_T t15 = t14 ^ (a3 & t5);
+    BS_T t16 = a4 ^ t15;
+    BS_T t17 = t13 ^ t16;
+    BS_T t18 = t13 ^ (a1 & t17);
+    BS_T t19 = t10 ^ t18;
+    BS_T t20 = t10 ^ (a2 & t19);
+    BS_T t21 = t1 ^ (a3 & a6);
+    BS_T t22 = t4 ^ a5;
+    BS_T t23 = t4 ^ (a3 & t22);
+    BS_T t24 = t21 ^ t23;
+    BS_T t25 = t21 ^ (a4 & t24);
+    BS_T t26 = a1 ^ t25;
+    BS_T t27 = t14 ^ (a3 & t0);
+    BS_T t28 = a5 & t0;
+    BS_T t29 = ~t22;
+    BS_T t30 = t28 ^ (a3 & t29);
+    BS_T t31 = t27 ^ t30;
+    BS_T t32 = t27 ^ (a4 & t31);
+    BS_T t33 = ~t4;
+    BS_T t34 = t1 ^ (a3 & t33);
+    BS_T t35 = ~a3 | t14;
+    BS_T t36 = t34 ^ t35;
+    BS_T t37 = t34 ^ (a4 & t36);
+    BS_T t38 = t32 ^ t37;
+    BS_T t39 = t32 ^ (a1 & t38);
+    BS_T t40 = t26 ^ t39;
+    BS_T t41 = t26 ^ (a2 & t40);
+    BS_T t42 = a3 | t11;
+    BS_T t43 = t42 ^ (a4 & t35);
+    BS_T t44 = a3 ^ t28;
+    BS_T t45 = t44 ^ (a4 & t11);
+    BS_T t46 = t43 ^ t45;
+    BS_T t47 = t43 ^ (a1 & t46);
+    BS_T t48 = t28 ^ (a3 & t14);
+    BS_T t49 = t48 ^ t2;
+    BS_T t50 = t48 ^ (a4 & t49);
+    BS_T t51 = a6 ^ (a3 & t4);
+    BS_T t52 = ~t34;
+    BS_T t53 = t51 ^ t52;
+    BS_T t54 = t51 ^ (a4 & t53);
+    BS_T t55 = t50 ^ t54;
+    BS_T t56 = t50 ^ (a1 & t55);
+    BS_T t57 = t47 ^ t56;
+    BS_T t58 = t47 ^ (a2 & t57);
+    BS_T t59 = t35 ^ (a4 & t5);
+    BS_T t60 = a4 ^ t31;
+    BS_T t61 = t59 ^ t60;
+    BS_T t62 = t59 ^ (a1 & t61);
+    BS_T t63 = t17 ^ (a4 & t11);
+    BS_T t64 = t11 ^ (a3 & t4);
+    BS_T t65 = t64 ^ (a4 & t33);
+    BS_T t66 = t63 ^ t65;
+    BS_T t67 = t63 ^ (a1 & t66);
+    BS_T t68 = t62 ^ t67;
+    BS_T t69 = t62 ^ (a2 & t68);
+    *o1 = t20;
+    *o2 = t41;
+    *o3 = t58;
+    *o4 = t69;
+}
+
+// S3：108 个逻辑运算
+BS_INLINE void BS_FN(s3)(BS_T a1, BS_T a2, BS_T a3, BS_T a4, BS_T a5, BS_T a6,
+                          BS_T *o1, BS_T *o2, BS_T *o3, BS_T *o4) {
+    BS_T t0 = ~a5;
+    BS_T t1 = a2 ^ t0;
+    BS_T t2 = ~a5 | a6;
+    BS_T t3 = a2 & t2;
+    BS_T t4 = t1 ^ t3;
+    BS_T t5 = t1 ^ (a3 & t4);
+    BS_T t6 = ~a6;
+    BS_T t7 = a5 | t6;
+    BS_T t8 = ~t2;
+    BS_T t9 = t7 ^ (a2 & t8);
+    BS_T t10 = a5 ^ t6;
+    BS_T t11 = a2 ^ t10;
+    BS_T t12 = t9 ^ t11;
+    BS_T t13 = t9 ^ (a3 & t12);
+    BS_T t14 = t5 ^ t13;
+    BS_T t15 = t5 ^ (a4 & t14);
+    BS_T t16 = t10 ^ (a3 & t12);
+    BS_T t17 = a4 ^ t16;
+    BS_T t18 = t15 ^ t17;
+    BS_T t19 = t15 ^ (a1 & t18);
+    BS_T t20 = a6 ^ t8;
+    BS_T t21 = a6 ^ (a2 & t20);
+    BS_T t22 = t21 ^ t11;
+    BS_T t23 = t21 ^ (a3 & t22);
+    BS_T t24 = ~a5 | t6;
+    BS_T t25 = t24 ^ (a2 & t6);
+    BS_T t26 = t12 ^ t25;
+    BS_T t27 = t12 ^ (a3 & t26);
+    BS_T t28 = t23 ^ t27;
+    BS_T t29 = t23 ^ (a4 & t28);
+    BS_T t30 = a2 ^ t6;
+    BS_T t31 = t30 ^ (a3 & t0);
+    BS_T t32 = t0 ^ (a2 & t6);
+    BS_T t33 = t32 ^ (a3 & t2);
+    BS_T t34 = t31 ^ t33;
+    BS_T t35 = t31 ^ (a4 & t34);
+    BS_T t36 = t29 ^ t35;
+    BS_T t37 = t29 ^ (a1 & t36);
+    BS_T t38 = t10 ^ (a2 & t2);
+    BS_T t39 = t24 ^ (a2 & t20);
+    BS_T t40 = t38 ^ t39;
+    BS_T t41 = t38 ^ (a3 & t40);
+    BS_T t42 = ~t24;
+    BS_T t43 = t8 ^ (a2 & t42);
+    BS_T t44 = a3 ^ t43;
+    BS_T t45 = t41 ^ t44;
+    BS_T t46 = t41 ^ (a4 & t45);
+    BS_T t47 = ~t32;
+    BS_T t48 = ~t10;
+    BS_T t49 = t47 ^ t48;
+    BS_T t50 = t47 ^ (a3 & t49);
+    BS_T t51 = t10 ^ (a2 & t20);
+    BS_T t52 = t3 ^ t51;
+    BS_T t53 = t3 ^ (a3 & t52);
+    BS_T t54 = t50 ^ t53;
+    BS_T t55 = t50 ^ (a4 & t54);
+    BS_T t56 = t46 ^ t55;
+    BS_T t57 = t46 ^ (a1 & t56);
+    BS_T t58 = ~t30;
+    BS_T t59 = t58 ^ (a3 & a5);
+    BS_T t60 = t59 ^ (a4 & t0);
+    BS_T t61 = a5 ^ (a2 & t24);
+    BS_T t62 = t26 ^ t61;
+    BS_T t63 = t26 ^ (a3 & t62);
+    BS_T t64 = ~t51;
+    BS_T t65 = t10 ^ (a2 & t7);
+    BS_T t66 = t64 ^ t65;
+    BS_T t67 = t64 ^ (a3 & t66);
+    BS_T t68 = t63 ^ t67;
+    BS_T t69 = t63 ^ (a4 & t68);
+    BS_T t70 = t60 ^ t69;
+    BS_T t71 = t60 ^ (a1 & t70);
+    *o1 = t19;
+    *o2 = t37;
+    *o3 = t57;
+    *o4 = t71;
+}
+
+// S4：72 个逻辑运算
+BS_INLINE void BS_FN(s4)(BS_T a1, BS_T a2, BS_T a3, BS_T a4, BS_T a5, BS_T a6,
+                          BS_T *o1, BS_T *o2, BS_T *o3, BS_T *o4) {
+    BS_T t0 = ~a3;
+    BS_T t1 = a4 ^ (a5 & t0);
+    BS_T t2 = a3 ^ a4;
+    BS_T t3 = t2 ^ (a5 & a4);
+    BS_T t4 = t1 ^ t3;
+    BS_T t5 = t1 ^ (a2 & t4);
+    BS_T t6 = ~a4;
+    BS_T t7 = ~a3 | t6;
+    BS_T t8 = t7 ^ a3;
+    BS_T t9 = t7 ^ (a5 & t8);
+    BS_T t10 = ~t2;
+    BS_T t11 = t10 ^ (a5 & t8);
+    BS_T t12 = t9 ^ t11;
+    BS_T t13 = t9 ^ (a2 & t12);
+    BS_T t14 = t5 ^ t13;
+    BS_T t15 = t5 ^ (a1 & t14);
+    BS_T t16 = t0 ^ (a5 & t2);
+    BS_T t17 = t16 ^ (a2 & t8);
+    BS_T t18 = a3 ^ (a5 & t6);
+    BS_T t19 = ~t3;
+    BS_T t20 = t18 ^ (a2 & t19);
+    BS_T t21 = t17 ^ t20;
+    BS_T t22 = t17 ^ (a1 & t21);
+    BS_T t23 = t15 ^ t22;
+    BS_T t24 = t15 ^ (a6 & t23);
+    BS_T t25 = ~t23;
+    BS_T t26 = t22 ^ (a6 & t25);
+    BS_T t27 = t0 ^ t12;
+    BS_T t28 = t0 ^ (a5 & t27);
+    BS_T t29 = t28 ^ (a2 & t7);
+    BS_T t30 = t10 ^ (a5 & a3);
+    BS_T t31 = ~t18;
+    BS_T t32 = t30 ^ t31;
+    BS_T t33 = t30 ^ (a2 & t32);
+    BS_T t34 = t29 ^ t33;
+    BS_T t35 = t29 ^ (a1 & t34);
+    BS_T t36 = t3 ^ (a2 & t18);
+    BS_T t37 = t6 ^ (a5 & t2);
+    BS_T t38 = t37 ^ (a2 & t27);
+    BS_T t39 = t36 ^ t38;
+    BS_T t40 = t36 ^ (a1 & t39);
+    BS_T t41 = t35 ^ t40;
+    BS_T t42 = t35 ^ (a6 & t41);
+    BS_T t43 = ~t40;
+    BS_T t44 = ~t41;
+    BS_T t45 = t43 ^ (a6 & t44);
+    *o1 = t24;
+    *o2 = t26;
+    *o3 = t42;
+    *o4 = t45;
+}
+
+// S5：116 个逻辑运算
+BS_INLINE void BS_FN(s5)(BS_T a1, BS_T a2, BS_T a3, BS_T a4, BS_T a5, BS_T a6,
+                          BS_T *o1, BS_T *o2, BS_T *o3, BS_T *o4) {
+    BS_T t0 = a2 ^ a5;
+    BS_T t1 = t0 ^ (a1 & a5);
+    BS_T t2 = t1 ^ (a3 & a1);
+    BS_T t3 = ~a2;
+    BS_T t4 = ~a2 | a5;
+    BS_T t5 = t3 ^ t4;
+    BS_T t6 = t3 ^ (a1 & t5);
+    BS_T t7 = t5 ^ t0;
+    BS_T t8 = t5 ^ (a1 & t7);
+    BS_T t9 = t6 ^ t8;
+    BS_T t10 = t6 ^ (a3 & t9);
+    BS_T t11 = t2 ^ t10;
+    BS_T t12 = t2 ^ (a6 & t11);
+    BS_T t13 = ~a5;
+    BS_T t14 = a2 | t13;
+    BS_T t15 = ~t5;
+    BS_T t16 = t14 ^ (a1 & t15);
+    BS_T t17 = t8 ^ t16;
+    BS_T t18 = t8 ^ (a3 & t17);
+    BS_T t19 = t7 ^ (a1 & t15);
+    BS_T t20 = t19 ^ (a3 & t4);
+    BS_T t21 = t18 ^ t20;
+    BS_T t22 = t18 ^ (a6 & t21);
+    BS_T t23 = t12 ^ t22;
+    BS_T t24 = t12 ^ (a4 & t23);
+    BS_T t25 = a1 ^ a5;
+    BS_T t26 = t13 ^ (a1 & t3);
+    BS_T t27 = t25 ^ t26;
+    BS_T t28 = t25 ^ (a3 & t27);
+    BS_T t29 = t17 ^ (a3 & t0);
+    BS_T t30 = t28 ^ t29;
+    BS_T t31 = t28 ^ (a6 & t30);
+    BS_T t32 = ~t0;
+    BS_T t33 = t32 ^ (a1 & t13);
+    BS_T t34 = a1 ^ t0;
+    BS_T t35 = t33 ^ t34;
+    BS_T t36 = t33 ^ (a3 & t35);
+    BS_T t37 = a6 ^ t36;
+    BS_T t38 = t31 ^ t37;
+    BS_T t39 = t31 ^ (a4 & t38);
+    BS_T t40 = ~t19;
+    BS_T t41 = t3 ^ (a1 & t7);
+    BS_T t42 = t40 ^ t41;
+    BS_T t43 = t40 ^ (a3 & t42);
+    BS_T t44 = t41 ^ t0;
+    BS_T t45 = t41 ^ (a3 & t44);
+    BS_T t46 = t43 ^ t45;
+    BS_T t47 = t43 ^ (a6 & t46);
+    BS_T t48 = ~t41;
+    BS_T t49 = t48 ^ (a3 & t4);
+    BS_T t50 = a1 ^ t14;
+    BS_T t51 = t50 ^ (a3 & t44);
+    BS_T t52 = t49 ^ t51;
+    BS_T t53 = t49 ^ (a6 & t52);
+    BS_T t54 = t47 ^ t53;
+    BS_T t55 = t47 ^ (a4 & t54);
+    BS_T t56 = ~t4;
+    BS_T t57 = t5 ^ (a1 & t56);
+    BS_T t58 = ~t25;
+    BS_T t59 = t57 ^ t58;
+    BS_T t60 = t57 ^ (a3 & t59);
+    BS_T t61 = t34 ^ (a3 & t5);
+    BS_T t62 = t60 ^ t61;
+    BS_T t63 = t60 ^ (a6 & t62);
+    BS_T t64 = t7 ^ (a1 & t13);
+    BS_T t65 = t32 ^ (a1 & t5);
+    BS_T t66 = t64 ^ t65;
+    BS_T t67 = t64 ^ (a3 & t66);
+    BS_T t68 = t56 ^ (a1 & t7);
+    BS_T t69 = t3 ^ (a1 & t14);
+    BS_T t70 = t68 ^ t69;
+    BS_T t71 = t68 ^ (a3 & t70);
+    BS_T t72 = t67 ^ t71;
+    BS_T t73 = t67 ^ (a6 & t72);
+    BS_T t74 = t63 ^ t73;
+    BS_T t75 = t63 ^ (a4 & t74);
+    *o1 = t24;
+    *o2 = t39;
+    *o3 = t55;
+    *o4 = t75;
+}
+
+// S6：108 个逻辑运算
+BS_INLINE void BS_FN(s6)(BS_T a1, BS_T a2, BS_T a3, BS_T a4, BS_T a5, BS_T a6,
+                          BS_T *o1, BS_T *o2, BS_T *o3, BS_T *o4) {
+    BS_T t0 = ~a5;
+    BS_T t1 = a2 ^ t0;
+    BS_T t2 = t1 ^ (a3 & a2);
+    BS_T t3 = ~a2;
+    BS_T t4 = t3 ^ (a3 & t1);
+    BS_T t5 = t2 ^ t4;
+    BS_T t6 = t2 ^ (a4 & t5);
+    BS_T t7 = t6 ^ (a1 & t5);
+    BS_T t8 = a2 ^ (a3 & t0);
+    BS_T t9 = t4 ^ t8;
+    BS_T t10 = t4 ^ (a4 & t9);
+    BS_T t11 = ~a2 & t0;
+    BS_T t12 = a2 ^ t11;
+    BS_T t13 = a2 ^ (a3 & t12);
+    BS_T t14 = ~t11;
+    BS_T t15 = t13 ^ (a4 & t14);
+    BS_T t16 = t10 ^ t15;
+    BS_T t17 = t10 ^ (a1 & t16);
+    BS_T t18 = t7 ^ t17;
+    BS_T t19 = t7 ^ (a6 & t18);
+    BS_T t20 = t1 ^ (a3 & t0);
+    BS_T t21 = a3 ^ a5;
+    BS_T t22 = t20 ^ t21;
+    BS_T t23 = t20 ^ (a4 & t22);
+    BS_T t24 = ~t1;
+    BS_T t25 = t24 ^ (a3 & t14);
+    BS_T t26 = t25 ^ (a4 & t11);
+    BS_T t27 = t23 ^ t26;
+    BS_T t28 = t23 ^ (a1 & t27);
+    BS_T t29 = ~t20;
+    BS_T t30 = a3 ^ t12;
+    BS_T t31 = t29 ^ t30;
+    BS_T t32 = t29 ^ (a4 & t31);
+    BS_T t33 = a3 ^ t1;
+    BS_T t34 = a5 ^ (a3 & t3);
+    BS_T t35 = t33 ^ t34;
+    BS_T t36 = t33 ^ (a4 & t35);
+    BS_T t37 = t32 ^ t36;
+    BS_T t38 = t32 ^ (a1 & t37);
+    BS_T t39 = t28 ^ t38;
+    BS_T t40 = t28 ^ (a6 & t39);
+    BS_T t41 = a3 & t14;
+    BS_T t42 = ~a2 | t0;
+    BS_T t43 = t42 ^ (a3 & t14);
+    BS_T t44 = t41 ^ t43;
+    BS_T t45 = t41 ^ (a4 & t44);
+    BS_T t46 = t24 ^ (a3 & t44);
+    BS_T t47 = a4 ^ t46;
+    BS_T t48 = t45 ^ t47;
+    BS_T t49 = t45 ^ (a1 & t48);
+    BS_T t50 = t43 ^ (a4 & t12);
+    BS_T t51 = t14 ^ (a3 & a5);
+    BS_T t52 = t51 ^ (a4 & t44);
+    BS_T t53 = t50 ^ t52;
+    BS_T t54 = t50 ^ (a1 & t53);
+    BS_T t55 = t49 ^ t54;
+    BS_T t56 = t49 ^ (a6 & t55);
+    BS_T t57 = ~t4;
+    BS_T t58 = t34 ^ (a4 & t57);
+    BS_T t59 = t0 ^ (a3 & t1);
+    BS_T t60 = ~t2;
+    BS_T t61 = t59 ^ (a4 & t60);
+    BS_T t62 = t58 ^ t61;
+    BS_T t63 = t58 ^ (a1 & t62);
+    BS_T t64 = t34 ^ (a4 & t14);
+    BS_T t65 = t29 ^ (a4 & a5);
+    BS_T t66 = t64 ^ t65;
+    BS_T t67 = t64 ^ (a1 & t66);
+    BS_T t68 = t63 ^ t67;
+    BS_T t69 = t63 ^ (a6 & t68);
+    *o1 = t19;
+    *o2 = t40;
+    *o3 = t56;
+    *o4 = t69;
+}
+
+// S7：103 个逻辑运算
+BS_INLINE void BS_FN(s7)(BS_T a1, BS_T a2, BS_T a3, BS_T a4, BS_T a5, BS_T a6,
+                          BS_T *o1, BS_T *o2, BS_T *o3, BS_T *o4) {
+    BS_T t0 = a5 ^ (a4 & a2);
+    BS_T t1 = ~a2;
+    BS_T t2 = a5 ^ t1;
+    BS_T t3 = t2 ^ (a4 & a5);
+    BS_T t4 = t0 ^ t3;
+    BS_T t5 = t0 ^ (a3 & t4);
+    BS_T t6 = a5 | t1;
+    BS_T t7 = a2 ^ t6;
+    BS_T t8 = a2 ^ (a4 & t7);
+    BS_T t9 = ~a5 & t1;
+    BS_T t10 = t9 ^ (a4 & t7);
+    BS_T t11 = t8 ^ t10;
+    BS_T t12 = t8 ^ (a3 & t11);
+    BS_T t13 = t5 ^ t12;
+    BS_T t14 = t5 ^ (a1 & t13);
+    BS_T t15 = ~t0;
+    BS_T t16 = a3 ^ t15;
+    BS_T t17 = ~t2;
+    BS_T t18 = t17 ^ (a4 & t11);
+    BS_T t19 = ~t11;
+    BS_T t20 = t18 ^ (a3 & t19);
+    BS_T t21 = t16 ^ t20;
+    BS_T t22 = t16 ^ (a1 & t21);
+    BS_T t23 = t14 ^ t22;
+    BS_T t24 = t14 ^ (a6 & t23);
+    BS_T t25 = t2 ^ (a4 & t1);
+    BS_T t26 = t25 ^ (a3 & a2);
+    BS_T t27 = t26 ^ t5;
+    BS_T t28 = t26 ^ (a1 & t27);
+    BS_T t29 = ~a5;
+    BS_T t30 = t29 ^ (a4 & t6);
+    BS_T t31 = t2 ^ (a4 & t9);
+    BS_T t32 = t30 ^ t31;
+    BS_T t33 = t30 ^ (a3 & t32);
+    BS_T t34 = t17 ^ (a4 & a2);
+    BS_T t35 = t2 ^ t34;
+    BS_T t36 = t2 ^ (a3 & t35);
+    BS_T t37 = t33 ^ t36;
+    BS_T t38 = t33 ^ (a1 & t37);
+    BS_T t39 = t28 ^ t38;
+    BS_T t40 = t28 ^ (a6 & t39);
+    BS_T t41 = a3 ^ t18;
+    BS_T t42 = a2 ^ (a4 & t2);
+    BS_T t43 = ~t9;
+    BS_T t44 = t42 ^ (a3 & t43);
+    BS_T t45 = t41 ^ t44;
+    BS_T t46 = t41 ^ (a1 & t45);
+    BS_T t47 = a4 ^ a2;
+    BS_T t48 = ~t4;
+    BS_T t49 = t47 ^ t48;
+    BS_T t50 = t47 ^ (a3 & t49);
+    BS_T t51 = t1 ^ (a4 & t6);
+    BS_T t52 = a3 ^ t51;
+    BS_T t53 = t50 ^ t52;
+    BS_T t54 = t50 ^ (a1 & t53);
+    BS_T t55 = t46 ^ t54;
+    BS_T t56 = t46 ^ (a6 & t55);
+    BS_T t57 = ~t3;
+    BS_T t58 = a4 ^ t29;
+    BS_T t59 = t57 ^ t58;
+    BS_T t60 = t57 ^ (a3 & t59);
+    BS_T t61 = a1 ^ t60;
+    BS_T t62 = t2 ^ (a4 & t43);
+    BS_T t63 = t62 ^ (a3 & t59);
+    BS_T t64 = ~t10;
+    BS_T t65 = a3 ^ t64;
+    BS_T t66 = t63 ^ t65;
+    BS_T t67 = t63 ^ (a1 & t66);
+    BS_T t68 = t61 ^ t67;
+    BS_T t69 = t61 ^ (a6 & t68);
+    *o1 = t24;
+    *o2 = t40;
+    *o3 = t56;
+    *o4 = t69;
+}
+
+// S8：95 个逻辑运算
+BS_INLINE void BS_FN(s8)(BS_T a1, BS_T a2, BS_T a3, BS_T a4, BS_T a5, BS_T a6,
+                          BS_T *o1, BS_T *o2, BS_T *o3, BS_T *o4) {
+    BS_T t0 = ~a5;
+    BS_T t1 = a2 | t0;
+    BS_T t2 = a2 ^ t0;
+    BS_T t3 = t1 ^ t2;
+    BS_T t4 = t1 ^ (a4 & t3);
+    BS_T t5 = ~t1;
+    BS_T t6 = t5 ^ t0;
+    BS_T t7 = t5 ^ (a4 & t6);
+    BS_T t8 = t4 ^ t7;
+    BS_T t9 = t4 ^ (a3 & t8);
+    BS_T t10 = t5 ^ a2;
+    BS_T t11 = t5 ^ (a4 & t10);
+    BS_T t12 = t11 ^ (a3 & t0);
+    BS_T t13 = t9 ^ t12;
+    BS_T t14 = t9 ^ (a1 & t13);
+    BS_T t15 = ~t2;
+    BS_T t16 = t15 ^ (a4 & t1);
+    BS_T t17 = a3 ^ t16;
+    BS_T t18 = a2 ^ (a4 & t2);
+    BS_T t19 = t18 ^ (a3 & t10);
+    BS_T t20 = t17 ^ t19;
+    BS_T t21 = t17 ^ (a1 & t20);
+    BS_T t22 = t14 ^ t21;
+    BS_T t23 = t14 ^ (a6 & t22);
+    BS_T t24 = ~t10;
+    BS_T t25 = ~t3;
+    BS_T t26 = t24 ^ (a4 & t25);
+    BS_T t27 = t26 ^ (a3 & t15);
+    BS_T t28 = t2 ^ (a3 & t8);
+    BS_T t29 = t27 ^ t28;
+    BS_T t30 = t27 ^ (a1 & t29);
+    BS_T t31 = ~t27;
+    BS_T t32 = a4 ^ a2;
+    BS_T t33 = t32 ^ (a3 & t0);
+    BS_T t34 = t31 ^ t33;
+    BS_T t35 = t31 ^ (a1 & t34);
+    BS_T t36 = t30 ^ t35;
+    BS_T t37 = t30 ^ (a6 & t36);
+    BS_T t38 = t15 ^ (a4 & a5);
+    BS_T t39 = t38 ^ (a3 & t0);
+    BS_T t40 = a4 ^ t25;
+    BS_T t41 = t40 ^ (a3 & t6);
+    BS_T t42 = t39 ^ t41;
+    BS_T t43 = t39 ^ (a1 & t42);
+    BS_T t44 = t25 ^ (a4 & t5);
+    BS_T t45 = t11 ^ t44;
+    BS_T t46 = t11 ^ (a3 & t45);
+    BS_T t47 = t0 ^ (a4 & t15);
+    BS_T t48 = t47 ^ t38;
+    BS_T t49 = t47 ^ (a3 & t48);
+    BS_T t50 = t46 ^ t49;
+    BS_T t51 = t46 ^ (a1 & t50);
+    BS_T t52 = t43 ^ t51;
+    BS_T t53 = t43 ^ (a6 & t52);
+    BS_T t54 = ~t21;
+    BS_T t55 = t44 ^ t7;
+    BS_T t56 = t44 ^ (a3 & t55);
+    BS_T t57 = ~t47;
+    BS_T t58 = t15 ^ (a3 & t57);
+    BS_T t59 = t56 ^ t58;
+    BS_T t60 = t56 ^ (a1 & t59);
+    BS_T t61 = t54 ^ t60;
+    BS_T t62 = t54 ^ (a6 & t61);
+    *o1 = t23;
+    *o2 = t37;
+    *o3 = t53;
+    *o4 = t62;
+}
+
+// 一个S盒：输入为 E(R) 的第 j..j+5 位与子密钥异或，4位输出写到 so[4(n-1)..4(n-1)+3]
+#define BS_SBOX(n, j) BS_FN(s##n)(r[bs_e[(j)]] ^ *kr[(j)], r[bs_e[(j) + 1]] ^ *kr[(j) + 1], \
+                                  r[bs_e[(j) + 2]] ^ *kr[(j) + 2], r[bs_e[(j) + 3]] ^ *kr[(j) + 3], \
+                                  r[bs_e[(j) + 4]] ^ *kr[(j) + 4], r[bs_e[(j) + 5]] ^ *kr[(j) + 5], \
+                                  &so[4 * ((n) - 1)], &so[4 * ((n) - 1) + 1], \
+                                  &so[4 * ((n) - 1) + 2], &so[4 * ((n) - 1) + 3])
+
+// 16轮 DES：s[j] 为所有分组第 j 位 (DES 位序，0为最高位) 组成的切片，原地变换为输出分组
+// k[i][j] 指向第 i 轮实际使用的子密钥第 j 位的切片，解密时由调用方逆序排列
+// IP、E、P 和 IP^-1 都只是切片的重新编号，不产生任何运算
+static BS_TARGET void BS_FN(des_bs_crypt)(BS_T s[64], const BS_T *const k[16][48]) {
+    BS_T lr[2][32], so[32];
+    BS_T *l = lr[0], *r = lr[1], *t;
+
+    for (int i = 0; i < 32; i++) {
+        l[i] = s[bs_ip[i]];
+        r[i] = s[bs_ip[32 + i]];
+    }
+
+    for (int round = 0; round < 16; round++) {
+        const BS_T *const *kr = k[round];
+
+        BS_SBOX(1, 0);
+        BS_SBOX(2, 6);
+        BS_SBOX(3, 12);
+        BS_SBOX(4, 18);
+        BS_SBOX(5, 24);
+        BS_SBOX(6, 30);
+        BS_SBOX(7, 36);
+        BS_SBOX(8, 42);
+
+        // L ^= P(S(...))，然后交换左右两半
+        for (int i = 0; i < 32; i++) {
+            l[i] ^= so[bs_p[i]];
+        }
+        t = l;
+        l = r;
+        r = t;
+    }
+
+    // 最后一轮不交换：输出前的分组为 R16 || L16
+    for (int j = 0; j < 64; j++) {
+        s[j] = bs_fp[j] < 32 ? r[bs_fp[j]] : l[bs_fp[j] - 32];
+    }
+}
+
+// 加密/解密 nblocks 个分组，每批 sizeof(BS_T) * 8 个，最后一批不足时补零计算
+// kbits[i][j] 为第 i 轮子密钥第 j 位 (0或1)，已按使用顺序排列
+static BS_TARGET void BS_FN(des_bs_blocks)(const uint8_t kbits[16][48], const unsigned char *in,
+                                           unsigned char *out, size_t nblocks) {
+    enum { GROUPS = sizeof(BS_T) / 8, LANES = sizeof(BS_T) * 8 };
+    uint64_t rows[64 * GROUPS];
+    BS_T kc[2], s[64];
+    const BS_T *k[16][48];
+
+    memset(&kc[0], 0, sizeof(BS_T));
+    memset(&kc[1], 0xFF, sizeof(BS_T));
+    for (int i = 0; i < 16; i++) {
+        for (int j = 0; j < 48; j++) {
+            k[i][j] = &kc[kbits[i][j]];
+        }
+    }
+
+    while (nblocks > 0) {
+        size_t n = nblocks < LANES ? nblocks : LANES;
+
+        bs_load(in, n, rows, GROUPS);
+        memcpy(s, rows, sizeof(s));
+        BS_FN(des_bs_crypt)(s, k);
+        memcpy(rows, s, sizeof(s));
+        bs_store(rows, out, n, GROUPS);
+
+        in += n * 8;
+        out += n * 8;
+        nblocks -= n;
+    }
+    // k 中各指针指向 kc[0] 还是 kc[1] 就是子密钥的各位，与分组一起清除
+    secure_wipe(s, sizeof(s));
+    secure_wipe(rows, sizeof(rows));
+    secure_wipe(k, sizeof(k));
+}
+
+// 已知明文密钥搜索：第 b 个分组 (按字内从低位起编号) 使用密钥序号 base + b，base 为 LANES 的整数倍，
+// 所有分组加密同一个明文，因此不需要转置。keymap[i][j] 为第 i 轮子密钥第 j 位对应的密钥位 (0~63)
+// 在 [first, first + count) 中找到返回1并写入 *index
+static BS_TARGET int BS_FN(des_bs_search)(const uint8_t keymap[16][48], const unsigned char plaintext[8],
+                                          const unsigned char ciphertext[8], uint64_t first, uint64_t count,
+                                          uint64_t *index) {
+    enum { GROUPS = sizeof(BS_T) / 8, LANES = sizeof(BS_T) * 8 };
+    BS_T kc[2], p[64], c[64], s[64], key[64], pattern[8];
+    const BS_T *k[16][48];
+    uint64_t words[GROUPS];
+    uint64_t end = first + count;
+    int low_bits = 0, found = 0;
+
+    memset(&kc[0], 0, sizeof(BS_T));
+    memset(&kc[1], 0xFF, sizeof(BS_T));
+    memset(key, 0, sizeof(key));
+    for (int j = 0; j < 64; j++) {
+        p[j] = kc[(plaintext[j / 8] >> (7 - j % 8)) & 1];
+        c[j] = kc[(ciphertext[j / 8] >> (7 - j % 8)) & 1];
+    }
+    for (int i = 0; i < 16; i++) {
+        for (int j = 0; j < 48; j++) {
+            k[i][j] = &key[keymap[i][j]];
+        }
+    }
+
+    // 序号的低 log2(LANES) 位在一批内逐分组变化，是固定的位模式；更高的位在一批内为常数
+    while ((1 << low_bits) < LANES) {
+        for (int g = 0; g < GROUPS; g++) {
+            uint64_t w = 0;
+            for (int b = 0; b < 64; b++) {
+                w |= (uint64_t) (((g * 64 + b) >> low_bits) & 1) << b;
+            }
+            words[g] = w;
+        }
+        memcpy(&pattern[low_bits], words, sizeof(BS_T));
+        low_bits++;
+    }
+
+    for (uint64_t base = first - first % LANES; base < end && !found; base += LANES) {
+        BS_T diff;
+
+        for (int t = 0; t < 56; t++) {
+            key[bs_index_bit[t]] = t < low_bits ? pattern[t] : kc[(base >> t) & 1];
+        }
+        memcpy(s, p, sizeof(s));
+        BS_FN(des_bs_crypt)(s, k);
+
+        // 与密文逐位比较，全部相同的分组即为命中
+        diff = s[0] ^ c[0];
+        for (int j = 1; j < 64; j++) {
+            diff |= s[j] ^ c[j];
+        }
+        memcpy(words, &diff, sizeof(words));
+        for (int g = 0; g < GROUPS && !found; g++) {
+            uint64_t hits = ~words[g];
+            while (hits != 0) {
+                uint64_t candidate = base + (uint64_t) g * 64 + (uint64_t) __builtin_ctzll(hits);
+                if (candidate >= first && candidate < end) {
+                    *index = candidate;
+                    found = 1;
+                    break;
+                }
+                hits &= hits - 1;
+            }
+        }
+    }
+    secure_wipe(key, sizeof(key));
+    secure_wipe(s, sizeof(s));
+    return found;
+}
+
+#undef BS_SBOX
+#undef BS_INLINE
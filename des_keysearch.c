@@ -0,0 +1,282 @@
+//
+// DES 已知明文密钥搜索
+//
+// 范围被切成 DES_KEYSEARCH_CHUNK 大小的块，按顺序分配给空闲线程。
+// 检查点只记录"之前的块全部完成"的位置：即正在处理的块中编号最小的那个，
+// 恢复时最多重复检验每个线程手头的一块，但不会漏掉任何密钥。
+//
+
+#include "des_keysearch.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "des_bitslice.h"
+#include "parallel.h"
+
+#define CHUNK_IDLE UINT64_MAX
+
+// 所有线程共享的搜索状态，除参数外都由 lock 保护
+typedef struct {
+    const des_keysearch_params *params;
+    uint64_t first;             // 本次运行的起始序号 (已跳过检查点中完成的部分)
+    uint64_t count;             // 本次运行需要检验的密钥数
+    uint64_t resumed;           // 检查点中已完成的密钥数
+    uint64_t next_chunk;        // 下一个待分配的块
+    uint64_t nchunks;
+    uint64_t *current;          // 各线程正在处理的块，CHUNK_IDLE 表示空闲
+    unsigned int nthreads;
+    uint64_t tested;
+    int found;
+    uint64_t index;
+    int error;
+    double start;
+    double last_report;
+    pthread_mutex_t lock;
+} keysearch_state;
+
+static double now_seconds(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double) ts.tv_sec + (double) ts.tv_nsec / 1e9;
+}
+
+static void print_block(FILE *f, const char *name, const DES_cblock block) {
+    fprintf(f, "%s ", name);
+    for (int i = 0; i < 8; i++) {
+        fprintf(f, "%02x", block[i]);
+    }
+    fprintf(f, "\n");
+}
+
+static int scan_block(FILE *f, const char *name, DES_cblock block) {
+    char label[32];
+    unsigned int b[8];
+
+    if (fscanf(f, "%31s %2x%2x%2x%2x%2x%2x%2x%2x", label, &b[0], &b[1], &b[2], &b[3], &b[4], &b[5], &b[6],
+               &b[7]) != 9 || strcmp(label, name) != 0) {
+        return -1;
+    }
+    for (int i = 0; i < 8; i++) {
+        block[i] = (unsigned char) b[i];
+    }
+    return 0;
+}
+
+static int scan_u64(FILE *f, const char *name, uint64_t *value) {
+    char label[32];
+    unsigned long long v;
+
+    if (fscanf(f, "%31s %llx", label, &v) != 2 || strcmp(label, name) != 0) {
+        return -1;
+    }
+    *value = (uint64_t) v;
+    return 0;
+}
+
+// 读取检查点：文件不存在时 *done 为0；内容与参数不符或格式错误返回-1
+static int load_checkpoint(const des_keysearch_params *params, uint64_t count, uint64_t *done, int *found,
+                           uint64_t *index) {
+    FILE *f = fopen(params->checkpoint, "r");
+    DES_cblock pt, ct;
+    uint64_t first, total, has_found;
+    char magic[32];
+    int ok;
+
+    *done = 0;
+    *found = 0;
+    if (!f) {
+        return 0;
+    }
+    ok = fscanf(f, "%31s", magic) == 1 && strcmp(magic, "des-keysearch-v1") == 0 &&
+         scan_block(f, "plaintext", pt) == 0 && scan_block(f, "ciphertext", ct) == 0 &&
+         scan_u64(f, "first", &first) == 0 && scan_u64(f, "count", &total) == 0 &&
+         scan_u64(f, "done", done) == 0 && scan_u64(f, "found", &has_found) == 0 &&
+         scan_u64(f, "index", index) == 0;
+    fclose(f);
+
+    if (!ok || memcmp(pt, params->plaintext, 8) != 0 || memcmp(ct, params->ciphertext, 8) != 0 ||
+        first != params->first || total != count || *done > count) {
+        return -1;
+    }
+    *found = has_found != 0;
+    return 0;
+}
+
+// 先写临时文件再改名，中途崩溃也不会留下半个检查点
+static int save_checkpoint(const des_keysearch_params *params, uint64_t count, uint64_t done, int found,
+                           uint64_t index) {
+    size_t len = strlen(params->checkpoint);
+    char *tmp = (char *) malloc(len + 5);
+    FILE *f;
+    int ok;
+
+    if (!tmp) {
+        return -1;
+    }
+    memcpy(tmp, params->checkpoint, len);
+    memcpy(tmp + len, ".tmp", 5);
+
+    f = fopen(tmp, "w");
+    if (!f) {
+        free(tmp);
+        return -1;
+    }
+    fprintf(f, "des-keysearch-v1\n");
+    print_block(f, "plaintext", params->plaintext);
+    print_block(f, "ciphertext", params->ciphertext);
+    fprintf(f, "first %014llx\ncount %llx\ndone %llx\nfound %d\nindex %014llx\n", (unsigned long long) params->first,
+            (unsigned long long) count, (unsigned long long) done, found, (unsigned long long) index);
+    ok = fclose(f) == 0 && rename(tmp, params->checkpoint) == 0;
+    free(tmp);
+    return ok ? 0 : -1;
+}
+
+// 已确认完成的密钥数：编号小于所有在处理块和待分配块的块都已完成 (调用时持有锁)
+static uint64_t completed(const keysearch_state *st) {
+    uint64_t low = st->next_chunk;
+
+    for (unsigned int i = 0; i < st->nthreads; i++) {
+        if (st->current[i] < low) {
+            low = st->current[i];
+        }
+    }
+    if (low >= st->nchunks) {
+        return st->count;
+    }
+    return low * DES_KEYSEARCH_CHUNK;
+}
+
+// 写检查点并回报进度 (调用时持有锁)
+static void report(keysearch_state *st, double now) {
+    const des_keysearch_params *params = st->params;
+    uint64_t done = completed(st);
+
+    if (params->checkpoint &&
+        save_checkpoint(params, st->resumed + st->count, st->resumed + done, st->found, st->index) != 0) {
+        st->error = 1;
+    }
+    if (params->progress) {
+        des_keysearch_progress progress;
+
+        progress.done = st->resumed + done;
+        progress.total = st->resumed + st->count;
+        progress.seconds = now - st->start;
+        progress.keys_per_sec = progress.seconds > 0 ? (double) st->tested / progress.seconds : 0;
+        params->progress(&progress, params->user);
+    }
+    st->last_report = now;
+}
+
+static void keysearch_worker(void *arg, unsigned int index, unsigned int count) {
+    keysearch_state *st = (keysearch_state *) arg;
+    (void) count;
+
+    pthread_mutex_lock(&st->lock);
+    while (!st->found && !st->error && st->next_chunk < st->nchunks) {
+        uint64_t chunk = st->next_chunk++;
+        uint64_t first = st->first + chunk * DES_KEYSEARCH_CHUNK;
+        uint64_t n = st->count - chunk * DES_KEYSEARCH_CHUNK;
+        uint64_t hit;
+        int found;
+        double now;
+
+        if (n > DES_KEYSEARCH_CHUNK) {
+            n = DES_KEYSEARCH_CHUNK;
+        }
+        st->current[index] = chunk;
+        pthread_mutex_unlock(&st->lock);
+
+        found = DES_bs_search_keys(&st->params->plaintext, &st->params->ciphertext, first, n, &hit);
+
+        pthread_mutex_lock(&st->lock);
+        st->current[index] = CHUNK_IDLE;
+        st->tested += n;
+        if (found && (!st->found || hit < st->index)) {
+            st->found = 1;
+            st->index = hit;
+        }
+        now = now_seconds();
+        if (now - st->last_report >= st->params->interval) {
+            report(st, now);
+        }
+    }
+    st->current[index] = CHUNK_IDLE;
+    pthread_mutex_unlock(&st->lock);
+}
+
+void des_keysearch_init(des_keysearch_params *params, const DES_cblock *plaintext, const DES_cblock *ciphertext,
+                        uint64_t first, uint64_t count) {
+    memset(params, 0, sizeof(*params));
+    memcpy(params->plaintext, *plaintext, 8);
+    memcpy(params->ciphertext, *ciphertext, 8);
+    params->first = first;
+    params->count = count;
+    params->interval = DES_KEYSEARCH_DEFAULT_INTERVAL;
+}
+
+int des_keysearch_run(const des_keysearch_params *params, des_keysearch_result *result) {
+    keysearch_state st;
+    uint64_t count = params->count, done = 0;
+    double now;
+
+    memset(result, 0, sizeof(*result));
+    if (params->first >= DES_BS_KEYSPACE) {
+        count = 0;
+    } else if (count > DES_BS_KEYSPACE - params->first) {
+        count = DES_BS_KEYSPACE - params->first;
+    }
+
+    memset(&st, 0, sizeof(st));
+    st.params = params;
+    if (params->checkpoint && load_checkpoint(params, count, &done, &st.found, &st.index) != 0) {
+        return -1;
+    }
+    st.resumed = done;
+    st.first = params->first + done;
+    st.count = count - done;
+    st.nchunks = (st.count + DES_KEYSEARCH_CHUNK - 1) / DES_KEYSEARCH_CHUNK;
+    st.nthreads = params->nthreads ? params->nthreads : parallel_default_threads();
+    if (st.nthreads > DES_KEYSEARCH_MAX_THREADS) {
+        st.nthreads = DES_KEYSEARCH_MAX_THREADS;
+    }
+    if (st.nchunks < st.nthreads) {
+        st.nthreads = st.nchunks ? (unsigned int) st.nchunks : 1;
+    }
+    st.current = (uint64_t *) malloc(st.nthreads * sizeof(uint64_t));
+    if (!st.current) {
+        return -1;
+    }
+    for (unsigned int i = 0; i < st.nthreads; i++) {
+        st.current[i] = CHUNK_IDLE;
+    }
+    pthread_mutex_init(&st.lock, NULL);
+    st.start = st.last_report = now_seconds();
+
+    // 检查点里已经有结果时不再搜索
+    if (!st.found) {
+        parallel_run(st.nthreads, keysearch_worker, &st);
+    }
+
+    now = now_seconds();
+    report(&st, now);
+    pthread_mutex_destroy(&st.lock);
+    free(st.current);
+
+    result->found = st.found;
+    result->index = st.index;
+    if (st.found) {
+        DES_bs_index_to_key(st.index, &result->key);
+    }
+    result->resumed = done;
+    result->tested = st.tested;
+    result->seconds = now - st.start;
+    result->keys_per_sec = result->seconds > 0 ? (double) st.tested / result->seconds : 0;
+    if (st.error) {
+        return -1;
+    }
+    return st.found;
+}
@@ -0,0 +1,65 @@
+//
+// DES 已知明文密钥搜索 - 用于内部密码审计和 CTF 训练，评估遗留 DES 密钥能否被穷举
+//
+// 给定一对已知的明文/密文分组和一段密钥序号范围 (见 DES_bs_index_to_key)，
+// 按块分给多个线程，每个线程用位切片内核一次检验 64~256 个候选密钥。
+// 可定期把进度写入检查点文件，中断后以相同参数再次运行即从检查点继续。
+//
+
+#ifndef DES_KEYSEARCH_H
+#define DES_KEYSEARCH_H
+
+#include <stdint.h>
+
+#include "des.h"
+
+// 每次分配给一个线程的密钥数
+#define DES_KEYSEARCH_CHUNK (1ULL << 22)
+
+// 最多使用的线程数
+#define DES_KEYSEARCH_MAX_THREADS 256
+
+// 默认的检查点/进度报告间隔 (秒)
+#define DES_KEYSEARCH_DEFAULT_INTERVAL 10.0
+
+// 进度报告
+typedef struct {
+    uint64_t done;              // 已完成的密钥数 (含从检查点恢复的部分)
+    uint64_t total;             // 范围内的密钥总数
+    double seconds;             // 本次运行已用时间
+    double keys_per_sec;        // 本次运行的平均速度
+} des_keysearch_progress;
+
+// 搜索参数，先用 des_keysearch_init 填入默认值
+typedef struct {
+    DES_cblock plaintext;       // 已知明文
+    DES_cblock ciphertext;      // 对应的密文
+    uint64_t first;             // 起始密钥序号
+    uint64_t count;             // 密钥个数，超出56位密钥空间的部分被截掉
+    unsigned int nthreads;      // 线程数，0 表示使用全部在线CPU
+    const char *checkpoint;     // 检查点文件路径，NULL 表示不保存也不恢复
+    double interval;            // 检查点/进度报告间隔 (秒)
+    void (*progress)(const des_keysearch_progress *progress, void *user);  // 进度回调，可为 NULL
+    void *user;                 // 传给进度回调的参数
+} des_keysearch_params;
+
+// 搜索结果
+typedef struct {
+    int found;                  // 是否找到
+    uint64_t index;             // 找到的密钥序号
+    DES_cblock key;             // 找到的密钥 (已补奇校验位)
+    uint64_t resumed;           // 从检查点恢复时跳过的密钥数
+    uint64_t tested;            // 本次运行实际检验的密钥数
+    double seconds;             // 本次运行用时
+    double keys_per_sec;        // 本次运行的平均速度
+} des_keysearch_result;
+
+// 用已知明文/密文和密钥序号范围初始化参数，其余字段取默认值
+void des_keysearch_init(des_keysearch_params *params, const DES_cblock *plaintext, const DES_cblock *ciphertext,
+                        uint64_t first, uint64_t count);
+
+// 执行搜索：找到返回1，搜完整个范围未找到返回0，检查点文件无法读写或与参数不符返回-1
+// 找到后其他线程在完成手头的块后停止
+int des_keysearch_run(const des_keysearch_params *params, des_keysearch_result *result);
+
+#endif //DES_KEYSEARCH_H
@@ -0,0 +1,172 @@
+//
+// 大文件哈希
+//
+
+#define _GNU_SOURCE
+#define _FILE_OFFSET_BITS 64
+
+#include "file_hash.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// 透明大页的大小，读缓冲区按它对齐
+#define HUGE_PAGE_SIZE ((size_t) 2 << 20)
+
+static void advise_hugepages(void *addr, size_t len) {
+#ifdef MADV_HUGEPAGE
+    madvise(addr, len, MADV_HUGEPAGE);
+#else
+    (void) addr;
+    (void) len;
+#endif
+}
+
+// 逐个窗口映射普通文件：映射失败返回1 (调用者改用 read)，之后的错误返回-1
+static int hash_mapped(int fd, off_t offset, uint64_t size, unsigned int flags, file_hash_update_fn update,
+                       void *ctx) {
+    long page = sysconf(_SC_PAGESIZE);
+    // mmap 的偏移必须按页对齐，从当前位置所在的页开始映射
+    off_t base = offset - offset % (page > 0 ? page : 4096);
+    size_t skip = (size_t) (offset - base);
+    uint64_t remaining = size;
+    int first = 1;
+
+    while (remaining > 0) {
+        size_t len = remaining + skip > FILE_HASH_MAP_WINDOW ? FILE_HASH_MAP_WINDOW : (size_t) (remaining + skip);
+        unsigned char *map = (unsigned char *) mmap(NULL, len, PROT_READ, MAP_PRIVATE, fd, base);
+
+        if (map == MAP_FAILED) {
+            return first ? 1 : -1;
+        }
+        first = 0;
+        madvise(map, len, MADV_SEQUENTIAL);
+        if (flags & FILE_HASH_HUGEPAGES) {
+            advise_hugepages(map, len);
+        }
+
+        update(ctx, map + skip, len - skip);
+        munmap(map, len);
+
+        remaining -= len - skip;
+        base += (off_t) len;
+        skip = 0;
+    }
+    return 0;
+}
+
+static int hash_read(int fd, unsigned int flags, file_hash_update_fn update, void *ctx, uint64_t *total) {
+    void *buf;
+    int ret = 0;
+
+    if (posix_memalign(&buf, HUGE_PAGE_SIZE, FILE_HASH_READ_SIZE) != 0) {
+        errno = ENOMEM;
+        return -1;
+    }
+    if (flags & FILE_HASH_HUGEPAGES) {
+        advise_hugepages(buf, FILE_HASH_READ_SIZE);
+    }
+
+    for (;;) {
+        ssize_t n = read(fd, buf, FILE_HASH_READ_SIZE);
+
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            ret = -1;
+            break;
+        }
+        if (n == 0) {
+            break;
+        }
+        update(ctx, (const unsigned char *) buf, (size_t) n);
+        *total += (uint64_t) n;
+    }
+    free(buf);
+    return ret;
+}
+
+int file_hash_fd(int fd, unsigned int flags, file_hash_update_fn update, void *ctx, uint64_t *total) {
+    struct stat st;
+    uint64_t count = 0;
+    int ret = 1;
+
+    // 普通文件先尝试映射，从当前读写位置算到文件结尾
+    if (!(flags & FILE_HASH_NO_MMAP) && fstat(fd, &st) == 0 && S_ISREG(st.st_mode)) {
+        off_t offset = lseek(fd, 0, SEEK_CUR);
+
+        if (offset >= 0 && offset < st.st_size) {
+            count = (uint64_t) (st.st_size - offset);
+            ret = hash_mapped(fd, offset, count, flags, update, ctx);
+            if (ret == 0) {
+                lseek(fd, st.st_size, SEEK_SET);
+            }
+        } else if (offset >= 0) {
+            ret = 0; // 已在文件结尾
+        }
+    }
+    if (ret > 0) {
+        count = 0;
+        ret = hash_read(fd, flags, update, ctx, &count);
+    }
+    if (total) {
+        *total = count;
+    }
+    return ret;
+}
+
+int file_hash_path(const char *path, unsigned int flags, file_hash_update_fn update, void *ctx, uint64_t *total) {
+    int fd, ret, saved;
+
+    if (strcmp(path, "-") == 0) {
+        return file_hash_fd(STDIN_FILENO, flags, update, ctx, total);
+    }
+    fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return -1;
+    }
+    ret = file_hash_fd(fd, flags, update, ctx, total);
+    saved = errno;
+    close(fd);
+    errno = saved;
+    return ret;
+}
+
+static void md5_update_cb(void *ctx, const unsigned char *data, size_t len) {
+    MD5_Update((MD5_CTX *) ctx, data, len);
+}
+
+static void sha1_update_cb(void *ctx, const unsigned char *data, size_t len) {
+    SHA1Input((SHA1Context *) ctx, data, len);
+}
+
+int MD5_File(const char *path, unsigned int flags, md5_byte_t digest[16]) {
+    MD5_CTX context;
+
+    MD5_Init(&context);
+    if (file_hash_path(path, flags, md5_update_cb, &context, NULL) != 0) {
+        memset(&context, 0, sizeof(context));
+        return -1;
+    }
+    MD5_Final(digest, &context);
+    return 0;
+}
+
+int SHA1File(const char *path, unsigned int flags, uint8_t digest[SHA1HashSize]) {
+    SHA1Context context;
+    int ret = -1;
+
+    SHA1Reset(&context);
+    if (file_hash_path(path, flags, sha1_update_cb, &context, NULL) == 0 &&
+        SHA1Result(&context, digest) == shaSuccess) {
+        ret = 0;
+    }
+    memset(&context, 0, sizeof(context));
+    return ret;
+}
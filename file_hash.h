@@ -0,0 +1,41 @@
+//
+// 大文件哈希 - 把文件内容分段送入 MD5/SHA-1，支持超过 4 GiB 的文件
+//
+// 普通文件用 mmap 分窗口映射，并用 madvise 提示内核顺序预读；
+// 管道、字符设备等无法映射的文件改用对齐的大缓冲区循环 read。
+//
+
+#ifndef FILE_HASH_H
+#define FILE_HASH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "md5.h"
+#include "sha1.h"
+
+// 选项位
+#define FILE_HASH_HUGEPAGES (1u << 0)   // 对映射窗口和读缓冲区申请透明大页 (内核不支持时忽略)
+#define FILE_HASH_NO_MMAP   (1u << 1)   // 不使用 mmap，总是 read
+
+// 每次映射的窗口大小 (页大小的整数倍)，窗口用完即解除映射，32位系统也能处理任意大小的文件
+#define FILE_HASH_MAP_WINDOW ((size_t) 1 << 30)
+
+// read 路径的缓冲区大小
+#define FILE_HASH_READ_SIZE ((size_t) 4 << 20)
+
+// 数据回调：按文件顺序依次收到全部内容，每段长度不超过一个窗口
+typedef void (*file_hash_update_fn)(void *ctx, const unsigned char *data, size_t len);
+
+// 把文件描述符 fd 从当前位置到结尾的内容依次交给 update；total 不为 NULL 时写入总字节数
+// 成功返回0，读取或映射失败返回-1 (errno 保留失败原因)
+int file_hash_fd(int fd, unsigned int flags, file_hash_update_fn update, void *ctx, uint64_t *total);
+
+// 打开 path 并调用 file_hash_fd，path 为 "-" 时读取标准输入
+int file_hash_path(const char *path, unsigned int flags, file_hash_update_fn update, void *ctx, uint64_t *total);
+
+// 计算文件的 MD5 / SHA-1，成功返回0，失败返回-1
+int MD5_File(const char *path, unsigned int flags, md5_byte_t digest[16]);
+int SHA1File(const char *path, unsigned int flags, uint8_t digest[SHA1HashSize]);
+
+#endif //FILE_HASH_H
@@ -0,0 +1,207 @@
+//
+// 多缓冲哈希调度
+//
+// 单条消息的 MD5/SHA 每一步都依赖上一步的结果，只能用到一个运算单元。
+// 把 4/8/16 条消息放进 SIMD 寄存器的各个元素里同时计算，每条指令就推进所有消息各一步。
+// 每一路算完一条消息后立即换入下一条，长短不一的消息也能让各路保持满载。
+//
+
+#include "hash_mb.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "cpu_features.h"
+#include "crypto_util.h"
+
+// 一路的进度：先处理消息中的完整分组，再处理 tail 中由剩余字节和填充组成的1~2个分组
+typedef struct {
+    size_t msg;                 // 当前消息编号
+    const uint8_t *data;        // 下一个完整分组
+    size_t full;                // 剩余的完整分组数
+    uint8_t tail[128];
+    unsigned int tail_blocks;   // tail 中的分组数
+    unsigned int tail_next;     // tail 中下一个要处理的分组
+    int active;
+} hash_mb_lane;
+
+int hash_mb_lanes_available(unsigned int lanes) {
+    switch (lanes) {
+        case 1:
+            return 1;
+#if CPU_X86
+        case 4:
+            return cpu_has(CPU_SSE2);
+        case 8:
+            return cpu_has(CPU_AVX2);
+        case 16:
+            return cpu_has(CPU_AVX512F);
+#endif
+        default:
+            return 0;
+    }
+}
+
+unsigned int hash_mb_resolve_lanes(const char *env, int scalar_fast) {
+    const char *value = getenv(env);
+    unsigned int lanes = value ? (unsigned int) strtoul(value, NULL, 10) : 0;
+
+    if (hash_mb_lanes_available(lanes)) {
+        return lanes;
+    }
+    if (hash_mb_lanes_available(16)) {
+        return 16;
+    }
+    if (scalar_fast) {
+        return 1;
+    }
+    return hash_mb_lanes_available(8) ? 8 : hash_mb_lanes_available(4) ? 4 : 1;
+}
+
+// 把第 msg 条消息装入第 l 路，并在该路写入初始状态
+static void lane_load(const hash_mb_alg *alg, hash_mb_lane *lane, uint32_t state[][HASH_MB_MAX_LANES],
+                      unsigned int l, size_t msg, const uint8_t *data, size_t len) {
+    size_t rem = len % 64;
+    uint64_t bits = (uint64_t) len << 3;
+    uint8_t *length;
+
+    lane->msg = msg;
+    lane->data = data;
+    lane->full = len / 64;
+    lane->tail_blocks = rem < 56 ? 1 : 2;
+    lane->tail_next = 0;
+    lane->active = 1;
+
+    // 剩余字节 + 0x80 + 补零 + 64位比特长度
+    memcpy(lane->tail, data + len - rem, rem);
+    lane->tail[rem] = 0x80;
+    memset(lane->tail + rem + 1, 0, lane->tail_blocks * 64 - rem - 1);
+    length = lane->tail + lane->tail_blocks * 64 - 8;
+    for (int i = 0; i < 8; i++) {
+        length[alg->big_endian ? 7 - i : i] = (uint8_t) (bits >> (8 * i));
+    }
+
+    for (unsigned int i = 0; i < alg->words; i++) {
+        state[i][l] = alg->init[i];
+    }
+}
+
+static const uint8_t *lane_next_block(hash_mb_lane *lane) {
+    const uint8_t *p;
+
+    if (lane->full > 0) {
+        p = lane->data;
+        lane->data += 64;
+        lane->full--;
+    } else {
+        p = lane->tail + lane->tail_next * 64;
+        lane->tail_next++;
+    }
+    return p;
+}
+
+static void write_digest(const hash_mb_alg *alg, const uint32_t state[][HASH_MB_MAX_LANES], unsigned int l,
+                         uint8_t *digest) {
+    for (unsigned int i = 0; i < alg->words; i++) {
+        for (int j = 0; j < 4; j++) {
+            digest[i * 4 + j] = (uint8_t) (state[i][l] >> (alg->big_endian ? 24 - 8 * j : 8 * j));
+        }
+    }
+}
+
+// 用单条消息的压缩函数完成一路剩余的分组
+static void lane_finish_scalar(const hash_mb_alg *alg, hash_mb_lane *lane, uint32_t state[][HASH_MB_MAX_LANES],
+                               unsigned int l, uint8_t *digest) {
+    uint32_t s[HASH_MB_MAX_WORDS];
+
+    for (unsigned int i = 0; i < alg->words; i++) {
+        s[i] = state[i][l];
+    }
+    alg->process_blocks(s, lane->data, lane->full);
+    alg->process_blocks(s, lane->tail + lane->tail_next * 64, lane->tail_blocks - lane->tail_next);
+    for (unsigned int i = 0; i < alg->words; i++) {
+        state[i][l] = s[i];
+    }
+    write_digest(alg, state, l, digest);
+}
+
+void hash_mb_many(const hash_mb_alg *alg, unsigned int nlanes, const uint8_t *const *msgs, const size_t *lens,
+                  size_t n, uint8_t *digests) {
+    static const uint8_t idle_block[64] = {0};
+    const size_t digest_size = alg->words * 4;
+    hash_mb_lane lanes[HASH_MB_MAX_LANES];
+    uint32_t state[HASH_MB_MAX_WORDS][HASH_MB_MAX_LANES];
+    const uint8_t *blocks[HASH_MB_MAX_LANES];
+    hash_mb_compress_fn compress;
+    unsigned int active = 0;
+    size_t next = 0;
+
+    switch (nlanes) {
+        case 16:
+            compress = alg->compress16;
+            break;
+        case 8:
+            compress = alg->compress8;
+            break;
+        case 4:
+            compress = alg->compress4;
+            break;
+        default:
+            compress = NULL;
+            break;
+    }
+
+    // 逐条计算：每条消息直接交给单条消息的压缩函数
+    if (!compress) {
+        for (size_t i = 0; i < n; i++) {
+            lane_load(alg, &lanes[0], state, 0, i, msgs[i], lens[i]);
+            lane_finish_scalar(alg, &lanes[0], state, 0, digests + i * digest_size);
+        }
+        secure_wipe(lanes, sizeof(lanes[0]));
+        secure_wipe(state, sizeof(state));
+        return;
+    }
+
+    memset(state, 0, sizeof(state));
+    for (unsigned int l = 0; l < nlanes; l++) {
+        lanes[l].active = 0;
+        if (next < n) {
+            lane_load(alg, &lanes[l], state, l, next, msgs[next], lens[next]);
+            next++;
+            active++;
+        }
+    }
+
+    // 待处理的消息用完且只剩不到一半的路在算时，再跑向量内核就不划算了
+    while (active > 0 && (next < n || active > nlanes / 2)) {
+        for (unsigned int l = 0; l < nlanes; l++) {
+            blocks[l] = lanes[l].active ? lane_next_block(&lanes[l]) : idle_block;
+        }
+        compress(state, blocks);
+
+        // 算完的路写出摘要并立即换入下一条消息
+        for (unsigned int l = 0; l < nlanes; l++) {
+            hash_mb_lane *lane = &lanes[l];
+
+            if (!lane->active || lane->full > 0 || lane->tail_next < lane->tail_blocks) {
+                continue;
+            }
+            write_digest(alg, state, l, digests + lane->msg * digest_size);
+            if (next < n) {
+                lane_load(alg, lane, state, l, next, msgs[next], lens[next]);
+                next++;
+            } else {
+                lane->active = 0;
+                active--;
+            }
+        }
+    }
+
+    for (unsigned int l = 0; l < nlanes; l++) {
+        if (lanes[l].active) {
+            lane_finish_scalar(alg, &lanes[l], state, l, digests + lanes[l].msg * digest_size);
+        }
+    }
+    secure_wipe(lanes, sizeof(lanes));
+    secure_wipe(state, sizeof(state));
+}
@@ -0,0 +1,47 @@
+//
+// 多缓冲哈希调度 - MD5/SHA-1/SHA-256 多缓冲实现共用的分路调度，只供内部使用
+//
+// 各哈希只提供按向量宽度编译的压缩内核和单条消息的压缩函数；
+// 装入消息、填充、换入下一条消息、写出摘要和收尾都在这里完成
+//
+
+#ifndef HASH_MB_H
+#define HASH_MB_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// 最多同时计算的消息数 (AVX-512)，以及状态字个数的上限 (SHA-256)
+#define HASH_MB_MAX_LANES 16
+#define HASH_MB_MAX_WORDS 8
+
+// 各路同时压缩一个64字节分组：state[i][l] 为第 l 路的第 i 个状态字，blocks[l] 为第 l 路的分组
+typedef void (*hash_mb_compress_fn)(uint32_t state[][HASH_MB_MAX_LANES],
+                                    const uint8_t *const blocks[HASH_MB_MAX_LANES]);
+
+// 单条消息的压缩函数：对连续的 nblocks 个分组更新 state
+typedef void (*hash_mb_blocks_fn)(uint32_t *state, const uint8_t *blocks, size_t nblocks);
+
+// 一种哈希的描述
+typedef struct {
+    unsigned int words;             // 状态字个数，摘要为 words * 4 字节
+    const uint32_t *init;           // 初始状态
+    int big_endian;                 // 比特长度和摘要的字节序：1 为大端 (SHA)，0 为小端 (MD5)
+    hash_mb_blocks_fn process_blocks;
+    hash_mb_compress_fn compress4;  // 4/8/16 路内核，NULL 表示没有该宽度
+    hash_mb_compress_fn compress8;
+    hash_mb_compress_fn compress16;
+} hash_mb_alg;
+
+// 判断 lanes 路 (1/4/8/16) 在当前CPU上是否可用
+int hash_mb_lanes_available(unsigned int lanes);
+
+// 自动选择路数：环境变量 env 中的路数可用则使用，否则取CPU支持的最宽实现；
+// scalar_fast 为真 (单条消息有硬件指令) 时，没有 16 路就逐条计算
+unsigned int hash_mb_resolve_lanes(const char *env, int scalar_fast);
+
+// 用 nlanes 路计算 n 条消息的摘要，第 i 条写入 digests + i * words * 4；nlanes 为1时逐条计算
+void hash_mb_many(const hash_mb_alg *alg, unsigned int nlanes, const uint8_t *const *msgs, const size_t *lens,
+                  size_t n, uint8_t *digests);
+
+#endif //HASH_MB_H
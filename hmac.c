@@ -0,0 +1,167 @@
+//
+// HMAC-MD5 / HMAC-SHA1
+//
+// HMAC(K, m) = H((K⊕opad) || H((K⊕ipad) || m))，K 补零到分组长度 (64字节)。
+// (K⊕ipad)、(K⊕opad) 正好各占一个分组，与消息无关，所以在准备密钥时压缩一次即可。
+//
+
+#include "hmac.h"
+
+#include <string.h>
+
+#include "crypto_util.h"
+
+#define HMAC_BLOCK_SIZE 64
+#define HMAC_IPAD 0x36
+#define HMAC_OPAD 0x5c
+
+// 把补零后的密钥与 pad 异或，得到一个完整分组
+static void hmac_pad_block(uint8_t block[HMAC_BLOCK_SIZE], const uint8_t *k, size_t klen, uint8_t pad) {
+    memset(block, pad, HMAC_BLOCK_SIZE);
+    for (size_t i = 0; i < klen; i++) {
+        block[i] ^= k[i];
+    }
+}
+
+void HMAC_MD5_SetKey(HMAC_MD5_KEY *key, const md5_byte_t *k, size_t klen) {
+    md5_byte_t hashed[HMAC_MD5_SIZE];
+    md5_byte_t block[HMAC_BLOCK_SIZE];
+
+    if (klen > HMAC_BLOCK_SIZE) {
+        MD5_CTX context;
+
+        MD5_Init(&context);
+        MD5_Update(&context, k, klen);
+        MD5_Final(hashed, &context);
+        secure_wipe(&context, sizeof(context));
+        k = hashed;
+        klen = sizeof(hashed);
+    }
+
+    hmac_pad_block(block, k, klen, HMAC_IPAD);
+    MD5_Init(&key->inner);
+    MD5_Update(&key->inner, block, sizeof(block));
+
+    hmac_pad_block(block, k, klen, HMAC_OPAD);
+    MD5_Init(&key->outer);
+    MD5_Update(&key->outer, block, sizeof(block));
+
+    secure_wipe(block, sizeof(block));
+    secure_wipe(hashed, sizeof(hashed));
+}
+
+void HMAC_MD5_Init(HMAC_MD5_CTX *context, const HMAC_MD5_KEY *key) {
+    context->md5 = key->inner;
+    context->key = key;
+}
+
+void HMAC_MD5_Update(HMAC_MD5_CTX *context, const md5_byte_t *input, size_t length) {
+    MD5_Update(&context->md5, input, length);
+}
+
+void HMAC_MD5_Final(md5_byte_t mac[HMAC_MD5_SIZE], HMAC_MD5_CTX *context) {
+    md5_byte_t inner[HMAC_MD5_SIZE];
+
+    MD5_Final(inner, &context->md5);
+    context->md5 = context->key->outer;
+    MD5_Update(&context->md5, inner, sizeof(inner));
+    MD5_Final(mac, &context->md5);
+    secure_wipe(inner, sizeof(inner));
+}
+
+void HMAC_MD5(const HMAC_MD5_KEY *key, const md5_byte_t *msg, size_t len, md5_byte_t mac[HMAC_MD5_SIZE]) {
+    HMAC_MD5_CTX context;
+
+    HMAC_MD5_Init(&context, key);
+    HMAC_MD5_Update(&context, msg, len);
+    HMAC_MD5_Final(mac, &context);
+}
+
+void HMAC_MD5_KeyWipe(HMAC_MD5_KEY *key) {
+    secure_wipe(key, sizeof(*key));
+}
+
+int HMACSHA1SetKey(HMACSHA1Key *key, const uint8_t *k, size_t klen) {
+    uint8_t hashed[SHA1HashSize];
+    uint8_t block[HMAC_BLOCK_SIZE];
+    int err;
+
+    if (!key || (!k && klen > 0)) {
+        return shaNull;
+    }
+
+    if (klen > HMAC_BLOCK_SIZE) {
+        SHA1Context context;
+
+        if ((err = SHA1Reset(&context)) != shaSuccess ||
+            (err = SHA1Input(&context, k, klen)) != shaSuccess ||
+            (err = SHA1Result(&context, hashed)) != shaSuccess) {
+            secure_wipe(&context, sizeof(context));
+            secure_wipe(hashed, sizeof(hashed));
+            return err;
+        }
+        secure_wipe(&context, sizeof(context));
+        k = hashed;
+        klen = sizeof(hashed);
+    }
+
+    hmac_pad_block(block, k, klen, HMAC_IPAD);
+    SHA1Reset(&key->inner);
+    SHA1Input(&key->inner, block, sizeof(block));
+
+    hmac_pad_block(block, k, klen, HMAC_OPAD);
+    SHA1Reset(&key->outer);
+    SHA1Input(&key->outer, block, sizeof(block));
+
+    secure_wipe(block, sizeof(block));
+    secure_wipe(hashed, sizeof(hashed));
+    return shaSuccess;
+}
+
+int HMACSHA1Reset(HMACSHA1Context *context, const HMACSHA1Key *key) {
+    if (!context || !key) {
+        return shaNull;
+    }
+    context->sha = key->inner;
+    context->key = key;
+    return shaSuccess;
+}
+
+int HMACSHA1Input(HMACSHA1Context *context, const uint8_t *message_array, size_t length) {
+    if (!context) {
+        return shaNull;
+    }
+    return SHA1Input(&context->sha, message_array, length);
+}
+
+int HMACSHA1Result(HMACSHA1Context *context, uint8_t mac[SHA1HashSize]) {
+    uint8_t inner[SHA1HashSize];
+    int err;
+
+    if (!context || !mac) {
+        return shaNull;
+    }
+    if ((err = SHA1Result(&context->sha, inner)) != shaSuccess) {
+        return err;
+    }
+    context->sha = context->key->outer;
+    SHA1Input(&context->sha, inner, sizeof(inner));
+    err = SHA1Result(&context->sha, mac);
+    secure_wipe(inner, sizeof(inner));
+    return err;
+}
+
+int HMACSHA1(const HMACSHA1Key *key, const uint8_t *msg, size_t len, uint8_t mac[SHA1HashSize]) {
+    HMACSHA1Context context;
+    int err;
+
+    if ((err = HMACSHA1Reset(&context, key)) != shaSuccess ||
+        (err = HMACSHA1Input(&context, msg, len)) != shaSuccess) {
+        return err;
+    }
+    return HMACSHA1Result(&context, mac);
+}
+
+void HMACSHA1KeyWipe(HMACSHA1Key *key) {
+    secure_wipe(key, sizeof(*key));
+}
@@ -0,0 +1,65 @@
+//
+// HMAC-MD5 / HMAC-SHA1 (RFC 2104) - 密钥只准备一次，之后计算任意多条消息的 MAC
+//
+// 准备密钥时把 key⊕ipad、key⊕opad 两个分组各压缩一次，保存压缩后的中间状态；
+// 每条消息只需复制这两个状态，比每次重新处理填充分组少两次压缩。
+//
+
+#ifndef HMAC_H
+#define HMAC_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "md5.h"
+#include "sha1.h"
+
+#define HMAC_MD5_SIZE 16
+
+// 准备好的密钥：已吸收 key⊕ipad / key⊕opad 分组的内外两层上下文
+// 其中的中间状态与原密钥等价，不再使用时应调用 HMAC_MD5_KeyWipe / HMACSHA1KeyWipe 清除
+typedef struct {
+    MD5_CTX inner;
+    MD5_CTX outer;
+} HMAC_MD5_KEY;
+
+typedef struct {
+    SHA1Context inner;
+    SHA1Context outer;
+} HMACSHA1Key;
+
+// 计算单条消息 MAC 的流式上下文，从准备好的密钥开始
+typedef struct {
+    MD5_CTX md5;
+    const HMAC_MD5_KEY *key;
+} HMAC_MD5_CTX;
+
+typedef struct {
+    SHA1Context sha;
+    const HMACSHA1Key *key;
+} HMACSHA1Context;
+
+// 准备密钥：长于64字节的密钥先哈希 (RFC 2104 第2节)
+void HMAC_MD5_SetKey(HMAC_MD5_KEY *key, const md5_byte_t *k, size_t klen);
+
+// 流式计算：Init 复制内层状态，Update 可调用多次，Final 复制外层状态并写出 MAC
+// 计算期间 key 必须保持有效；同一个 key 可以同时被多个上下文使用
+void HMAC_MD5_Init(HMAC_MD5_CTX *context, const HMAC_MD5_KEY *key);
+void HMAC_MD5_Update(HMAC_MD5_CTX *context, const md5_byte_t *input, size_t length);
+void HMAC_MD5_Final(md5_byte_t mac[HMAC_MD5_SIZE], HMAC_MD5_CTX *context);
+
+// 一次计算一条消息的 MAC
+void HMAC_MD5(const HMAC_MD5_KEY *key, const md5_byte_t *msg, size_t len, md5_byte_t mac[HMAC_MD5_SIZE]);
+
+// 清除准备好的密钥
+void HMAC_MD5_KeyWipe(HMAC_MD5_KEY *key);
+
+// 与上面相同，返回 sha1.h 中的 sha Error Code
+int HMACSHA1SetKey(HMACSHA1Key *key, const uint8_t *k, size_t klen);
+int HMACSHA1Reset(HMACSHA1Context *context, const HMACSHA1Key *key);
+int HMACSHA1Input(HMACSHA1Context *context, const uint8_t *message_array, size_t length);
+int HMACSHA1Result(HMACSHA1Context *context, uint8_t mac[SHA1HashSize]);
+int HMACSHA1(const HMACSHA1Key *key, const uint8_t *msg, size_t len, uint8_t mac[SHA1HashSize]);
+void HMACSHA1KeyWipe(HMACSHA1Key *key);
+
+#endif //HMAC_H
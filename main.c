@@ -4,12 +4,29 @@
  * Compile with: gcc -o crypto_test main.c md5.c sha1.c
  */
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <time.h>
+#include <unistd.h>
 
 #include "md5.h"
+#include "md5_mb.h"
+#include "file_hash.h"
 #include "sha1.h" // 引入 sha1 头文件
+#include "sha1_mb.h"
+#include "sha256.h"
+#include "sha256_mb.h"
+#include "sha512.h"
+#include "hmac.h"
 #include "des.h" // 引入 des 头文件
+#include "des_bitslice.h"
+#include "des_keysearch.h"
+#include "parallel.h"
 #include "aes.h" // 引入 aes 头文件
+#include "aes_cbc.h"
+#include "aes_ctr.h"
+#include "aes_gcm.h"
+#include "aes_xts.h"
 
 // MD5 调用函数
 // 修改函数参数类型为 char *
@@ -54,25 +71,54 @@ void call_sha1(const char *content, size_t length) {
     printf("Expected: ddba2c9277cd909b2d4fac91a3cc754a462c7a90\n\n");
 }
 
-// 调用DES加密函数
+// 调用DES加密函数：内容按8字节分组用 ECB 加密，最后不足一块时补零
 void call_des(const char *content, size_t length) {
-    DES_cblock output;
     DES_key_schedule schedule;
     // 初始化秘钥
     DES_cblock key = "mysecret";
     char label[256]; // 假设最大长度为 256，可按需调整
+    size_t nblocks = (length + 7) / 8;
+    unsigned char *buf = (unsigned char *) calloc(nblocks ? nblocks : 1, 8);
 
+    if (!buf) return;
+    memcpy(buf, content, length);
 
     // 设置密钥
     DES_set_key(&key, &schedule);
 
     // 加密
-    DES_ecb_encrypt((const DES_cblock *) content, &output, &schedule, 1);
+    DES_ecb_encrypt_blocks(buf, buf, nblocks, &schedule, DES_ENCRYPT);
 
     // 动态构造 label
     snprintf(label, sizeof(label), "DES(\"%s\")", content);
     // 以十六进制摘要方式输出结果
-    print_hex_digest(label, output, sizeof(DES_cblock));
+    print_hex_digest(label, buf, nblocks * 8);
+    free(buf);
+}
+
+// DES-CBC / DES-CTR 多分组接口：加密后解密回原文
+void call_des_modes() {
+    static const char message[] = "The quick brown fox jumps over the lazy dog.....";
+    unsigned char ciphertext[sizeof(message) - 1], decrypted[sizeof(message) - 1];
+    DES_cblock key = "mysecret";
+    DES_cblock iv = "initvect", counter = {0};
+    DES_key_schedule schedule;
+    size_t len = sizeof(message) - 1;
+
+    DES_set_key(&key, &schedule);
+
+    DES_cbc_encrypt_blocks((const unsigned char *) message, ciphertext, len / 8, &schedule, &iv, DES_ENCRYPT);
+    memcpy(iv, "initvect", 8);
+    DES_cbc_encrypt_blocks(ciphertext, decrypted, len / 8, &schedule, &iv, DES_DECRYPT);
+    print_hex_digest("DES-CBC", ciphertext, len);
+    printf("Expected: a3004c999ce70d7059e8605de6474f53e85597ffe715457d1c8fe20c45423dd3b43c165bc9f710ee8e27db0b67e4ea34\n");
+    printf("解密验证: %s\n", memcmp(decrypted, message, len) == 0 ? "通过" : "失败");
+
+    DES_ctr_encrypt((const unsigned char *) message, ciphertext, len - 3, &schedule, &counter);
+    memset(counter, 0, sizeof(counter));
+    DES_ctr_encrypt(ciphertext, decrypted, len - 3, &schedule, &counter);
+    print_hex_digest("DES-CTR", ciphertext, len - 3);
+    printf("解密验证: %s\n", memcmp(decrypted, message, len - 3) == 0 ? "通过" : "失败");
 }
 
 // 封装测试流程
@@ -121,7 +167,8 @@ int call_aes() {
     for (int i = 0; i < 16; i++) {
         printf("%02x ", ciphertext[i]);
     }
-    printf("\n\n");
+    printf("\n");
+    printf("期望结果: 39 25 84 1d 02 dc 09 fb dc 11 85 97 19 6a 0b 32 (FIPS-197 附录B)\n\n");
 
     // 执行解密
     aes_decrypt(ciphertext, key, decrypted);
@@ -147,22 +194,1528 @@ int call_aes() {
         printf("验证失败: 解密结果与原始明文不一致\n");
     }
 
+    printf("实现: %s, FIPS-197 自检: %s\n", aes_impl_name(aes_get_impl()),
+           aes_self_test() == 0 ? "通过" : "失败");
+
+    // AES-256：FIPS-197 附录C.3
+    unsigned char key256[32];
+    unsigned char plain256[16];
+    aes_ctx ctx256;
+
+    for (int i = 0; i < 32; i++) {
+        key256[i] = (unsigned char) i;
+    }
+    for (int i = 0; i < 16; i++) {
+        plain256[i] = (unsigned char) (i * 0x11);
+    }
+    aes_init_key(&ctx256, key256, sizeof(key256));
+    aes_encrypt_blocks(&ctx256, plain256, ciphertext, 1);
+    aes_wipe(&ctx256);
+    print_hex_digest("AES-256", ciphertext, sizeof(ciphertext));
+    printf("Expected:   8ea2b7ca516745bfeafc49904b496089\n");
+
+    return 0;
+}
+
+// AES-CBC 测试，使用 NIST SP 800-38A F.2.1 向量，并验证 PKCS#7 填充的加解密往返
+void call_aes_cbc() {
+    unsigned char key[16] = {
+        0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6,
+        0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c
+    };
+    unsigned char iv[16] = {
+        0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+        0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f
+    };
+    unsigned char plaintext[32] = {
+        0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a,
+        0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c, 0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51
+    };
+    unsigned char chain[16];
+    unsigned char ciphertext[48], decrypted[48];
+    size_t clen, plen = 0;
+    aes_ctx ctx;
+
+    aes_init(&ctx, key);
+    memcpy(chain, iv, sizeof(chain));
+    aes_cbc_encrypt_blocks(&ctx, chain, plaintext, ciphertext, 2);
+    print_hex_digest("AES-128-CBC", ciphertext, 32);
+    printf("Expected:   7649abac8119b246cee98e9b12e9197d5086cb9b507219ee95db113a917678b2\n");
+
+    // 21字节消息填充成32字节，解密后去掉填充应得到原文
+    clen = aes_cbc_encrypt(&ctx, iv, plaintext, 21, ciphertext);
+    printf("PKCS#7 往返: %s\n",
+           aes_cbc_decrypt(&ctx, iv, ciphertext, clen, decrypted, &plen) == 0 && plen == 21 &&
+           memcmp(decrypted, plaintext, plen) == 0 ? "通过" : "失败");
+    aes_wipe(&ctx);
+}
+
+// AES-CTR 测试，使用 NIST SP 800-38A F.5.1 向量，分两次调用验证流式接口
+void call_aes_ctr() {
+    unsigned char key[16] = {
+        0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6,
+        0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c
+    };
+    unsigned char counter[16] = {
+        0xf0, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7,
+        0xf8, 0xf9, 0xfa, 0xfb, 0xfc, 0xfd, 0xfe, 0xff
+    };
+    unsigned char plaintext[32] = {
+        0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a,
+        0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c, 0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51
+    };
+    unsigned char ciphertext[32];
+    static unsigned char single[1000 * AES_BLOCK_SIZE + 7], threaded[sizeof(single)];
+    aes_ctr_ctx ctx;
+
+    aes_ctr_init(&ctx, key, counter);
+    aes_ctr_crypt(&ctx, plaintext, ciphertext, 5);
+    aes_ctr_crypt(&ctx, plaintext + 5, ciphertext + 5, sizeof(plaintext) - 5);
+    aes_ctr_wipe(&ctx);
+
+    print_hex_digest("AES-128-CTR", ciphertext, sizeof(ciphertext));
+    printf("Expected:   874d6191b620e3261bef6864990db6ce9806f66b7970fdff8617187bb9fffdff\n");
+
+    // 拆分给4个线程 (每次调用都拆分) 的结果应与单线程相同
+    aes_ctr_init(&ctx, key, counter);
+    aes_ctr_set_parallel(&ctx, 0, 1);
+    aes_ctr_crypt(&ctx, single, single, sizeof(single));
+    aes_ctr_init(&ctx, key, counter);
+    aes_ctr_set_parallel(&ctx, 1, 4);
+    aes_ctr_crypt(&ctx, threaded, threaded, sizeof(threaded));
+    aes_ctr_wipe(&ctx);
+    printf("多线程 (4 线程) 与单线程结果一致: %s\n", memcmp(single, threaded, sizeof(single)) == 0 ? "通过" : "失败");
+}
+
+// AES-GCM 测试，使用 GCM 规范 (McGrew & Viega) 的测试用例2，并验证篡改后解密失败
+void call_aes_gcm() {
+    unsigned char key[16] = {0};
+    unsigned char iv[12] = {0};
+    unsigned char plaintext[16] = {0};
+    unsigned char ciphertext[16], decrypted[16], tag[AES_GCM_TAG_SIZE];
+    aes_gcm_ctx ctx;
+
+    aes_gcm_init(&ctx, key);
+    aes_gcm_encrypt(&ctx, iv, sizeof(iv), NULL, 0, plaintext, ciphertext, sizeof(plaintext), tag, sizeof(tag));
+
+    print_hex_digest("AES-128-GCM", ciphertext, sizeof(ciphertext));
+    printf("Expected:   0388dace60b6a392f328c2b971b2fe78\n");
+    print_hex_digest("GCM Tag", tag, sizeof(tag));
+    printf("Expected:   ab6e47d42cec13bdf53a67b21257bddf\n");
+
+    printf("GHASH: %s, 解密验证: %s", aes_gcm_ghash_name(&ctx),
+           aes_gcm_decrypt(&ctx, iv, sizeof(iv), NULL, 0, ciphertext, decrypted, sizeof(ciphertext), tag,
+                           sizeof(tag)) == 0 && memcmp(decrypted, plaintext, sizeof(plaintext)) == 0 ? "通过" : "失败");
+    ciphertext[0] ^= 1;
+    printf(", 篡改检测: %s\n",
+           aes_gcm_decrypt(&ctx, iv, sizeof(iv), NULL, 0, ciphertext, decrypted, sizeof(ciphertext), tag,
+                           sizeof(tag)) != 0 ? "通过" : "失败");
+    ciphertext[0] ^= 1;
+    printf("拒绝1字节标签: %s, 拒绝空 IV: %s\n",
+           aes_gcm_decrypt(&ctx, iv, sizeof(iv), NULL, 0, ciphertext, decrypted, sizeof(ciphertext), tag, 1) != 0 &&
+           aes_gcm_encrypt(&ctx, iv, sizeof(iv), NULL, 0, plaintext, ciphertext, sizeof(plaintext), tag, 1) != 0
+           ? "通过" : "失败",
+           aes_gcm_encrypt(&ctx, iv, 0, NULL, 0, plaintext, ciphertext, sizeof(plaintext), tag, sizeof(tag)) != 0
+           ? "通过" : "失败");
+    aes_gcm_wipe(&ctx);
+}
+
+// XTS-AES 测试，使用 IEEE 1619 附录B 向量2（K1=11..11、K2=22..22、扇区0x3333333333），并检查扇区号进位和拒绝 K1 == K2
+void call_aes_xts() {
+    unsigned char key[32];
+    unsigned char plaintext[32];
+    unsigned char ciphertext[32], decrypted[32], wrapped[64], first[32];
+    aes_xts_ctx ctx;
+
+    // IEEE 1619 测试向量2：K1 = 11..11，K2 = 22..22，扇区号 0x3333333333
+    memset(key, 0x11, 16);
+    memset(key + 16, 0x22, 16);
+    memset(plaintext, 0x44, sizeof(plaintext));
+    aes_xts_init(&ctx, key, sizeof(key), sizeof(plaintext));
+    aes_xts_encrypt_sectors(&ctx, 0x3333333333ull, plaintext, ciphertext, 1);
+    aes_xts_decrypt_sectors(&ctx, 0x3333333333ull, ciphertext, decrypted, 1);
+
+    // 扇区 2^64 - 1 之后是 2^64，调整值不能与扇区0相同
+    memset(wrapped, 0, sizeof(wrapped));
+    aes_xts_encrypt_sectors(&ctx, UINT64_MAX, wrapped, wrapped, 2);
+    memset(first, 0, sizeof(first));
+    aes_xts_encrypt_sectors(&ctx, 0, first, first, 1);
+    aes_xts_wipe(&ctx);
+
+    print_hex_digest("XTS-AES-128", ciphertext, sizeof(ciphertext));
+    printf("Expected:   c454185e6a16936e39334038acef838bfb186fff7480adc4289382ecd6d394f0\n");
+    printf("解密验证: %s\n", memcmp(decrypted, plaintext, sizeof(plaintext)) == 0 ? "通过" : "失败");
+    printf("扇区号越过 2^64 进位: %s\n", memcmp(wrapped + 32, first, sizeof(first)) != 0 ? "通过" : "失败");
+
+    memset(key + 16, 0x11, 16);
+    printf("拒绝 K1 == K2: %s\n", aes_xts_init(&ctx, key, sizeof(key), sizeof(plaintext)) == -1 ? "通过" : "失败");
+}
+
+// 3DES：K1 = K2 = K3 时应与单 DES 相同；EDE3 与 OpenSSL des-ede3 对照
+void call_des_ede3() {
+    DES_cblock k1 = "mysecret", k2 = "Gemini12", k3 = "3des-key";
+    DES_cblock input = "Gemini12", output, decrypted;
+    DES_EDE_key_schedule schedule;
+
+    DES_set_key_ede3(&k1, &k1, &k1, &schedule);
+    DES_ede3_ecb_encrypt(&input, &output, &schedule, DES_ENCRYPT);
+    print_hex_digest("3DES(K1=K2=K3)", output, sizeof(DES_cblock));
+    printf("Expected:      430f61f003c37d19\n");
+
+    DES_set_key_ede3(&k1, &k2, &k3, &schedule);
+    DES_ede3_ecb_encrypt(&input, &output, &schedule, DES_ENCRYPT);
+    DES_ede3_ecb_encrypt(&output, &decrypted, &schedule, DES_DECRYPT);
+    print_hex_digest("3DES-EDE3", output, sizeof(DES_cblock));
+    printf("Expected:  746bacba3771a0c0\n");
+    printf("解密验证: %s\n", memcmp(decrypted, input, sizeof(DES_cblock)) == 0 ? "通过" : "失败");
+}
+
+// DES 密钥搜索：在包含真实密钥的一小段范围内搜索，验证能找回密钥
+void call_des_keysearch() {
+    DES_cblock key = "mysecret", plaintext = "Gemini12", ciphertext, check;
+    DES_key_schedule schedule;
+    des_keysearch_params params;
+    des_keysearch_result result;
+    uint64_t index = DES_bs_key_to_index(&key);
+
+    DES_set_key(&key, &schedule);
+    DES_ecb_encrypt(&plaintext, &ciphertext, &schedule, DES_ENCRYPT);
+
+    des_keysearch_init(&params, &plaintext, &ciphertext, index - (1u << 20), 1u << 21);
+    if (des_keysearch_run(&params, &result) != 1) {
+        printf("密钥搜索: 未找到\n");
+        return;
+    }
+    DES_set_key(&result.key, &schedule);
+    DES_ecb_encrypt(&plaintext, &check, &schedule, DES_ENCRYPT);
+    print_hex_digest("找到密钥", result.key, sizeof(DES_cblock));
+    printf("密钥序号 %014llx (期望 %014llx)，验证: %s\n", (unsigned long long) result.index,
+           (unsigned long long) index, memcmp(check, ciphertext, 8) == 0 ? "通过" : "失败");
+}
+
+// 位切片 DES：一批分组的结果应与逐块 DES_ecb_encrypt 相同
+void call_des_bitslice() {
+    enum { NBLOCKS = 300 };
+    static unsigned char plaintext[NBLOCKS * 8], expected[NBLOCKS * 8], ciphertext[NBLOCKS * 8];
+    DES_cblock key = "mysecret";
+    DES_key_schedule schedule;
+    int ok;
+
+    for (size_t i = 0; i < sizeof(plaintext); i++) {
+        plaintext[i] = (unsigned char) (i * 31 + 7);
+    }
+    DES_set_key(&key, &schedule);
+    for (size_t i = 0; i < NBLOCKS; i++) {
+        DES_ecb_encrypt((const DES_cblock *) (plaintext + i * 8), (DES_cblock *) (expected + i * 8), &schedule,
+                        DES_ENCRYPT);
+    }
+
+    DES_bs_ecb_encrypt(plaintext, ciphertext, NBLOCKS, &schedule, DES_ENCRYPT);
+    ok = memcmp(ciphertext, expected, sizeof(expected)) == 0;
+    DES_bs_ecb_encrypt(ciphertext, ciphertext, NBLOCKS, &schedule, DES_DECRYPT);
+    ok = ok && memcmp(ciphertext, plaintext, sizeof(plaintext)) == 0;
+    printf("位切片 DES (%u 路) %d 个分组: %s\n", DES_bs_lanes(), NBLOCKS, ok ? "通过" : "失败");
+}
+
+// 多缓冲 MD5：RFC 1321 测试向量和长短不一的消息，结果应与逐条计算相同
+void call_md5_many() {
+    enum { NMSGS = 100 };
+    static const char *rfc[] = {
+        "", "a", "abc", "message digest", "abcdefghijklmnopqrstuvwxyz",
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789",
+        "12345678901234567890123456789012345678901234567890123456789012345678901234567890"
+    };
+    static md5_byte_t data[NMSGS * 200];
+    const md5_byte_t *msgs[NMSGS];
+    size_t lens[NMSGS];
+    md5_byte_t digests[NMSGS][16], expected[16];
+    char hexString[33];
+    size_t nrfc = sizeof(rfc) / sizeof(rfc[0]);
+    int ok = 1;
+
+    for (size_t i = 0; i < sizeof(data); i++) {
+        data[i] = (md5_byte_t) (i * 131 + 17);
+    }
+    // 前面是 RFC 1321 附录中的测试字符串，后面是 0~199 字节的随机长度消息
+    for (size_t i = 0; i < NMSGS; i++) {
+        if (i < nrfc) {
+            msgs[i] = (const md5_byte_t *) rfc[i];
+            lens[i] = strlen(rfc[i]);
+        } else {
+            msgs[i] = data + i * 200;
+            lens[i] = (i * 37) % 200;
+        }
+    }
+
+    MD5_HashMany(msgs, lens, NMSGS, digests);
+    for (size_t i = 0; i < NMSGS; i++) {
+        MD5_CTX context;
+
+        MD5_Init(&context);
+        MD5_Update(&context, msgs[i], lens[i]);
+        MD5_Final(expected, &context);
+        ok = ok && memcmp(digests[i], expected, 16) == 0;
+    }
+    MD5_ToHexString(digests[2], hexString, sizeof(hexString));
+    printf("MD5_HashMany(\"abc\") = %s\n", hexString);
+    printf("Expected:               900150983cd24fb0d6963f7d28e17f72\n");
+    printf("多缓冲 MD5 (%u 路) %d 条消息: %s\n", MD5_mb_lanes(), NMSGS, ok ? "通过" : "失败");
+}
+
+static void md5_file_update(void *ctx, const unsigned char *data, size_t len) {
+    MD5_Update((MD5_CTX *) ctx, data, len);
+}
+
+// 文件哈希：同一份数据分别经 mmap (临时文件) 和 read (管道) 路径，结果应与内存中计算相同
+void call_file_hash() {
+    enum { SIZE = 3 * 1000 * 1000 + 17 };
+    unsigned char *data = (unsigned char *) malloc(SIZE);
+    char path[] = "/tmp/file_hash_XXXXXX";
+    md5_byte_t expected[16], digest[16];
+    uint8_t expected_sha[SHA1HashSize], digest_sha[SHA1HashSize];
+    MD5_CTX context;
+    SHA1Context sha;
+    uint64_t total = 0;
+    int fd, pipefd[2], ok;
+
+    if (!data) return;
+    for (size_t i = 0; i < SIZE; i++) {
+        data[i] = (unsigned char) (i * 7 + (i >> 11));
+    }
+    MD5_Init(&context);
+    MD5_Update(&context, data, SIZE);
+    MD5_Final(expected, &context);
+    SHA1Reset(&sha);
+    SHA1Input(&sha, data, SIZE);
+    SHA1Result(&sha, expected_sha);
+
+    fd = mkstemp(path);
+    if (fd < 0 || write(fd, data, SIZE) != SIZE) {
+        printf("无法创建临时文件\n");
+        free(data);
+        return;
+    }
+    close(fd);
+    ok = MD5_File(path, 0, digest) == 0 && memcmp(digest, expected, 16) == 0 &&
+         SHA1File(path, FILE_HASH_HUGEPAGES, digest_sha) == 0 && memcmp(digest_sha, expected_sha, SHA1HashSize) == 0;
+    print_hex_digest("MD5_File", digest, 16);
+    printf("文件 (mmap) %d 字节: %s\n", SIZE, ok ? "通过" : "失败");
+    unlink(path);
+
+    // 管道无法映射，走 read 路径；数据小于管道缓冲区，可以先全部写入再读
+    ok = 0;
+    if (pipe(pipefd) == 0) {
+        if (write(pipefd[1], data, 4096) == 4096) {
+            close(pipefd[1]);
+            MD5_Init(&context);
+            MD5_Update(&context, data, 4096);
+            MD5_Final(expected, &context);
+            MD5_Init(&context);
+            ok = file_hash_fd(pipefd[0], 0, md5_file_update, &context, &total) == 0;
+            MD5_Final(digest, &context);
+            ok = ok && total == 4096 && memcmp(digest, expected, 16) == 0;
+        } else {
+            close(pipefd[1]);
+        }
+        close(pipefd[0]);
+    }
+    printf("管道 (read) %llu 字节: %s\n", (unsigned long long) total, ok ? "通过" : "失败");
+    free(data);
+}
+
+// SHA-1 各实现：RFC 3174 测试向量的结果应一致
+void call_sha1_impls() {
+    static const char *vectors[] = {
+        "abc",
+        "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq",
+        "0123456701234567012345670123456701234567012345670123456701234567"
+    };
+    static const int repeats[] = {1, 1, 10};
+    static const char *expected[] = {
+        "a9993e364706816aba3e25717850c26c9cd0d89d",
+        "84983e441c3bd26ebaae4aa1f95129e5e54670f1",
+        "dea356a2cddd90c7a7ecedc5ebb563934f460452"
+    };
+    static const sha1_impl_t impls[] = {SHA1_IMPL_GENERIC, SHA1_IMPL_SSSE3, SHA1_IMPL_AVX2, SHA1_IMPL_SHANI};
+
+    for (size_t i = 0; i < sizeof(impls) / sizeof(impls[0]); i++) {
+        int ok = 1;
+
+        if (SHA1SetImpl(impls[i]) != 0) {
+            printf("SHA-1 %-8s 不可用\n", SHA1ImplName(impls[i]));
+            continue;
+        }
+        for (size_t v = 0; v < sizeof(vectors) / sizeof(vectors[0]); v++) {
+            SHA1Context sha;
+            uint8_t digest[SHA1HashSize];
+            char hex[2 * SHA1HashSize + 1];
+
+            SHA1Reset(&sha);
+            for (int r = 0; r < repeats[v]; r++) {
+                SHA1Input(&sha, (const uint8_t *) vectors[v], strlen(vectors[v]));
+            }
+            SHA1Result(&sha, digest);
+            for (int j = 0; j < SHA1HashSize; j++) {
+                snprintf(hex + 2 * j, 3, "%02x", digest[j]);
+            }
+            ok = ok && strcmp(hex, expected[v]) == 0;
+        }
+        printf("SHA-1 %-8s RFC 3174 测试向量: %s\n", SHA1ImplName(impls[i]), ok ? "通过" : "失败");
+    }
+    SHA1SetImpl(SHA1_IMPL_AUTO);
+}
+
+// 多缓冲 SHA-1：RFC 3174 测试向量和长短不一的消息，结果应与逐条计算相同
+void call_sha1_many() {
+    enum { NMSGS = 100 };
+    static const char *rfc[] = {
+        "abc",
+        "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq"
+    };
+    static uint8_t data[NMSGS * 200];
+    const uint8_t *msgs[NMSGS];
+    size_t lens[NMSGS];
+    uint8_t digests[NMSGS][SHA1HashSize], expected[SHA1HashSize];
+    size_t nrfc = sizeof(rfc) / sizeof(rfc[0]);
+    int ok = 1;
+
+    for (size_t i = 0; i < sizeof(data); i++) {
+        data[i] = (uint8_t) (i * 151 + 3);
+    }
+    // 前面是 RFC 3174 中的测试字符串，后面是 0~199 字节的各种长度
+    for (size_t i = 0; i < NMSGS; i++) {
+        if (i < nrfc) {
+            msgs[i] = (const uint8_t *) rfc[i];
+            lens[i] = strlen(rfc[i]);
+        } else {
+            msgs[i] = data + i * 200;
+            lens[i] = (i * 41) % 200;
+        }
+    }
+
+    SHA1HashMany(msgs, lens, NMSGS, digests);
+    for (size_t i = 0; i < NMSGS; i++) {
+        SHA1Context sha;
+
+        SHA1Reset(&sha);
+        SHA1Input(&sha, msgs[i], lens[i]);
+        SHA1Result(&sha, expected);
+        ok = ok && memcmp(digests[i], expected, SHA1HashSize) == 0;
+    }
+    print_hex_digest("SHA1HashMany(\"abc\")", digests[0], SHA1HashSize);
+    printf("Expected:                a9993e364706816aba3e25717850c26c9cd0d89d\n");
+    printf("多缓冲 SHA-1 (%u 路) %d 条消息: %s\n", SHA1MBLanes(), NMSGS, ok ? "通过" : "失败");
+}
+
+// SHA-2：计算 msg 的 SHA-224/256/384/512 (由 bits 指定)，十六进制结果写入 hex
+static void sha2_hex(int bits, const char *msg, char hex[2 * SHA512HashSize + 1]) {
+    uint8_t digest[SHA512HashSize];
+    int size = bits / 8;
+
+    if (bits == 224 || bits == 256) {
+        SHA256Context sha;
+
+        bits == 224 ? SHA224Reset(&sha) : SHA256Reset(&sha);
+        SHA256Input(&sha, (const uint8_t *) msg, strlen(msg));
+        bits == 224 ? SHA224Result(&sha, digest) : SHA256Result(&sha, digest);
+    } else {
+        SHA512Context sha;
+
+        bits == 384 ? SHA384Reset(&sha) : SHA512Reset(&sha);
+        SHA512Input(&sha, (const uint8_t *) msg, strlen(msg));
+        bits == 384 ? SHA384Result(&sha, digest) : SHA512Result(&sha, digest);
+    }
+    for (int j = 0; j < size; j++) {
+        snprintf(hex + 2 * j, 3, "%02x", digest[j]);
+    }
+}
+
+// SHA-2：FIPS 180-4 示例，SHA-224/256 对每个压缩函数实现各验证一遍
+void call_sha2() {
+    static const char *msg448 = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+    static const char *msg896 = "abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmnhijklmno"
+                                "ijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqrstu";
+    static const struct {
+        int bits;
+        int two_block; // 0: "abc"，1: 448/896 位的示例消息
+        const char *expected;
+    } vectors[] = {
+        {224, 0, "23097d223405d8228642a477bda255b32aadbce4bda0b3f7e36c9da7"},
+        {224, 1, "75388b16512776cc5dba5da1fd890150b0c6455cb4f58b1952522525"},
+        {256, 0, "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad"},
+        {256, 1, "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1"},
+        {384, 0, "cb00753f45a35e8bb5a03d699ac65007272c32ab0eded1631a8b605a43ff5bed"
+                 "8086072ba1e7cc2358baeca134c825a7"},
+        {384, 1, "09330c33f71147e83d192fc782cd1b4753111b173b3b05d22fa08086e3b0f712"
+                 "fcc7c71a557e2db966c3e9fa91746039"},
+        {512, 0, "ddaf35a193617abacc417349ae20413112e6fa4e89a97ea20a9eeee64b55d39a"
+                 "2192992a274fc1a836ba3c23a3feebbd454d4423643ce80e2a9ac94fa54ca49f"},
+        {512, 1, "8e959b75dae313da8cf4f72814fc143f8f7779c6eb9f7fa17299aeadb6889018"
+                 "501d289e4900f7e4331b99dec4b5433ac7d329eeb6dd26545e96e55b874be909"}
+    };
+    static const sha256_impl_t impls[] = {SHA256_IMPL_GENERIC, SHA256_IMPL_SHANI};
+    char hex[2 * SHA512HashSize + 1];
+    int ok;
+
+    for (size_t i = 0; i < sizeof(impls) / sizeof(impls[0]); i++) {
+        if (SHA256SetImpl(impls[i]) != 0) {
+            printf("SHA-224/256 %-8s 不可用\n", SHA256ImplName(impls[i]));
+            continue;
+        }
+        ok = 1;
+        for (size_t v = 0; v < sizeof(vectors) / sizeof(vectors[0]); v++) {
+            if (vectors[v].bits > 256) continue;
+            sha2_hex(vectors[v].bits, vectors[v].two_block ? msg448 : "abc", hex);
+            ok = ok && strcmp(hex, vectors[v].expected) == 0;
+        }
+        printf("SHA-224/256 %-8s FIPS 180-4 测试向量: %s\n", SHA256ImplName(impls[i]), ok ? "通过" : "失败");
+    }
+    SHA256SetImpl(SHA256_IMPL_AUTO);
+
+    ok = 1;
+    for (size_t v = 0; v < sizeof(vectors) / sizeof(vectors[0]); v++) {
+        if (vectors[v].bits <= 256) continue;
+        sha2_hex(vectors[v].bits, vectors[v].two_block ? msg896 : "abc", hex);
+        ok = ok && strcmp(hex, vectors[v].expected) == 0;
+    }
+    printf("SHA-384/512 FIPS 180-4 测试向量: %s\n", ok ? "通过" : "失败");
+
+    sha2_hex(256, "abc", hex);
+    printf("SHA256(\"abc\") = %s\n", hex);
+    printf("Expected:        %s\n", vectors[2].expected);
+}
+
+// 多缓冲 SHA-256：长短不一的消息，结果应与逐条计算相同
+void call_sha256_many() {
+    enum { NMSGS = 100 };
+    static uint8_t data[NMSGS * 200];
+    const uint8_t *msgs[NMSGS];
+    size_t lens[NMSGS];
+    uint8_t digests[NMSGS][SHA256HashSize], expected[SHA256HashSize];
+    int ok = 1;
+
+    for (size_t i = 0; i < sizeof(data); i++) {
+        data[i] = (uint8_t) (i * 151 + 3);
+    }
+    msgs[0] = (const uint8_t *) "abc";
+    lens[0] = 3;
+    for (size_t i = 1; i < NMSGS; i++) {
+        msgs[i] = data + i * 200;
+        lens[i] = (i * 41) % 200;
+    }
+
+    SHA256HashMany(msgs, lens, NMSGS, digests);
+    for (size_t i = 0; i < NMSGS; i++) {
+        SHA256Context sha;
+
+        SHA256Reset(&sha);
+        SHA256Input(&sha, msgs[i], lens[i]);
+        SHA256Result(&sha, expected);
+        ok = ok && memcmp(digests[i], expected, SHA256HashSize) == 0;
+    }
+    print_hex_digest("SHA256HashMany(\"abc\")", digests[0], SHA256HashSize);
+    printf("多缓冲 SHA-256 (%u 路) %d 条消息: %s\n", SHA256MBLanes(), NMSGS, ok ? "通过" : "失败");
+}
+
+// HMAC：RFC 2202 测试用例，密钥为 key_len 个 key_byte (用例2为 "Jefe")
+void call_hmac() {
+    static const struct {
+        unsigned char key_byte;
+        size_t md5_key_len, sha1_key_len;
+        const char *msg; // NULL 表示50个 0xdd
+        const char *md5, *sha1;
+    } vectors[] = {
+        {0x0b, 16, 20, "Hi There",
+         "9294727a3638bb1c13f48ef8158bfc9d", "b617318655057264e28bc0b6fb378c8ef146be00"},
+        {0, 4, 4, "what do ya want for nothing?",
+         "750c783e6ab0b503eaa86e310a5db738", "effcdf6ae5eb2fa2d27416d5f184df9c259a7c79"},
+        {0xaa, 16, 20, NULL,
+         "56be34521d144c88dbb8c733f0e8b3f6", "125d7342b9ac11cd91a39af48aa17b4f63f175d3"},
+        {0xaa, 80, 80, "Test Using Larger Than Block-Size Key - Hash Key First",
+         "6b1ab7fe4bd7bf8f0b62e6ce61b9d0cd", "aa4ae5e15272d00e95705637ce8a3b55ed402112"},
+        {0xaa, 80, 80, "Test Using Larger Than Block-Size Key and Larger Than One Block-Size Data",
+         "6f630fad67cda0ee1fb1f562db3aa53e", "e8e99d0f45237d786d6bbaa7965c7808bbff1a91"}
+    };
+    unsigned char key[80], dd[50];
+    char hex[2 * SHA1HashSize + 1];
+    int ok_md5 = 1, ok_sha1 = 1;
+
+    memset(dd, 0xdd, sizeof(dd));
+    for (size_t v = 0; v < sizeof(vectors) / sizeof(vectors[0]); v++) {
+        const unsigned char *msg = vectors[v].msg ? (const unsigned char *) vectors[v].msg : dd;
+        size_t len = vectors[v].msg ? strlen(vectors[v].msg) : sizeof(dd);
+        HMAC_MD5_KEY md5_key;
+        HMACSHA1Key sha1_key;
+        HMACSHA1Context sha1_ctx;
+        md5_byte_t md5_mac[HMAC_MD5_SIZE];
+        uint8_t sha1_mac[SHA1HashSize];
+
+        if (v == 1) {
+            memcpy(key, "Jefe", 4);
+        } else {
+            memset(key, vectors[v].key_byte, sizeof(key));
+        }
+
+        HMAC_MD5_SetKey(&md5_key, key, vectors[v].md5_key_len);
+        HMAC_MD5(&md5_key, msg, len, md5_mac);
+        MD5_ToHexString(md5_mac, hex, sizeof(hex));
+        ok_md5 = ok_md5 && strcmp(hex, vectors[v].md5) == 0;
+
+        // SHA-1 用分两次 Input 的流式接口，同时验证同一个密钥可重复使用
+        HMACSHA1SetKey(&sha1_key, key, vectors[v].sha1_key_len);
+        for (int round = 0; round < 2; round++) {
+            HMACSHA1Reset(&sha1_ctx, &sha1_key);
+            HMACSHA1Input(&sha1_ctx, msg, len / 3);
+            HMACSHA1Input(&sha1_ctx, msg + len / 3, len - len / 3);
+            HMACSHA1Result(&sha1_ctx, sha1_mac);
+            for (int j = 0; j < SHA1HashSize; j++) {
+                snprintf(hex + 2 * j, 3, "%02x", sha1_mac[j]);
+            }
+            ok_sha1 = ok_sha1 && strcmp(hex, vectors[v].sha1) == 0;
+        }
+        HMAC_MD5_KeyWipe(&md5_key);
+        HMACSHA1KeyWipe(&sha1_key);
+    }
+    printf("HMAC-MD5  RFC 2202 测试向量: %s\n", ok_md5 ? "通过" : "失败");
+    printf("HMAC-SHA1 RFC 2202 测试向量: %s\n", ok_sha1 ? "通过" : "失败");
+}
+
+// 返回当前时间（秒），用于性能测试计时
+static double now_seconds(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double) ts.tv_sec + (double) ts.tv_nsec / 1e9;
+}
+
+// 反复执行 fn 至少0.2秒，返回吞吐量 (MB/s)
+static double measure_throughput(void (*fn)(void *arg), void *arg, size_t bytes_per_call) {
+    double start = now_seconds(), elapsed;
+    size_t calls = 0;
+
+    do {
+        fn(arg);
+        calls++;
+        elapsed = now_seconds() - start;
+    } while (elapsed < 0.2);
+
+    return (double) bytes_per_call * (double) calls / elapsed / 1e6;
+}
+
+// AES 性能测试参数
+typedef struct {
+    aes_ctx ctx;
+    unsigned char *buf;
+    size_t nblocks;
+} aes_bench_arg;
+
+static void aes_bench_encrypt(void *arg) {
+    aes_bench_arg *a = (aes_bench_arg *) arg;
+    aes_encrypt_blocks(&a->ctx, a->buf, a->buf, a->nblocks);
+}
+
+static void aes_bench_decrypt(void *arg) {
+    aes_bench_arg *a = (aes_bench_arg *) arg;
+    aes_decrypt_blocks(&a->ctx, a->buf, a->buf, a->nblocks);
+}
+
+// 比较各 AES 实现在各密钥长度下的加解密吞吐量
+void bench_aes() {
+    static const aes_impl_t impls[] = {AES_IMPL_REF, AES_IMPL_TTABLE, AES_IMPL_BITSLICE, AES_IMPL_AESNI};
+    static const size_t key_lens[] = {16, 24, 32};
+    unsigned char key[32] = "0123456789abcdef0123456789abcdef";
+    aes_bench_arg arg;
+
+    arg.nblocks = 4096; // 64 KiB
+    arg.buf = (unsigned char *) calloc(arg.nblocks, AES_BLOCK_SIZE);
+    if (!arg.buf) return;
+
+    printf("--- AES Benchmark (64 KiB buffer) ---\n");
+    for (size_t i = 0; i < sizeof(impls) / sizeof(impls[0]); i++) {
+        if (aes_set_impl(impls[i]) != 0) {
+            printf("%-10s 不可用\n", aes_impl_name(impls[i]));
+            continue;
+        }
+        for (size_t k = 0; k < sizeof(key_lens) / sizeof(key_lens[0]); k++) {
+            aes_init_key(&arg.ctx, key, key_lens[k]);
+            printf("%-10s AES-%zu 加密 %8.1f MB/s  解密 %8.1f MB/s\n", aes_impl_name(impls[i]), key_lens[k] * 8,
+                   measure_throughput(aes_bench_encrypt, &arg, arg.nblocks * AES_BLOCK_SIZE),
+                   measure_throughput(aes_bench_decrypt, &arg, arg.nblocks * AES_BLOCK_SIZE));
+            aes_wipe(&arg.ctx);
+        }
+    }
+    aes_set_impl(AES_IMPL_AUTO);
+
+    free(arg.buf);
+}
+
+static void cbc_bench_encrypt(void *arg) {
+    aes_bench_arg *a = (aes_bench_arg *) arg;
+    unsigned char iv[AES_BLOCK_SIZE] = {0};
+    aes_cbc_encrypt_blocks(&a->ctx, iv, a->buf, a->buf, a->nblocks);
+}
+
+static void cbc_bench_decrypt(void *arg) {
+    aes_bench_arg *a = (aes_bench_arg *) arg;
+    unsigned char iv[AES_BLOCK_SIZE] = {0};
+    aes_cbc_decrypt_blocks(&a->ctx, iv, a->buf, a->buf, a->nblocks);
+}
+
+// AES-CBC 串行加密与并行解密的吞吐量
+void bench_aes_cbc() {
+    unsigned char key[16] = "0123456789abcdef";
+    aes_bench_arg arg;
+
+    arg.nblocks = 4096; // 64 KiB
+    arg.buf = (unsigned char *) calloc(arg.nblocks, AES_BLOCK_SIZE);
+    if (!arg.buf) return;
+
+    printf("--- AES-CBC Benchmark (64 KiB buffer, %s) ---\n", aes_impl_name(aes_get_impl()));
+    aes_init(&arg.ctx, key);
+    printf("加密 %8.1f MB/s  解密 %8.1f MB/s\n",
+           measure_throughput(cbc_bench_encrypt, &arg, arg.nblocks * AES_BLOCK_SIZE),
+           measure_throughput(cbc_bench_decrypt, &arg, arg.nblocks * AES_BLOCK_SIZE));
+    aes_wipe(&arg.ctx);
+
+    free(arg.buf);
+}
+
+// AES-CTR 性能测试参数
+typedef struct {
+    aes_ctr_ctx ctx;
+    unsigned char *buf;
+    size_t len;
+} ctr_bench_arg;
+
+static void ctr_bench_crypt(void *arg) {
+    ctr_bench_arg *a = (ctr_bench_arg *) arg;
+    aes_ctr_crypt(&a->ctx, a->buf, a->buf, a->len);
+}
+
+// 比较 AES-CTR 单线程与多线程吞吐量
+void bench_aes_ctr() {
+    unsigned char key[16] = "0123456789abcdef";
+    unsigned char iv[16] = {0};
+    ctr_bench_arg arg;
+
+    arg.len = 16u << 20; // 16 MiB
+    arg.buf = (unsigned char *) calloc(arg.len, 1);
+    if (!arg.buf) return;
+
+    printf("--- AES-CTR Benchmark (16 MiB buffer, %s) ---\n", aes_impl_name(aes_get_impl()));
+    aes_ctr_init(&arg.ctx, key, iv);
+    aes_ctr_set_parallel(&arg.ctx, 0, 1);
+    printf("单线程     %8.1f MB/s\n", measure_throughput(ctr_bench_crypt, &arg, arg.len));
+    aes_ctr_init(&arg.ctx, key, iv);
+    printf("%-2u 线程    %8.1f MB/s\n", arg.ctx.mt_threads, measure_throughput(ctr_bench_crypt, &arg, arg.len));
+    aes_ctr_wipe(&arg.ctx);
+
+    free(arg.buf);
+}
+
+// AES-GCM 性能测试参数
+typedef struct {
+    aes_gcm_ctx ctx;
+    unsigned char *buf;
+    size_t len;
+} gcm_bench_arg;
+
+static void gcm_bench_encrypt(void *arg) {
+    gcm_bench_arg *a = (gcm_bench_arg *) arg;
+    unsigned char iv[12] = {0};
+    unsigned char tag[AES_GCM_TAG_SIZE];
+    aes_gcm_encrypt(&a->ctx, iv, sizeof(iv), NULL, 0, a->buf, a->buf, a->len, tag, sizeof(tag));
+}
+
+// 比较两种 GHASH 实现下 AES-GCM 的吞吐量
+void bench_aes_gcm() {
+    static const char *ghash_impls[] = {"table", "clmul"};
+    unsigned char key[16] = "0123456789abcdef";
+    gcm_bench_arg arg;
+
+    arg.len = 64u << 10; // 64 KiB
+    arg.buf = (unsigned char *) calloc(arg.len, 1);
+    if (!arg.buf) return;
+
+    printf("--- AES-GCM Benchmark (64 KiB buffer, %s) ---\n", aes_impl_name(aes_get_impl()));
+    for (size_t i = 0; i < sizeof(ghash_impls) / sizeof(ghash_impls[0]); i++) {
+        setenv("GHASH_IMPL", ghash_impls[i], 1);
+        aes_gcm_init(&arg.ctx, key);
+        if (strcmp(aes_gcm_ghash_name(&arg.ctx), ghash_impls[i]) != 0) {
+            printf("%-10s 不可用\n", ghash_impls[i]);
+            continue;
+        }
+        printf("%-10s %8.1f MB/s\n", ghash_impls[i], measure_throughput(gcm_bench_encrypt, &arg, arg.len));
+        aes_gcm_wipe(&arg.ctx);
+    }
+    unsetenv("GHASH_IMPL");
+
+    free(arg.buf);
+}
+
+// XTS 性能测试参数
+typedef struct {
+    aes_xts_ctx ctx;
+    unsigned char *buf;
+    size_t nsectors;
+} xts_bench_arg;
+
+static void xts_bench_encrypt(void *arg) {
+    xts_bench_arg *a = (xts_bench_arg *) arg;
+    aes_xts_encrypt_sectors(&a->ctx, 0, a->buf, a->buf, a->nsectors);
+}
+
+// 比较 XTS-AES-128 (4 KiB 扇区) 单线程与多线程吞吐量
+void bench_aes_xts() {
+    unsigned char key[32] = "0123456789abcdef fedcba987654321";
+    xts_bench_arg arg;
+    size_t sector_size = 4096;
+
+    arg.nsectors = 4096; // 16 MiB
+    arg.buf = (unsigned char *) calloc(arg.nsectors, sector_size);
+    if (!arg.buf) return;
+
+    printf("--- XTS-AES Benchmark (16 MiB, 4 KiB sectors, %s) ---\n", aes_impl_name(aes_get_impl()));
+    aes_xts_init(&arg.ctx, key, sizeof(key), sector_size);
+    aes_xts_set_parallel(&arg.ctx, 0, 1);
+    printf("单线程     %8.1f MB/s\n", measure_throughput(xts_bench_encrypt, &arg, arg.nsectors * sector_size));
+    aes_xts_init(&arg.ctx, key, sizeof(key), sector_size);
+    printf("%-2u 线程    %8.1f MB/s\n", arg.ctx.mt_threads,
+           measure_throughput(xts_bench_encrypt, &arg, arg.nsectors * sector_size));
+    aes_xts_wipe(&arg.ctx);
+
+    free(arg.buf);
+}
+
+// DES 性能测试参数
+typedef struct {
+    DES_key_schedule schedule;
+    unsigned char *buf;
+    size_t nblocks;
+    size_t batch;       // des_bench_ecb_batched 每次调用的分组数
+} des_bench_arg;
+
+static void des_bench_scalar(void *arg) {
+    des_bench_arg *a = (des_bench_arg *) arg;
+    for (size_t i = 0; i < a->nblocks; i++) {
+        DES_ecb_encrypt((const DES_cblock *) (a->buf + i * 8), (DES_cblock *) (a->buf + i * 8), &a->schedule,
+                        DES_ENCRYPT);
+    }
+}
+
+static void des_bench_ecb(void *arg) {
+    des_bench_arg *a = (des_bench_arg *) arg;
+    DES_ecb_encrypt_blocks(a->buf, a->buf, a->nblocks, &a->schedule, DES_ENCRYPT);
+}
+
+static void des_bench_ecb_batched(void *arg) {
+    des_bench_arg *a = (des_bench_arg *) arg;
+    for (size_t i = 0; i + a->batch <= a->nblocks; i += a->batch) {
+        DES_ecb_encrypt_blocks(a->buf + i * 8, a->buf + i * 8, a->batch, &a->schedule, DES_ENCRYPT);
+    }
+}
+
+static void des_bench_cbc_encrypt(void *arg) {
+    des_bench_arg *a = (des_bench_arg *) arg;
+    DES_cblock iv = {0};
+    DES_cbc_encrypt_blocks(a->buf, a->buf, a->nblocks, &a->schedule, &iv, DES_ENCRYPT);
+}
+
+static void des_bench_cbc_decrypt(void *arg) {
+    des_bench_arg *a = (des_bench_arg *) arg;
+    DES_cblock iv = {0};
+    DES_cbc_encrypt_blocks(a->buf, a->buf, a->nblocks, &a->schedule, &iv, DES_DECRYPT);
+}
+
+static void des_bench_ctr(void *arg) {
+    des_bench_arg *a = (des_bench_arg *) arg;
+    DES_cblock counter = {0};
+    DES_ctr_encrypt(a->buf, a->buf, a->nblocks * 8, &a->schedule, &counter);
+}
+
+static void des_bench_bitslice(void *arg) {
+    des_bench_arg *a = (des_bench_arg *) arg;
+    DES_bs_ecb_encrypt(a->buf, a->buf, a->nblocks, &a->schedule, DES_ENCRYPT);
+}
+
+// 比较逐块调用、多分组模式接口与各宽度位切片 DES 的吞吐量
+void bench_des() {
+    static const unsigned int lanes[] = {64, 128, 256};
+    static const size_t batches[] = {64, 256};
+    DES_cblock key = "mysecret";
+    des_bench_arg arg;
+
+    arg.nblocks = 8192; // 64 KiB
+    arg.buf = (unsigned char *) calloc(arg.nblocks, 8);
+    if (!arg.buf) return;
+
+    printf("--- DES Benchmark (64 KiB buffer) ---\n");
+    DES_set_key(&key, &arg.schedule);
+    printf("逐块调用   %8.1f MB/s\n", measure_throughput(des_bench_scalar, &arg, arg.nblocks * 8));
+    printf("ECB        %8.1f MB/s\n", measure_throughput(des_bench_ecb, &arg, arg.nblocks * 8));
+    printf("CBC 加密   %8.1f MB/s  解密 %8.1f MB/s\n",
+           measure_throughput(des_bench_cbc_encrypt, &arg, arg.nblocks * 8),
+           measure_throughput(des_bench_cbc_decrypt, &arg, arg.nblocks * 8));
+    printf("CTR        %8.1f MB/s\n", measure_throughput(des_bench_ctr, &arg, arg.nblocks * 8));
+    for (size_t i = 0; i < sizeof(lanes) / sizeof(lanes[0]); i++) {
+        if (DES_bs_set_lanes(lanes[i]) != 0) {
+            printf("位切片x%-3u 不可用\n", lanes[i]);
+            continue;
+        }
+        printf("位切片x%-3u %8.1f MB/s\n", lanes[i], measure_throughput(des_bench_bitslice, &arg, arg.nblocks * 8));
+    }
+    // 小批量 ECB：批量不足一整批或宽度低于 DES_BITSLICE_MIN_LANES 时走标量路径
+    for (size_t i = 0; i < sizeof(lanes) / sizeof(lanes[0]); i++) {
+        if (DES_bs_set_lanes(lanes[i]) != 0) {
+            continue;
+        }
+        for (size_t b = 0; b < sizeof(batches) / sizeof(batches[0]); b++) {
+            arg.batch = batches[b];
+            printf("ECB x%-3zu 块 (位切片上限 %-3u) %8.1f MB/s\n", batches[b], lanes[i],
+                   measure_throughput(des_bench_ecb_batched, &arg, arg.nblocks * 8));
+        }
+    }
+    DES_bs_set_lanes(0);
+
+    free(arg.buf);
+}
+
+// 3DES 性能测试参数
+typedef struct {
+    DES_key_schedule ks[3];
+    DES_EDE_key_schedule ede;
+    unsigned char *buf;
+    size_t nblocks;
+} des3_bench_arg;
+
+// 三次调用单 DES：每个分组做3次 IP 和3次 FP
+static void des3_bench_chained(void *arg) {
+    des3_bench_arg *a = (des3_bench_arg *) arg;
+    for (size_t i = 0; i < a->nblocks; i++) {
+        DES_cblock *block = (DES_cblock *) (a->buf + i * 8);
+        DES_ecb_encrypt((const DES_cblock *) block, block, &a->ks[0], DES_ENCRYPT);
+        DES_ecb_encrypt((const DES_cblock *) block, block, &a->ks[1], DES_DECRYPT);
+        DES_ecb_encrypt((const DES_cblock *) block, block, &a->ks[2], DES_ENCRYPT);
+    }
+}
+
+static void des3_bench_fused(void *arg) {
+    des3_bench_arg *a = (des3_bench_arg *) arg;
+    for (size_t i = 0; i < a->nblocks; i++) {
+        DES_cblock *block = (DES_cblock *) (a->buf + i * 8);
+        DES_ede3_ecb_encrypt((const DES_cblock *) block, block, &a->ede, DES_ENCRYPT);
+    }
+}
+
+// 比较三次单 DES 调用与融合后的48轮 3DES
+void bench_des_ede3() {
+    DES_cblock k1 = "mysecret", k2 = "Gemini12", k3 = "3des-key";
+    des3_bench_arg arg;
+
+    arg.nblocks = 8192; // 64 KiB
+    arg.buf = (unsigned char *) calloc(arg.nblocks, 8);
+    if (!arg.buf) return;
+
+    printf("--- 3DES Benchmark (64 KiB buffer) ---\n");
+    DES_set_key(&k1, &arg.ks[0]);
+    DES_set_key(&k2, &arg.ks[1]);
+    DES_set_key(&k3, &arg.ks[2]);
+    DES_set_key_ede3(&k1, &k2, &k3, &arg.ede);
+    printf("三次 DES   %8.1f MB/s\n", measure_throughput(des3_bench_chained, &arg, arg.nblocks * 8));
+    printf("融合 EDE3  %8.1f MB/s\n", measure_throughput(des3_bench_fused, &arg, arg.nblocks * 8));
+
+    free(arg.buf);
+}
+
+// 密钥敏捷性：连续设置一百万个不同的密钥
+void bench_des_key_setup() {
+    const size_t nkeys = 1000000;
+    DES_key_schedule schedule;
+    DES_cblock key = "mysecret";
+    uint64_t check = 0;
+    double start, elapsed;
+
+    printf("--- DES Key Setup Benchmark (%zu keys) ---\n", nkeys);
+    start = now_seconds();
+    for (size_t i = 0; i < nkeys; i++) {
+        key[4] = (unsigned char) (i >> 16);
+        key[5] = (unsigned char) (i >> 8);
+        key[6] = (unsigned char) i;
+        DES_set_key(&key, &schedule);
+        check += schedule.subkeys[15];
+    }
+    elapsed = now_seconds() - start;
+    printf("DES_set_key %8.3f s  %8.2f M keys/s  (校验 %016llx)\n", elapsed, (double) nkeys / elapsed / 1e6,
+           (unsigned long long) check);
+}
+
+// 密钥搜索速度：在不含答案的范围内检验 2^24 个密钥
+void bench_des_keysearch() {
+    DES_cblock plaintext = "Gemini12", ciphertext = {0};
+    des_keysearch_params params;
+    des_keysearch_result result;
+    unsigned int threads[2] = {1, 0};
+
+    printf("--- DES Key Search Benchmark (2^24 keys, %u 路) ---\n", DES_bs_lanes());
+    des_keysearch_init(&params, &plaintext, &ciphertext, 0, 1u << 24);
+    for (size_t i = 0; i < 2; i++) {
+        params.nthreads = threads[i] ? threads[i] : parallel_default_threads();
+        des_keysearch_run(&params, &result);
+        printf("%-2u 线程    %8.2f M keys/s\n", params.nthreads, result.keys_per_sec / 1e6);
+    }
+}
+
+// 多缓冲 MD5 性能测试参数
+typedef struct {
+    const md5_byte_t **msgs;
+    size_t *lens;
+    size_t n;
+    md5_byte_t (*digests)[16];
+} md5_bench_arg;
+
+static void md5_bench_many(void *arg) {
+    md5_bench_arg *a = (md5_bench_arg *) arg;
+    MD5_HashMany(a->msgs, a->lens, a->n, a->digests);
+}
+
+// 比较逐条计算 (1路) 与各宽度多缓冲 MD5 处理大量短消息和 1 KiB 消息的速度
+void bench_md5_many() {
+    static const unsigned int lanes[] = {1, 4, 8, 16};
+    static const size_t sizes[] = {32, 1024};
+    const size_t total = 4u << 20;
+    md5_bench_arg arg;
+    md5_byte_t *buf = (md5_byte_t *) calloc(total, 1);
+
+    arg.n = total / sizes[0];
+    arg.msgs = (const md5_byte_t **) malloc(arg.n * sizeof(*arg.msgs));
+    arg.lens = (size_t *) malloc(arg.n * sizeof(*arg.lens));
+    arg.digests = (md5_byte_t (*)[16]) malloc(arg.n * 16);
+    if (buf && arg.msgs && arg.lens && arg.digests) {
+        for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+            arg.n = total / sizes[s];
+            for (size_t i = 0; i < arg.n; i++) {
+                arg.msgs[i] = buf + i * sizes[s];
+                arg.lens[i] = sizes[s];
+            }
+            printf("--- MD5 Multi-Buffer Benchmark (%zu x %zu B) ---\n", arg.n, sizes[s]);
+            for (size_t i = 0; i < sizeof(lanes) / sizeof(lanes[0]); i++) {
+                double mbps;
+
+                if (MD5_mb_set_lanes(lanes[i]) != 0) {
+                    printf("%-2u 路      不可用\n", lanes[i]);
+                    continue;
+                }
+                mbps = measure_throughput(md5_bench_many, &arg, total);
+                printf("%-2u 路    %8.1f MB/s  %8.2f M msgs/s\n", lanes[i], mbps, mbps / (double) sizes[s]);
+            }
+        }
+        MD5_mb_set_lanes(0);
+    }
+
+    free(arg.digests);
+    free(arg.lens);
+    free(arg.msgs);
+    free(buf);
+}
+
+// 文件哈希性能测试参数
+typedef struct {
+    const char *path;
+    unsigned int flags;
+} file_bench_arg;
+
+static void file_bench_md5(void *arg) {
+    file_bench_arg *a = (file_bench_arg *) arg;
+    md5_byte_t digest[16];
+    MD5_File(a->path, a->flags, digest);
+}
+
+// 比较 mmap 与 read 两种方式读取 64 MiB 文件 (已在页缓存中) 计算 MD5 的速度
+void bench_file_hash() {
+    const size_t size = 64u << 20;
+    char path[] = "/tmp/file_hash_bench_XXXXXX";
+    unsigned char *buf = (unsigned char *) calloc(size, 1);
+    file_bench_arg arg;
+    int fd;
+
+    if (!buf) return;
+    fd = mkstemp(path);
+    if (fd < 0 || write(fd, buf, size) != (ssize_t) size) {
+        if (fd >= 0) {
+            close(fd);
+            unlink(path);
+        }
+        free(buf);
+        return;
+    }
+    close(fd);
+    free(buf);
+
+    printf("--- MD5 File Benchmark (64 MiB file) ---\n");
+    arg.path = path;
+    arg.flags = 0;
+    printf("mmap       %8.1f MB/s\n", measure_throughput(file_bench_md5, &arg, size));
+    arg.flags = FILE_HASH_HUGEPAGES;
+    printf("mmap+大页  %8.1f MB/s\n", measure_throughput(file_bench_md5, &arg, size));
+    arg.flags = FILE_HASH_NO_MMAP;
+    printf("read       %8.1f MB/s\n", measure_throughput(file_bench_md5, &arg, size));
+    unlink(path);
+}
+
+// SHA-1 性能测试参数
+typedef struct {
+    unsigned char *buf;
+    size_t len;
+    size_t chunk;
+} sha1_bench_arg;
+
+static void sha1_bench_input(void *arg) {
+    sha1_bench_arg *a = (sha1_bench_arg *) arg;
+    SHA1Context sha;
+    uint8_t digest[SHA1HashSize];
+
+    SHA1Reset(&sha);
+    for (size_t off = 0; off < a->len; off += a->chunk) {
+        SHA1Input(&sha, a->buf + off, a->len - off < a->chunk ? a->len - off : a->chunk);
+    }
+    SHA1Result(&sha, digest);
+}
+
+// 比较 SHA-1 各实现的吞吐量：一次传入整个缓冲区，以及每次传入一小段 (不与分组对齐)
+void bench_sha1() {
+    static const sha1_impl_t impls[] = {SHA1_IMPL_GENERIC, SHA1_IMPL_SSSE3, SHA1_IMPL_AVX2, SHA1_IMPL_SHANI};
+    sha1_bench_arg arg;
+
+    arg.len = 1u << 20; // 1 MiB
+    arg.buf = (unsigned char *) calloc(arg.len, 1);
+    if (!arg.buf) return;
+
+    printf("--- SHA-1 Benchmark (1 MiB buffer) ---\n");
+    for (size_t i = 0; i < sizeof(impls) / sizeof(impls[0]); i++) {
+        double bulk;
+
+        if (SHA1SetImpl(impls[i]) != 0) {
+            printf("%-10s 不可用\n", SHA1ImplName(impls[i]));
+            continue;
+        }
+        arg.chunk = arg.len;
+        bulk = measure_throughput(sha1_bench_input, &arg, arg.len);
+        arg.chunk = 100;
+        printf("%-10s %8.1f MB/s  100 字节段 %8.1f MB/s\n", SHA1ImplName(impls[i]), bulk,
+               measure_throughput(sha1_bench_input, &arg, arg.len));
+    }
+    SHA1SetImpl(SHA1_IMPL_AUTO);
+
+    free(arg.buf);
+}
+
+// 多缓冲 SHA-1 性能测试参数
+typedef struct {
+    const uint8_t **msgs;
+    size_t *lens;
+    size_t n;
+    uint8_t (*digests)[SHA1HashSize];
+} sha1_mb_bench_arg;
+
+static void sha1_bench_many(void *arg) {
+    sha1_mb_bench_arg *a = (sha1_mb_bench_arg *) arg;
+    SHA1HashMany(a->msgs, a->lens, a->n, a->digests);
+}
+
+// 比较逐条计算 (1路，使用当前 SHA1ProcessBlocks 实现) 与各宽度多缓冲 SHA-1 处理短消息和 1 KiB 消息的速度
+void bench_sha1_many() {
+    static const unsigned int lanes[] = {1, 4, 8, 16};
+    static const size_t sizes[] = {32, 1024};
+    const size_t total = 4u << 20;
+    sha1_mb_bench_arg arg;
+    uint8_t *buf = (uint8_t *) calloc(total, 1);
+
+    arg.n = total / sizes[0];
+    arg.msgs = (const uint8_t **) malloc(arg.n * sizeof(*arg.msgs));
+    arg.lens = (size_t *) malloc(arg.n * sizeof(*arg.lens));
+    arg.digests = (uint8_t (*)[SHA1HashSize]) malloc(arg.n * SHA1HashSize);
+    if (buf && arg.msgs && arg.lens && arg.digests) {
+        for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+            arg.n = total / sizes[s];
+            for (size_t i = 0; i < arg.n; i++) {
+                arg.msgs[i] = buf + i * sizes[s];
+                arg.lens[i] = sizes[s];
+            }
+            printf("--- SHA-1 Multi-Buffer Benchmark (%zu x %zu B, 逐条使用 %s) ---\n", arg.n, sizes[s],
+                   SHA1ImplName(SHA1GetImpl()));
+            for (size_t i = 0; i < sizeof(lanes) / sizeof(lanes[0]); i++) {
+                double mbps;
+
+                if (SHA1MBSetLanes(lanes[i]) != 0) {
+                    printf("%-2u 路      不可用\n", lanes[i]);
+                    continue;
+                }
+                mbps = measure_throughput(sha1_bench_many, &arg, total);
+                printf("%-2u 路    %8.1f MB/s  %8.2f M msgs/s\n", lanes[i], mbps, mbps / (double) sizes[s]);
+            }
+        }
+        SHA1MBSetLanes(0);
+    }
+
+    free(arg.digests);
+    free(arg.lens);
+    free(arg.msgs);
+    free(buf);
+}
+
+// SHA-2 性能测试参数，chunk 为每次传入的字节数
+typedef struct {
+    unsigned char *buf;
+    size_t len;
+    size_t chunk;
+} sha2_bench_arg;
+
+static void sha256_bench_input(void *arg) {
+    sha2_bench_arg *a = (sha2_bench_arg *) arg;
+    SHA256Context sha;
+    uint8_t digest[SHA256HashSize];
+
+    SHA256Reset(&sha);
+    for (size_t off = 0; off < a->len; off += a->chunk) {
+        SHA256Input(&sha, a->buf + off, a->len - off < a->chunk ? a->len - off : a->chunk);
+    }
+    SHA256Result(&sha, digest);
+}
+
+static void sha512_bench_input(void *arg) {
+    sha2_bench_arg *a = (sha2_bench_arg *) arg;
+    SHA512Context sha;
+    uint8_t digest[SHA512HashSize];
+
+    SHA512Reset(&sha);
+    for (size_t off = 0; off < a->len; off += a->chunk) {
+        SHA512Input(&sha, a->buf + off, a->len - off < a->chunk ? a->len - off : a->chunk);
+    }
+    SHA512Result(&sha, digest);
+}
+
+// 比较 SHA-256 各实现与 SHA-512 的吞吐量：一次传入整个缓冲区，以及每次传入一小段
+void bench_sha2() {
+    static const sha256_impl_t impls[] = {SHA256_IMPL_GENERIC, SHA256_IMPL_SHANI};
+    sha2_bench_arg arg;
+    double bulk;
+
+    arg.len = 1u << 20; // 1 MiB
+    arg.buf = (unsigned char *) calloc(arg.len, 1);
+    if (!arg.buf) return;
+
+    printf("--- SHA-2 Benchmark (1 MiB buffer) ---\n");
+    for (size_t i = 0; i < sizeof(impls) / sizeof(impls[0]); i++) {
+        if (SHA256SetImpl(impls[i]) != 0) {
+            printf("SHA-256 %-10s 不可用\n", SHA256ImplName(impls[i]));
+            continue;
+        }
+        arg.chunk = arg.len;
+        bulk = measure_throughput(sha256_bench_input, &arg, arg.len);
+        arg.chunk = 100;
+        printf("SHA-256 %-10s %8.1f MB/s  100 字节段 %8.1f MB/s\n", SHA256ImplName(impls[i]), bulk,
+               measure_throughput(sha256_bench_input, &arg, arg.len));
+    }
+    SHA256SetImpl(SHA256_IMPL_AUTO);
+
+    arg.chunk = arg.len;
+    bulk = measure_throughput(sha512_bench_input, &arg, arg.len);
+    arg.chunk = 100;
+    printf("SHA-512 %-10s %8.1f MB/s  100 字节段 %8.1f MB/s\n", "generic", bulk,
+           measure_throughput(sha512_bench_input, &arg, arg.len));
+
+    free(arg.buf);
+}
+
+// 多缓冲 SHA-256 性能测试参数
+typedef struct {
+    const uint8_t **msgs;
+    size_t *lens;
+    size_t n;
+    uint8_t (*digests)[SHA256HashSize];
+} sha256_mb_bench_arg;
+
+static void sha256_bench_many(void *arg) {
+    sha256_mb_bench_arg *a = (sha256_mb_bench_arg *) arg;
+    SHA256HashMany(a->msgs, a->lens, a->n, a->digests);
+}
+
+// 比较逐条计算 (1路，使用当前 SHA256ProcessBlocks 实现) 与各宽度多缓冲 SHA-256 处理短消息和 1 KiB 消息的速度
+void bench_sha256_many() {
+    static const unsigned int lanes[] = {1, 4, 8, 16};
+    static const size_t sizes[] = {32, 1024};
+    const size_t total = 4u << 20;
+    sha256_mb_bench_arg arg;
+    uint8_t *buf = (uint8_t *) calloc(total, 1);
+
+    arg.n = total / sizes[0];
+    arg.msgs = (const uint8_t **) malloc(arg.n * sizeof(*arg.msgs));
+    arg.lens = (size_t *) malloc(arg.n * sizeof(*arg.lens));
+    arg.digests = (uint8_t (*)[SHA256HashSize]) malloc(arg.n * SHA256HashSize);
+    if (buf && arg.msgs && arg.lens && arg.digests) {
+        for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+            arg.n = total / sizes[s];
+            for (size_t i = 0; i < arg.n; i++) {
+                arg.msgs[i] = buf + i * sizes[s];
+                arg.lens[i] = sizes[s];
+            }
+            printf("--- SHA-256 Multi-Buffer Benchmark (%zu x %zu B, 逐条使用 %s) ---\n", arg.n, sizes[s],
+                   SHA256ImplName(SHA256GetImpl()));
+            for (size_t i = 0; i < sizeof(lanes) / sizeof(lanes[0]); i++) {
+                double mbps;
+
+                if (SHA256MBSetLanes(lanes[i]) != 0) {
+                    printf("%-2u 路      不可用\n", lanes[i]);
+                    continue;
+                }
+                mbps = measure_throughput(sha256_bench_many, &arg, total);
+                printf("%-2u 路    %8.1f MB/s  %8.2f M msgs/s\n", lanes[i], mbps, mbps / (double) sizes[s]);
+            }
+        }
+        SHA256MBSetLanes(0);
+    }
+
+    free(arg.digests);
+    free(arg.lens);
+    free(arg.msgs);
+    free(buf);
+}
+
+// HMAC 性能测试参数：rekey 为1时每条消息都重新准备密钥 (即不复用内外层中间状态)
+typedef struct {
+    const unsigned char *key;
+    size_t key_len;
+    const unsigned char *msgs;
+    size_t msg_len;
+    size_t n;
+    int rekey;
+} hmac_bench_arg;
+
+static void hmac_md5_bench(void *arg) {
+    hmac_bench_arg *a = (hmac_bench_arg *) arg;
+    HMAC_MD5_KEY key;
+    md5_byte_t mac[HMAC_MD5_SIZE];
+
+    HMAC_MD5_SetKey(&key, a->key, a->key_len);
+    for (size_t i = 0; i < a->n; i++) {
+        if (a->rekey) HMAC_MD5_SetKey(&key, a->key, a->key_len);
+        HMAC_MD5(&key, a->msgs + i * a->msg_len, a->msg_len, mac);
+    }
+}
+
+static void hmac_sha1_bench(void *arg) {
+    hmac_bench_arg *a = (hmac_bench_arg *) arg;
+    HMACSHA1Key key;
+    uint8_t mac[SHA1HashSize];
+
+    HMACSHA1SetKey(&key, a->key, a->key_len);
+    for (size_t i = 0; i < a->n; i++) {
+        if (a->rekey) HMACSHA1SetKey(&key, a->key, a->key_len);
+        HMACSHA1(&key, a->msgs + i * a->msg_len, a->msg_len, mac);
+    }
+}
+
+// 比较复用准备好的密钥与每条消息重新准备密钥计算短消息 MAC 的速度
+void bench_hmac() {
+    static const size_t sizes[] = {64, 256, 1024};
+    static const unsigned char key[32] = "0123456789abcdef0123456789abcdef";
+    const size_t total = 1u << 20;
+    hmac_bench_arg arg;
+    unsigned char *buf = (unsigned char *) calloc(total, 1);
+
+    if (!buf) return;
+    arg.key = key;
+    arg.key_len = sizeof(key);
+    arg.msgs = buf;
+
+    printf("--- HMAC Benchmark (1 MiB 短消息, 每行: 复用密钥 / 每条重新准备密钥) ---\n");
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        double md5_fast, md5_slow, sha1_fast, sha1_slow;
+
+        arg.msg_len = sizes[s];
+        arg.n = total / sizes[s];
+        arg.rekey = 0;
+        md5_fast = measure_throughput(hmac_md5_bench, &arg, total);
+        sha1_fast = measure_throughput(hmac_sha1_bench, &arg, total);
+        arg.rekey = 1;
+        md5_slow = measure_throughput(hmac_md5_bench, &arg, total);
+        sha1_slow = measure_throughput(hmac_sha1_bench, &arg, total);
+        printf("%4zu B  HMAC-MD5 %6.2f / %6.2f M msgs/s  HMAC-SHA1 %6.2f / %6.2f M msgs/s\n", sizes[s],
+               md5_fast / (double) sizes[s], md5_slow / (double) sizes[s],
+               sha1_fast / (double) sizes[s], sha1_slow / (double) sizes[s]);
+    }
+
+    free(buf);
+}
+
+// 运行所有性能测试
+void run_benchmarks() {
+    bench_aes();
+    bench_aes_cbc();
+    bench_aes_ctr();
+    bench_aes_gcm();
+    bench_aes_xts();
+    bench_des();
+    bench_des_ede3();
+    bench_des_key_setup();
+    bench_des_keysearch();
+    bench_md5_many();
+    bench_file_hash();
+    bench_sha1();
+    bench_sha1_many();
+    bench_sha2();
+    bench_sha256_many();
+    bench_hmac();
+}
+
+static void keysearch_progress(const des_keysearch_progress *progress, void *user) {
+    (void) user;
+    printf("进度 %6.2f%%  %.2f M keys/s  已用 %.1f s\n",
+           progress->total ? 100.0 * (double) progress->done / (double) progress->total : 100.0,
+           progress->keys_per_sec / 1e6, progress->seconds);
+    fflush(stdout);
+}
+
+static int parse_block(const char *hex, DES_cblock block) {
+    if (strlen(hex) != 16) return -1;
+    for (int i = 0; i < 8; i++) {
+        if (sscanf(hex + 2 * i, "%2hhx", &block[i]) != 1) return -1;
+    }
     return 0;
 }
 
+// keysearch 子命令：<明文> <密文> <起始序号> <密钥个数> [线程数] [检查点文件]，分组为16位十六进制，序号和个数按十六进制解析
+static int run_keysearch(int argc, char *argv[]) {
+    DES_cblock plaintext, ciphertext;
+    des_keysearch_params params;
+    des_keysearch_result result;
+    int ret;
+
+    if (argc < 6 || parse_block(argv[2], plaintext) != 0 || parse_block(argv[3], ciphertext) != 0) {
+        printf("用法: %s keysearch <明文hex> <密文hex> <起始序号hex> <个数hex> [线程数] [检查点文件]\n", argv[0]);
+        return 2;
+    }
+    des_keysearch_init(&params, &plaintext, &ciphertext, strtoull(argv[4], NULL, 16), strtoull(argv[5], NULL, 16));
+    params.nthreads = argc > 6 ? (unsigned int) strtoul(argv[6], NULL, 10) : 0;
+    params.checkpoint = argc > 7 ? argv[7] : NULL;
+    params.progress = keysearch_progress;
+
+    ret = des_keysearch_run(&params, &result);
+    if (ret < 0) {
+        printf("检查点文件无法读写或与参数不符\n");
+        return 1;
+    }
+    if (result.resumed > 0) {
+        printf("从检查点恢复，跳过 %llu 个密钥\n", (unsigned long long) result.resumed);
+    }
+    printf("检验 %llu 个密钥，用时 %.2f s，%.2f M keys/s\n", (unsigned long long) result.tested, result.seconds,
+           result.keys_per_sec / 1e6);
+    if (ret == 1) {
+        printf("找到密钥序号 %014llx\n", (unsigned long long) result.index);
+        print_hex_digest("密钥", result.key, sizeof(DES_cblock));
+        return 0;
+    }
+    printf("范围内未找到密钥\n");
+    return 1;
+}
+
+// hashfile 子命令的回调：一次读取同时计算 MD5 和 SHA-1
+typedef struct {
+    MD5_CTX md5;
+    SHA1Context sha1;
+} hashfile_ctx;
+
+static void hashfile_update(void *ctx, const unsigned char *data, size_t len) {
+    hashfile_ctx *h = (hashfile_ctx *) ctx;
+    MD5_Update(&h->md5, data, len);
+    SHA1Input(&h->sha1, data, len);
+}
+
+static int run_hashfile(int argc, char *argv[]) {
+    unsigned int flags = 0;
+    int ret = 0, nfiles = 0;
+
+    for (int i = 2; i < argc; i++) {
+        hashfile_ctx ctx;
+        md5_byte_t md5[16];
+        uint8_t sha1[SHA1HashSize];
+        char hex[33];
+        uint64_t total;
+        double start;
+
+        if (strcmp(argv[i], "--hugepages") == 0) {
+            flags |= FILE_HASH_HUGEPAGES;
+            continue;
+        }
+        if (strcmp(argv[i], "--no-mmap") == 0) {
+            flags |= FILE_HASH_NO_MMAP;
+            continue;
+        }
+        nfiles++;
+        MD5_Init(&ctx.md5);
+        SHA1Reset(&ctx.sha1);
+        start = now_seconds();
+        if (file_hash_path(argv[i], flags, hashfile_update, &ctx, &total) != 0) {
+            perror(argv[i]);
+            ret = 1;
+            continue;
+        }
+        MD5_Final(md5, &ctx.md5);
+        SHA1Result(&ctx.sha1, sha1);
+        MD5_ToHexString(md5, hex, sizeof(hex));
+        printf("%s  %s  (%llu 字节, %.2f s)\n", hex, argv[i], (unsigned long long) total, now_seconds() - start);
+        print_hex_digest("SHA1", sha1, SHA1HashSize);
+    }
+    if (nfiles == 0) {
+        printf("用法: %s hashfile [--hugepages] [--no-mmap] <文件|-> ...\n", argv[0]);
+        return 2;
+    }
+    return ret;
+}
+
+int main(int argc, char *argv[]) {
+    // "bench" 参数只运行性能测试
+    if (argc > 1 && strcmp(argv[1], "bench") == 0) {
+        run_benchmarks();
+        return 0;
+    }
+    if (argc > 1 && strcmp(argv[1], "keysearch") == 0) {
+        return run_keysearch(argc, argv);
+    }
+    if (argc > 1 && strcmp(argv[1], "hashfile") == 0) {
+        return run_hashfile(argc, argv);
+    }
 
-int main() {
     char content[] = "Gemini12";
 
     run_test("MD5", call_md5, content);
+    call_md5_many();
+    call_file_hash();
     run_test("SHA1", call_sha1, content);
+    call_sha1_impls();
+    call_sha1_many();
+    call_sha2();
+    call_sha256_many();
+    call_hmac();
     // DES 测试封装到 run_test 中
     run_test("DES", call_des, content);
 
     printf("\n--- DES Test ---\n");
     call_des(content, strlen(content));
+    call_des_modes();
+    call_des_bitslice();
+    call_des_keysearch();
+    printf("\n--- 3DES Test ---\n");
+    call_des_ede3();
     printf("\n--- AES Test ---\n");
     call_aes();
+    printf("\n--- AES-CBC Test ---\n");
+    call_aes_cbc();
+    printf("\n--- AES-CTR Test ---\n");
+    call_aes_ctr();
+    printf("\n--- AES-GCM Test ---\n");
+    call_aes_gcm();
+    printf("\n--- XTS-AES Test ---\n");
+    call_aes_xts();
 
     return 0;
 }
@@ -7,6 +7,14 @@
 #include <stdio.h>
 #include <string.h>
 
+/* MD5 转换核心函数 */
+static void MD5_Transform(md5_word_t state[4], const md5_byte_t block[64]);
+
+/* 字节序转换函数 */
+static void Encode(md5_byte_t *output, const md5_word_t *input, size_t length);
+
+static void Decode(md5_word_t *output, const md5_byte_t *input, size_t length);
+
 
 /* MD5 初始化函数实现 */
 void MD5_Init(MD5_CTX *context) {
@@ -21,15 +29,16 @@ void MD5_Init(MD5_CTX *context) {
 
 /* MD5 更新函数实现 */
 void MD5_Update(MD5_CTX *context, const md5_byte_t *input, size_t length) {
-    md5_word_t i, index, partLen;
+    size_t i, index, partLen;
+    md5_word_t bits = (md5_word_t) (length << 3);
 
     /* 计算已处理的比特数 */
     index = (context->count[0] >> 3) & 0x3F;
 
-    /* 更新消息长度 */
-    if ((context->count[0] += (length << 3)) < (length << 3))
+    /* 更新消息长度：count 是64位比特数，length 超过 4 GiB 时高位进入 count[1] */
+    if ((context->count[0] += bits) < bits)
         context->count[1]++;
-    context->count[1] += (length >> 29);
+    context->count[1] += (md5_word_t) ((unsigned long long) length >> 29);
 
     partLen = 64 - index;
 
@@ -171,6 +180,13 @@ static void MD5_Transform(md5_word_t state[4], const md5_byte_t block[64]) {
     memset(x, 0, sizeof(x));
 }
 
+/* 对连续的 nblocks 个64字节分组执行压缩函数 */
+void MD5_TransformBlocks(md5_word_t state[4], const md5_byte_t *blocks, size_t nblocks) {
+    for (size_t i = 0; i < nblocks; i++) {
+        MD5_Transform(state, blocks + i * 64);
+    }
+}
+
 /* 函数把 32 位无符号整数（md5_word_t）转换为小端序的字节数组。 */
 static void Encode(md5_byte_t *output, const md5_word_t *input, size_t length) {
     size_t i, j;
@@ -58,15 +58,10 @@ void MD5_Update(MD5_CTX *context, const md5_byte_t *input, size_t length);
 /* MD5 最终函数 - 生成 MD5 哈希值 */
 void MD5_Final(md5_byte_t digest[16], MD5_CTX *context);
 
+/* 对连续的 nblocks 个64字节分组执行压缩函数，供多缓冲等实现处理剩余分组 */
+void MD5_TransformBlocks(md5_word_t state[4], const md5_byte_t *blocks, size_t nblocks);
+
 /* 将 MD5 哈希值转换为十六进制字符串 */
 void MD5_ToHexString(const md5_byte_t digest[16], char *hexString, size_t length);
 
-/* MD5 转换核心函数 */
-static void MD5_Transform(md5_word_t state[4], const md5_byte_t block[64]);
-
-/* 字节序转换函数 */
-static void Encode(md5_byte_t *output, const md5_word_t *input, size_t length);
-
-static void Decode(md5_word_t *output, const md5_byte_t *input, size_t length);
-
 #endif //MD5_H
\ No newline at end of file
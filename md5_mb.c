@@ -0,0 +1,79 @@
+//
+// 多缓冲 MD5 - 按三种向量宽度编译压缩内核，分路调度由 hash_mb.c 完成
+//
+
+#include "md5_mb.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include "cpu_features.h"
+#include "hash_mb.h"
+
+#if CPU_X86
+typedef md5_word_t mb_v4 __attribute__((vector_size(16)));
+typedef md5_word_t mb_v8 __attribute__((vector_size(32)));
+typedef md5_word_t mb_v16 __attribute__((vector_size(64)));
+
+// 4路：SSE2
+#define MB_T mb_v4
+#define MB_FN(name) name##_sse2
+#define MB_TARGET __attribute__((target("sse2")))
+#include "md5_mb_kernel.h"
+#undef MB_T
+#undef MB_FN
+#undef MB_TARGET
+
+// 8路：AVX2
+#define MB_T mb_v8
+#define MB_FN(name) name##_avx2
+#define MB_TARGET __attribute__((target("avx2")))
+#include "md5_mb_kernel.h"
+#undef MB_T
+#undef MB_FN
+#undef MB_TARGET
+
+// 16路：AVX-512
+#define MB_T mb_v16
+#define MB_FN(name) name##_avx512
+#define MB_TARGET __attribute__((target("avx512f")))
+#include "md5_mb_kernel.h"
+#undef MB_T
+#undef MB_FN
+#undef MB_TARGET
+#endif
+
+#if CPU_X86
+#define MD5_MB_KERNEL(name) name
+#else
+#define MD5_MB_KERNEL(name) NULL
+#endif
+
+static const uint32_t md5_init[4] = {0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476};
+
+static const hash_mb_alg md5_alg = {
+    4, md5_init, 0, MD5_TransformBlocks,
+    MD5_MB_KERNEL(md5_mb_compress_sse2), MD5_MB_KERNEL(md5_mb_compress_avx2), MD5_MB_KERNEL(md5_mb_compress_avx512)
+};
+
+static unsigned int mb_lanes = 0; // 0 表示尚未选择
+
+int MD5_mb_set_lanes(unsigned int lanes) {
+    if (lanes != 0 && !hash_mb_lanes_available(lanes)) {
+        return -1;
+    }
+    mb_lanes = lanes;
+    return 0;
+}
+
+// 选定并行路数：环境变量 MD5_MB_LANES 优先，否则取CPU支持的最宽实现
+unsigned int MD5_mb_lanes(void) {
+    if (mb_lanes == 0) {
+        mb_lanes = hash_mb_resolve_lanes("MD5_MB_LANES", 0);
+    }
+    return mb_lanes;
+}
+
+void MD5_HashMany(const md5_byte_t *const *msgs, const size_t *lens, size_t n, md5_byte_t (*digests)[16]) {
+    hash_mb_many(&md5_alg, MD5_mb_lanes(), msgs, lens, n, (uint8_t *) digests);
+}
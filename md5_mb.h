@@ -0,0 +1,27 @@
+//
+// 多缓冲 MD5 - 在 SIMD 寄存器中同时计算多条互相独立消息的 MD5
+//
+
+#ifndef MD5_MB_H
+#define MD5_MB_H
+
+#include <stddef.h>
+
+#include "md5.h"
+
+// 最多同时计算的消息数 (AVX-512)
+#define MD5_MB_MAX_LANES 16
+
+// 设置并行路数：4 (SSE2)、8 (AVX2)、16 (AVX-512)，1 表示逐条用标量实现，0 表示自动；
+// CPU 不支持或数值无效返回-1。自动模式取CPU支持的最宽实现，环境变量 MD5_MB_LANES 可强制指定
+int MD5_mb_set_lanes(unsigned int lanes);
+
+// 返回当前的并行路数
+unsigned int MD5_mb_lanes(void);
+
+// 计算 n 条消息的 MD5：msgs[i] 指向长度为 lens[i] 字节的第 i 条消息，摘要写入 digests[i]
+// 每一路算完一条消息后立即换入下一条，长短不一的消息也能让各路保持满载；
+// 待处理的消息用完、仍在计算的路数不足一半时，剩余部分改用标量实现完成
+void MD5_HashMany(const md5_byte_t *const *msgs, const size_t *lens, size_t n, md5_byte_t (*digests)[16]);
+
+#endif //MD5_MB_H
@@ -0,0 +1,114 @@
+//
+// 多缓冲 MD5 内核模板 - 由 md5_mb.c 按不同向量宽度多次包含，不单独使用
+//
+// 包含前需定义：
+//   MB_T       每个元素为一路状态字的 GCC 向量类型
+//   MB_FN(n)   给函数名加上宽度后缀
+//   MB_TARGET  函数的 target 属性
+// 轮函数直接使用 md5.h 中的 FF/GG/HH/II 宏，常数自动扩展到所有路
+//
+
+// 各路同时压缩一个64字节分组：state[i][l] 为第 l 路的第 i 个状态字，blocks[l] 为第 l 路的分组
+static MB_TARGET void MB_FN(md5_mb_compress)(md5_word_t state[4][MD5_MB_MAX_LANES],
+                                             const md5_byte_t *const blocks[MD5_MB_MAX_LANES]) {
+    enum { LANES = sizeof(MB_T) / sizeof(md5_word_t) };
+    md5_word_t words[16][LANES];
+    MB_T a, b, c, d, aa, bb, cc, dd, x[16];
+
+    // 把各路的分组转置为按字排列：x[j] 的第 l 个元素为第 l 路分组的第 j 个字 (小端)
+    for (int l = 0; l < LANES; l++) {
+        for (int j = 0; j < 16; j++) {
+            memcpy(&words[j][l], blocks[l] + j * 4, 4);
+        }
+    }
+    memcpy(x, words, sizeof(x));
+    memcpy(&a, state[0], sizeof(MB_T));
+    memcpy(&b, state[1], sizeof(MB_T));
+    memcpy(&c, state[2], sizeof(MB_T));
+    memcpy(&d, state[3], sizeof(MB_T));
+    aa = a;
+    bb = b;
+    cc = c;
+    dd = d;
+
+    /* 第一轮 */
+    FF(a, b, c, d, x[ 0], 7, 0xD76AA478);
+    FF(d, a, b, c, x[ 1], 12, 0xE8C7B756);
+    FF(c, d, a, b, x[ 2], 17, 0x242070DB);
+    FF(b, c, d, a, x[ 3], 22, 0xC1BDCEEE);
+    FF(a, b, c, d, x[ 4], 7, 0xF57C0FAF);
+    FF(d, a, b, c, x[ 5], 12, 0x4787C62A);
+    FF(c, d, a, b, x[ 6], 17, 0xA8304613);
+    FF(b, c, d, a, x[ 7], 22, 0xFD469501);
+    FF(a, b, c, d, x[ 8], 7, 0x698098D8);
+    FF(d, a, b, c, x[ 9], 12, 0x8B44F7AF);
+    FF(c, d, a, b, x[10], 17, 0xFFFF5BB1);
+    FF(b, c, d, a, x[11], 22, 0x895CD7BE);
+    FF(a, b, c, d, x[12], 7, 0x6B901122);
+    FF(d, a, b, c, x[13], 12, 0xFD987193);
+    FF(c, d, a, b, x[14], 17, 0xA679438E);
+    FF(b, c, d, a, x[15], 22, 0x49B40821);
+
+    /* 第二轮 */
+    GG(a, b, c, d, x[ 1], 5, 0xF61E2562);
+    GG(d, a, b, c, x[ 6], 9, 0xC040B340);
+    GG(c, d, a, b, x[11], 14, 0x265E5A51);
+    GG(b, c, d, a, x[ 0], 20, 0xE9B6C7AA);
+    GG(a, b, c, d, x[ 5], 5, 0xD62F105D);
+    GG(d, a, b, c, x[10], 9, 0x02441453);
+    GG(c, d, a, b, x[15], 14, 0xD8A1E681);
+    GG(b, c, d, a, x[ 4], 20, 0xE7D3FBC8);
+    GG(a, b, c, d, x[ 9], 5, 0x21E1CDE6);
+    GG(d, a, b, c, x[14], 9, 0xC33707D6);
+    GG(c, d, a, b, x[ 3], 14, 0xF4D50D87);
+    GG(b, c, d, a, x[ 8], 20, 0x455A14ED);
+    GG(a, b, c, d, x[13], 5, 0xA9E3E905);
+    GG(d, a, b, c, x[ 2], 9, 0xFCEFA3F8);
+    GG(c, d, a, b, x[ 7], 14, 0x676F02D9);
+    GG(b, c, d, a, x[12], 20, 0x8D2A4C8A);
+
+    /* 第三轮 */
+    HH(a, b, c, d, x[ 5], 4, 0xFFFA3942);
+    HH(d, a, b, c, x[ 8], 11, 0x8771F681);
+    HH(c, d, a, b, x[11], 16, 0x6D9D6122);
+    HH(b, c, d, a, x[14], 23, 0xFDE5380C);
+    HH(a, b, c, d, x[ 1], 4, 0xA4BEEA44);
+    HH(d, a, b, c, x[ 4], 11, 0x4BDECFA9);
+    HH(c, d, a, b, x[ 7], 16, 0xF6BB4B60);
+    HH(b, c, d, a, x[10], 23, 0xBEBFBC70);
+    HH(a, b, c, d, x[13], 4, 0x289B7EC6);
+    HH(d, a, b, c, x[ 0], 11, 0xEAA127FA);
+    HH(c, d, a, b, x[ 3], 16, 0xD4EF3085);
+    HH(b, c, d, a, x[ 6], 23, 0x04881D05);
+    HH(a, b, c, d, x[ 9], 4, 0xD9D4D039);
+    HH(d, a, b, c, x[12], 11, 0xE6DB99E5);
+    HH(c, d, a, b, x[15], 16, 0x1FA27CF8);
+    HH(b, c, d, a, x[ 2], 23, 0xC4AC5665);
+
+    /* 第四轮 */
+    II(a, b, c, d, x[ 0], 6, 0xF4292244);
+    II(d, a, b, c, x[ 7], 10, 0x432AFF97);
+    II(c, d, a, b, x[14], 15, 0xAB9423A7);
+    II(b, c, d, a, x[ 5], 21, 0xFC93A039);
+    II(a, b, c, d, x[12], 6, 0x655B59C3);
+    II(d, a, b, c, x[ 3], 10, 0x8F0CCC92);
+    II(c, d, a, b, x[10], 15, 0xFFEFF47D);
+    II(b, c, d, a, x[ 1], 21, 0x85845DD1);
+    II(a, b, c, d, x[ 8], 6, 0x6FA87E4F);
+    II(d, a, b, c, x[15], 10, 0xFE2CE6E0);
+    II(c, d, a, b, x[ 6], 15, 0xA3014314);
+    II(b, c, d, a, x[13], 21, 0x4E0811A1);
+    II(a, b, c, d, x[ 4], 6, 0xF7537E82);
+    II(d, a, b, c, x[11], 10, 0xBD3AF235);
+    II(c, d, a, b, x[ 2], 15, 0x2AD7D2BB);
+    II(b, c, d, a, x[ 9], 21, 0xEB86D391);
+
+    a += aa;
+    b += bb;
+    c += cc;
+    d += dd;
+    memcpy(state[0], &a, sizeof(MB_T));
+    memcpy(state[1], &b, sizeof(MB_T));
+    memcpy(state[2], &c, sizeof(MB_T));
+    memcpy(state[3], &d, sizeof(MB_T));
+}
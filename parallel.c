@@ -0,0 +1,155 @@
+//
+// 简单的多线程并行执行工具
+//
+// 工作线程在第一次需要时创建并一直保留，之后每次调用只需唤醒它们，
+// 避免每次拆分都创建和等待线程。同一时刻只有一个调用使用线程池，
+// 其他并发调用 (包括在工作函数中再次调用) 改为临时创建线程。
+//
+
+#include "parallel.h"
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+// 同时运行的最大线程数
+#define PARALLEL_MAX_THREADS 256
+
+// 单个工作线程的参数
+typedef struct {
+    parallel_fn fn;
+    void *arg;
+    unsigned int index;
+    unsigned int count;
+} parallel_task;
+
+// 线程池：job_* 为当前任务，由 pool_lock 保护；generation 每发布一个任务加1
+static pthread_mutex_t pool_run = PTHREAD_MUTEX_INITIALIZER;    // 持有者独占线程池
+static pthread_mutex_t pool_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t pool_work = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t pool_done = PTHREAD_COND_INITIALIZER;
+static unsigned int pool_size = 0;      // 已创建的工作线程数
+static unsigned long generation = 0;
+static parallel_fn job_fn;
+static void *job_arg;
+static unsigned int job_count;
+static unsigned int job_next;           // 下一份未领取的工作
+static unsigned int job_pending;        // 已发布但尚未完成的工作数 (不含编号0)
+
+static void *parallel_entry(void *p) {
+    parallel_task *task = (parallel_task *) p;
+    task->fn(task->arg, task->index, task->count);
+    return NULL;
+}
+
+// 领取并执行当前任务中剩余的工作，调用前后都持有 pool_lock
+static void pool_drain(void) {
+    while (job_next < job_count) {
+        unsigned int index = job_next++;
+
+        pthread_mutex_unlock(&pool_lock);
+        job_fn(job_arg, index, job_count);
+        pthread_mutex_lock(&pool_lock);
+        if (--job_pending == 0) {
+            pthread_cond_signal(&pool_done);
+        }
+    }
+}
+
+static void *pool_entry(void *p) {
+    unsigned long seen = 0;
+
+    (void) p;
+    pthread_mutex_lock(&pool_lock);
+    for (;;) {
+        while (generation == seen) {
+            pthread_cond_wait(&pool_work, &pool_lock);
+        }
+        seen = generation;
+        pool_drain();
+    }
+    return NULL;
+}
+
+unsigned int parallel_default_threads(void) {
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+
+    if (n < 1) {
+        return 1;
+    }
+    if (n > PARALLEL_MAX_THREADS) {
+        return PARALLEL_MAX_THREADS;
+    }
+    return (unsigned int) n;
+}
+
+// 线程池被占用时的做法：每份工作临时创建一个线程
+static void parallel_run_spawn(unsigned int count, parallel_fn fn, void *arg) {
+    pthread_t threads[PARALLEL_MAX_THREADS];
+    parallel_task tasks[PARALLEL_MAX_THREADS];
+    int started[PARALLEL_MAX_THREADS];
+
+    for (unsigned int i = 1; i < count; i++) {
+        tasks[i].fn = fn;
+        tasks[i].arg = arg;
+        tasks[i].index = i;
+        tasks[i].count = count;
+        started[i] = pthread_create(&threads[i], NULL, parallel_entry, &tasks[i]) == 0;
+    }
+
+    // 调用线程负责第0份
+    fn(arg, 0, count);
+
+    for (unsigned int i = 1; i < count; i++) {
+        if (started[i]) {
+            pthread_join(threads[i], NULL);
+        } else {
+            fn(arg, i, count);
+        }
+    }
+}
+
+void parallel_run(unsigned int count, parallel_fn fn, void *arg) {
+    if (count > PARALLEL_MAX_THREADS) {
+        count = PARALLEL_MAX_THREADS;
+    }
+    if (count <= 1) {
+        fn(arg, 0, 1);
+        return;
+    }
+    if (pthread_mutex_trylock(&pool_run) != 0) {
+        parallel_run_spawn(count, fn, arg);
+        return;
+    }
+
+    pthread_mutex_lock(&pool_lock);
+    // 线程不够时补足；创建失败也没关系，调用线程会领取剩下的工作
+    while (pool_size < count - 1) {
+        pthread_t thread;
+
+        if (pthread_create(&thread, NULL, pool_entry, NULL) != 0) {
+            break;
+        }
+        pthread_detach(thread);
+        pool_size++;
+    }
+    job_fn = fn;
+    job_arg = arg;
+    job_count = count;
+    job_next = 1;
+    job_pending = count - 1;
+    generation++;
+    pthread_cond_broadcast(&pool_work);
+    pthread_mutex_unlock(&pool_lock);
+
+    // 调用线程负责第0份，做完后帮忙领取还没有线程接手的工作
+    fn(arg, 0, count);
+
+    pthread_mutex_lock(&pool_lock);
+    pool_drain();
+    while (job_pending > 0) {
+        pthread_cond_wait(&pool_done, &pool_lock);
+    }
+    pthread_mutex_unlock(&pool_lock);
+    pthread_mutex_unlock(&pool_run);
+}
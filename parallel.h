@@ -0,0 +1,19 @@
+//
+// 简单的多线程并行执行工具 (POSIX 线程)
+//
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+// 工作函数：index 为当前工作线程编号 (0 .. count-1)，count 为工作线程总数
+typedef void (*parallel_fn)(void *arg, unsigned int index, unsigned int count);
+
+// 返回默认工作线程数（在线CPU核数，至少为1）
+unsigned int parallel_default_threads(void);
+
+// 用 count 个工作线程执行 fn(arg, index, count)，全部完成后返回
+// 编号0在调用线程中执行；其余工作交给常驻的线程池，线程在第一次需要时创建，之后的调用直接复用。
+// 线程池正被其他调用占用时临时创建线程；线程创建失败时改为在调用线程中执行该份工作，因此总会完成全部工作
+void parallel_run(unsigned int count, parallel_fn fn, void *arg);
+
+#endif //PARALLEL_H
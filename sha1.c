@@ -31,6 +31,15 @@
 
 #include "sha1.h"
 
+#include <stdlib.h>
+#include <string.h>
+
+#include "cpu_features.h"
+
+#if CPU_X86
+#include <immintrin.h>
+#endif
+
 /*
  *  Define the SHA1 circular left shift macro
  *  循环左移宏定义：将32位值左移n位，溢出的高位补充到低位
@@ -111,7 +120,7 @@ int SHA1Reset(SHA1Context *context) {
  */
 int SHA1Input(SHA1Context *context,
               const uint8_t *message_array,
-              unsigned length) {
+              size_t length) {
     if (!length) {
         return shaSuccess;
     }
@@ -130,30 +139,55 @@ int SHA1Input(SHA1Context *context,
     }
 
     /*
-     *  处理输入的消息数组，逐字节处理
-     *  当消息块填满512位(64字节)时，调用处理函数
+     *  一次性累加消息长度 (64位比特数)，超过 2^64 位时拒绝整段输入
      */
-    while (length-- && !context->Corrupted) {
-        context->Message_Block[context->Message_Block_Index++] =
-                (*message_array & 0xFF);
-
-        context->Length_Low += 8; // 每个字节8位
-        if (context->Length_Low == 0) {
-            context->Length_High++;
-            if (context->Length_High == 0) {
-                /* Message is too long */
-                context->Corrupted = 1;
-            }
+    {
+        uint64_t bits = ((uint64_t) context->Length_High << 32) | context->Length_Low;
+        uint64_t added = (uint64_t) length << 3;
+
+        if ((uint64_t) length > (UINT64_MAX >> 3) || bits + added < bits) {
+            context->Corrupted = shaInputTooLong;
+            return shaInputTooLong;
         }
+        bits += added;
+        context->Length_Low = (uint32_t) bits;
+        context->Length_High = (uint32_t) (bits >> 32);
+    }
+
+    /*
+     *  先补满缓冲区中未满的块
+     */
+    if (context->Message_Block_Index > 0) {
+        size_t n = 64 - context->Message_Block_Index;
+
+        if (n > length) {
+            n = length;
+        }
+        memcpy(&context->Message_Block[context->Message_Block_Index], message_array, n);
+        context->Message_Block_Index += (int_least16_t) n;
+        message_array += n;
+        length -= n;
 
-        /*
-         *  如果消息块已满(512位)，则处理该块
-         */
         if (context->Message_Block_Index == 64) {
             SHA1ProcessMessageBlock(context);
         }
+    }
 
-        message_array++;
+    /*
+     *  完整的块直接在调用者的缓冲区上压缩，不再复制
+     */
+    if (length >= 64) {
+        SHA1ProcessBlocks(context->Intermediate_Hash, message_array, length / 64);
+        message_array += length & ~(size_t) 63;
+        length &= 63;
+    }
+
+    /*
+     *  剩余不足一块的字节留在缓冲区
+     */
+    if (length > 0) {
+        memcpy(context->Message_Block, message_array, length);
+        context->Message_Block_Index = (int_least16_t) length;
     }
 
     return shaSuccess;
@@ -215,27 +249,28 @@ int SHA1Result(SHA1Context *context,
 }
 
 /*
- *  SHA1ProcessMessageBlock
+ *  SHA1ProcessBlocksGeneric
  *
  *  Description:
- *      This function will process the next 512 bits of the message
- *      stored in the Message_Block array.
+ *      This function will process nblocks consecutive 512-bit
+ *      message blocks starting at blocks.
  *
  *  Parameters:
- *      None.
+ *      Intermediate_Hash: [in/out]
+ *          The intermediate hash value that is being computed.
+ *      blocks: [in]
+ *          The message blocks to process, read in place.
+ *      nblocks: [in]
+ *          The number of 64-byte blocks.
  *
  *  Returns:
  *      Nothing.
  *
- *  Global Variables:
- *      Intermediate_Hash: [in/out]
- *          The intermediate hash value that is being computed.
- *      Message_Block: [in]
- *          The message block to process.
- *
- *  处理512位的消息块，这是SHA-1算法的核心
+ *  依次处理 nblocks 个512位的消息块，这是SHA-1算法的核心 (可移植的C实现)
  */
-void SHA1ProcessMessageBlock(SHA1Context *context) {
+static void SHA1ProcessBlocksGeneric(uint32_t Intermediate_Hash[SHA1HashSize/4],
+                                     const uint8_t *blocks,
+                                     size_t nblocks) {
     const uint32_t K[] = /* Constants defined in SHA-1   */
     {
         0x5A827999, /* 0 <= t <= 19 */
@@ -249,73 +284,518 @@ void SHA1ProcessMessageBlock(SHA1Context *context) {
     uint32_t W[80]; /* Word sequence               */
     uint32_t A, B, C, D, E; /* Word buffers                */
 
-    /*
-     *  初始化工作变量
-     */
-    A = context->Intermediate_Hash[0];
-    B = context->Intermediate_Hash[1];
-    C = context->Intermediate_Hash[2];
-    D = context->Intermediate_Hash[3];
-    E = context->Intermediate_Hash[4];
+    for (; nblocks > 0; nblocks--, blocks += 64) {
+        /*
+         *  初始化工作变量
+         */
+        A = Intermediate_Hash[0];
+        B = Intermediate_Hash[1];
+        C = Intermediate_Hash[2];
+        D = Intermediate_Hash[3];
+        E = Intermediate_Hash[4];
 
-    /*
-     *  消息块扩展：将16个32位字扩展为80个32位字
-     *  前16个字直接从消息块获取
-     */
-    for (t = 0; t < 16; t++) {
-        W[t] = context->Message_Block[t * 4] << 24;
-        W[t] |= context->Message_Block[t * 4 + 1] << 16;
-        W[t] |= context->Message_Block[t * 4 + 2] << 8;
-        W[t] |= context->Message_Block[t * 4 + 3];
-    }
+        /*
+         *  消息块扩展：将16个32位字扩展为80个32位字
+         *  前16个字直接从消息块获取
+         */
+        for (t = 0; t < 16; t++) {
+            W[t] = (uint32_t) blocks[t * 4] << 24;
+            W[t] |= (uint32_t) blocks[t * 4 + 1] << 16;
+            W[t] |= (uint32_t) blocks[t * 4 + 2] << 8;
+            W[t] |= blocks[t * 4 + 3];
+        }
 
-    /*
-     *  后64个字通过前序字计算得到
-     *  W[t] = S^1(W[t-3] XOR W[t-8] XOR W[t-14] XOR W[t-16])
-     *  其中S^1表示循环左移1位
-     */
-    for (t = 16; t < 80; t++) {
-        W[t] = SHA1CircularShift(1, W[t-3] ^ W[t-8] ^ W[t-14] ^ W[t-16]);
-    }
+        /*
+         *  后64个字通过前序字计算得到
+         *  W[t] = S^1(W[t-3] XOR W[t-8] XOR W[t-14] XOR W[t-16])
+         *  其中S^1表示循环左移1位
+         */
+        for (t = 16; t < 80; t++) {
+            W[t] = SHA1CircularShift(1, W[t-3] ^ W[t-8] ^ W[t-14] ^ W[t-16]);
+        }
 
-    /*
-     *  主循环：进行80轮运算，分为4个阶段
-     *  每个阶段20轮，使用不同的布尔函数和常量
-     */
-    for (t = 0; t < 80; t++) {
         /*
-         *  选择适当的常量K和布尔函数f(t)
+         *  主循环：进行80轮运算，分为4个阶段
+         *  每个阶段20轮，使用不同的布尔函数和常量
          */
-        if (t < 20) {
-            temp = SHA1CircularShift(5, A) +
-                   ((B & C) | ((~B) & D)) + E + W[t] + K[0];
-        } else if (t < 40) {
-            temp = SHA1CircularShift(5, A) +
-                   (B ^ C ^ D) + E + W[t] + K[1];
-        } else if (t < 60) {
-            temp = SHA1CircularShift(5, A) +
-                   ((B & C) | (B & D) | (C & D)) + E + W[t] + K[2];
-        } else {
-            temp = SHA1CircularShift(5, A) +
-                   (B ^ C ^ D) + E + W[t] + K[3];
+        for (t = 0; t < 80; t++) {
+            /*
+             *  选择适当的常量K和布尔函数f(t)
+             */
+            if (t < 20) {
+                temp = SHA1CircularShift(5, A) +
+                       ((B & C) | ((~B) & D)) + E + W[t] + K[0];
+            } else if (t < 40) {
+                temp = SHA1CircularShift(5, A) +
+                       (B ^ C ^ D) + E + W[t] + K[1];
+            } else if (t < 60) {
+                temp = SHA1CircularShift(5, A) +
+                       ((B & C) | (B & D) | (C & D)) + E + W[t] + K[2];
+            } else {
+                temp = SHA1CircularShift(5, A) +
+                       (B ^ C ^ D) + E + W[t] + K[3];
+            }
+
+            E = D;
+            D = C;
+            C = SHA1CircularShift(30, B); // S^5(B) 循环左移30位
+            B = A;
+            A = temp;
         }
 
-        E = D;
-        D = C;
-        C = SHA1CircularShift(30, B); // S^5(B) 循环左移30位
-        B = A;
-        A = temp;
+        /*
+         *  更新中间哈希值
+         */
+        Intermediate_Hash[0] += A;
+        Intermediate_Hash[1] += B;
+        Intermediate_Hash[2] += C;
+        Intermediate_Hash[3] += D;
+        Intermediate_Hash[4] += E;
     }
+}
 
-    /*
-     *  更新中间哈希值
-     */
-    context->Intermediate_Hash[0] += A;
-    context->Intermediate_Hash[1] += B;
-    context->Intermediate_Hash[2] += C;
-    context->Intermediate_Hash[3] += D;
-    context->Intermediate_Hash[4] += E;
+#if CPU_X86
+/*
+ *  向量化消息扩展 (SSSE3/AVX2)
+ *
+ *  每个向量装4个连续的消息字，W[t..t+3] 一次算出，加上常量K后存入 wk[]，
+ *  轮函数只需读取 W[t]+K。t < 32 时 W[t+3] 依赖同一向量里的 W[t]，先用0代替再修正；
+ *  t >= 32 时改用等价公式 W[t] = S^2(W[t-6] ^ W[t-16] ^ W[t-28] ^ W[t-32])，没有向量内依赖。
+ */
+
+/* 三个轮函数阶段的布尔函数 (与 SHA1ProcessBlocksGeneric 相同，写成少一次运算的形式) */
+#define SHA1_F0(b, c, d) ((d) ^ ((b) & ((c) ^ (d))))
+#define SHA1_F1(b, c, d) ((b) ^ (c) ^ (d))
+#define SHA1_F2(b, c, d) (((b) & (c)) | ((d) & ((b) | (c))))
+
+/* 用预先加好常量的 wk[t] 执行一轮 */
+#define SHA1_WK_ROUND(F, t) \
+    temp = SHA1CircularShift(5, A) + F(B, C, D) + E + wk[t]; \
+    E = D; \
+    D = C; \
+    C = SHA1CircularShift(30, B); \
+    B = A; \
+    A = temp
+
+#define SHA1_WK_ROUNDS4(F, t) \
+    SHA1_WK_ROUND(F, (t)); \
+    SHA1_WK_ROUND(F, (t) + 1); \
+    SHA1_WK_ROUND(F, (t) + 2); \
+    SHA1_WK_ROUND(F, (t) + 3)
+
+static const uint32_t SHA1_K[4] = {0x5A827999, 0x6ED9EBA1, 0x8F1BBCDC, 0xCA62C1D6};
+
+/* 32位元素循环左移 */
+#define SHA1_VROL(v, n, SLL, SRL, OR) OR(SLL(v, n), SRL(v, 32 - (n)))
+
+#define SSSE3_TARGET __attribute__((target("ssse3")))
+
+#define SSE_ROL(v, n) SHA1_VROL(v, n, _mm_slli_epi32, _mm_srli_epi32, _mm_or_si128)
+
+/* 读入一个块的16个字 (大端序) */
+static inline SSSE3_TARGET void SHA1LoadSSSE3(__m128i W[20], const uint8_t *block) {
+    const __m128i BSWAP = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+    for (int i = 0; i < 4; i++) {
+        W[i] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) (block + 16 * i)), BSWAP);
+    }
+}
+
+/* 计算第 i 个向量 W[4i..4i+3] (4 <= i < 20) */
+static inline SSSE3_TARGET __m128i SHA1ScheduleSSSE3(const __m128i W[20], int i) {
+    if (i < 8) {
+        /* W[t-16] ^ W[t-14] ^ W[t-8] ^ (W[t-3], W[t-2], W[t-1], 0) */
+        __m128i x = _mm_xor_si128(_mm_xor_si128(W[i - 4], _mm_alignr_epi8(W[i - 3], W[i - 4], 8)),
+                                  _mm_xor_si128(W[i - 2], _mm_srli_si128(W[i - 1], 4)));
+        /* 补上最后一个字缺的 W[t] = S^1(x[0])：S^1(y ^ S^1(x0)) = S^1(y) ^ S^2(x0) */
+        __m128i fix = _mm_slli_si128(x, 12);
+        return _mm_xor_si128(SSE_ROL(x, 1), SSE_ROL(fix, 2));
+    }
+    return SSE_ROL(_mm_xor_si128(_mm_xor_si128(W[i - 8], W[i - 7]),
+                                 _mm_xor_si128(_mm_alignr_epi8(W[i - 1], W[i - 2], 8), W[i - 4])), 2);
+}
+
+/* 第 i 个向量加上所在阶段的常量后存入 wk */
+static inline SSSE3_TARGET void SHA1StoreWKSSSE3(uint32_t wk[80], const __m128i W[20], int i) {
+    _mm_store_si128((__m128i *) (wk + 4 * i), _mm_add_epi32(W[i], _mm_set1_epi32((int) SHA1_K[i / 5])));
+}
+
+/* 20组、每组4轮的轮函数，GROUP(F, g) 执行第 g 组 */
+#define SHA1_WK_GROUPS(GROUP) \
+    GROUP(SHA1_F0, 0); GROUP(SHA1_F0, 1); GROUP(SHA1_F0, 2); GROUP(SHA1_F0, 3); GROUP(SHA1_F0, 4); \
+    GROUP(SHA1_F1, 5); GROUP(SHA1_F1, 6); GROUP(SHA1_F1, 7); GROUP(SHA1_F1, 8); GROUP(SHA1_F1, 9); \
+    GROUP(SHA1_F2, 10); GROUP(SHA1_F2, 11); GROUP(SHA1_F2, 12); GROUP(SHA1_F2, 13); GROUP(SHA1_F2, 14); \
+    GROUP(SHA1_F1, 15); GROUP(SHA1_F1, 16); GROUP(SHA1_F1, 17); GROUP(SHA1_F1, 18); GROUP(SHA1_F1, 19)
+
+#define SHA1_LOAD_STATE() \
+    A = Intermediate_Hash[0]; \
+    B = Intermediate_Hash[1]; \
+    C = Intermediate_Hash[2]; \
+    D = Intermediate_Hash[3]; \
+    E = Intermediate_Hash[4]
+
+#define SHA1_ADD_STATE() \
+    Intermediate_Hash[0] += A; \
+    Intermediate_Hash[1] += B; \
+    Intermediate_Hash[2] += C; \
+    Intermediate_Hash[3] += D; \
+    Intermediate_Hash[4] += E
+
+/*
+ *  SHA1ProcessBlocksSSSE3
+ *
+ *  SSSE3 消息扩展：每4轮之前先算出16轮之后要用的4个消息字，
+ *  向量运算与标量轮函数交错，乱序执行可以让两者重叠
+ */
+static SSSE3_TARGET void SHA1ProcessBlocksSSSE3(uint32_t Intermediate_Hash[SHA1HashSize/4],
+                                                const uint8_t *blocks,
+                                                size_t nblocks) {
+    __m128i W[20];
+    uint32_t wk[80] __attribute__((aligned(16)));
+    uint32_t A, B, C, D, E, temp;
+
+    for (; nblocks > 0; nblocks--, blocks += 64) {
+        SHA1LoadSSSE3(W, blocks);
+        for (int i = 0; i < 4; i++) {
+            SHA1StoreWKSSSE3(wk, W, i);
+        }
+        SHA1_LOAD_STATE();
+
+        /* 第 g 组4轮之前算出第 g + 4 个向量 */
+#define SSSE3_GROUP(F, g) \
+        if ((g) + 4 < 20) { \
+            W[(g) + 4] = SHA1ScheduleSSSE3(W, (g) + 4); \
+            SHA1StoreWKSSSE3(wk, W, (g) + 4); \
+        } \
+        SHA1_WK_ROUNDS4(F, 4 * (g))
 
+        SHA1_WK_GROUPS(SSSE3_GROUP);
+#undef SSSE3_GROUP
+
+        SHA1_ADD_STATE();
+    }
+}
+
+#define AVX2_TARGET __attribute__((target("avx2")))
+
+#define AVX2_ROL(v, n) SHA1_VROL(v, n, _mm256_slli_epi32, _mm256_srli_epi32, _mm256_or_si256)
+
+/* 与 SHA1ScheduleSSSE3 相同，两个128位通道各对应一个块 */
+static inline AVX2_TARGET __m256i SHA1ScheduleAVX2(const __m256i W[20], int i) {
+    if (i < 8) {
+        __m256i x = _mm256_xor_si256(_mm256_xor_si256(W[i - 4], _mm256_alignr_epi8(W[i - 3], W[i - 4], 8)),
+                                     _mm256_xor_si256(W[i - 2], _mm256_srli_si256(W[i - 1], 4)));
+        __m256i fix = _mm256_slli_si256(x, 12);
+        return _mm256_xor_si256(AVX2_ROL(x, 1), AVX2_ROL(fix, 2));
+    }
+    return AVX2_ROL(_mm256_xor_si256(_mm256_xor_si256(W[i - 8], W[i - 7]),
+                                     _mm256_xor_si256(_mm256_alignr_epi8(W[i - 1], W[i - 2], 8), W[i - 4])), 2);
+}
+
+/* 第 i 个向量加上常量后分别存入两个块的 wk */
+static inline AVX2_TARGET void SHA1StoreWKAVX2(uint32_t wk[2][80], const __m256i W[20], int i) {
+    __m256i v = _mm256_add_epi32(W[i], _mm256_set1_epi32((int) SHA1_K[i / 5]));
+
+    _mm_store_si128((__m128i *) (wk[0] + 4 * i), _mm256_castsi256_si128(v));
+    _mm_store_si128((__m128i *) (wk[1] + 4 * i), _mm256_extracti128_si256(v, 1));
+}
+
+/*
+ *  SHA1ProcessBlocksAVX2
+ *
+ *  AVX2 消息扩展：低128位放前一个块、高128位放后一个块，一条指令同时扩展两个块的消息字。
+ *  扩展与前一个块的轮函数交错进行，后一个块的轮函数直接使用已算好的 wk；
+ *  最后剩下的单个块交给 SSSE3 实现
+ */
+static AVX2_TARGET void SHA1ProcessBlocksAVX2(uint32_t Intermediate_Hash[SHA1HashSize/4],
+                                              const uint8_t *blocks,
+                                              size_t nblocks) {
+    const __m256i BSWAP = _mm256_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL,
+                                            0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+    __m256i W[20];
+    uint32_t wkbuf[2][80] __attribute__((aligned(32)));
+    const uint32_t *wk;
+    uint32_t A, B, C, D, E, temp;
+
+    for (; nblocks >= 2; nblocks -= 2, blocks += 128) {
+        for (int i = 0; i < 4; i++) {
+            __m256i v = _mm256_inserti128_si256(
+                    _mm256_castsi128_si256(_mm_loadu_si128((const __m128i *) (blocks + 16 * i))),
+                    _mm_loadu_si128((const __m128i *) (blocks + 64 + 16 * i)), 1);
+            W[i] = _mm256_shuffle_epi8(v, BSWAP);
+            SHA1StoreWKAVX2(wkbuf, W, i);
+        }
+
+        wk = wkbuf[0];
+        SHA1_LOAD_STATE();
+#define AVX2_GROUP(F, g) \
+        if ((g) + 4 < 20) { \
+            W[(g) + 4] = SHA1ScheduleAVX2(W, (g) + 4); \
+            SHA1StoreWKAVX2(wkbuf, W, (g) + 4); \
+        } \
+        SHA1_WK_ROUNDS4(F, 4 * (g))
+
+        SHA1_WK_GROUPS(AVX2_GROUP);
+#undef AVX2_GROUP
+        SHA1_ADD_STATE();
+
+        /* 后一个块 */
+        wk = wkbuf[1];
+        SHA1_LOAD_STATE();
+#define AVX2_GROUP2(F, g) SHA1_WK_ROUNDS4(F, 4 * (g))
+        SHA1_WK_GROUPS(AVX2_GROUP2);
+#undef AVX2_GROUP2
+        SHA1_ADD_STATE();
+    }
+    if (nblocks > 0) {
+        SHA1ProcessBlocksSSSE3(Intermediate_Hash, blocks, nblocks);
+    }
+}
+
+#define SHANI_TARGET __attribute__((target("sha,sse4.1")))
+
+/*
+ *  中间4轮：用 MSG_K 完成本组4轮，同时推进后续消息字的扩展
+ *  (SHA1MSG2 完成 W[t+4..t+7]，SHA1MSG1/异或为再往后的消息字做准备)
+ */
+#define SHANI_QROUND(f, E_A, E_B, MSG_K, MSG_N, MSG_X, MSG_P) \
+    E_A = _mm_sha1nexte_epu32(E_A, MSG_K); \
+    E_B = ABCD; \
+    MSG_N = _mm_sha1msg2_epu32(MSG_N, MSG_K); \
+    ABCD = _mm_sha1rnds4_epu32(ABCD, E_A, f); \
+    MSG_P = _mm_sha1msg1_epu32(MSG_P, MSG_K); \
+    MSG_X = _mm_xor_si128(MSG_X, MSG_K)
+
+/*
+ *  SHA1ProcessBlocksShaNi
+ *
+ *  用 SHA1RNDS4/SHA1NEXTE/SHA1MSG1/SHA1MSG2 指令处理 nblocks 个消息块
+ *  ABCD 存放在一个寄存器中 (A 在最高32位)，E 放在另一个寄存器的最高32位；
+ *  SHA1RNDS4 一次完成4轮，立即数 f 选择布尔函数和常量K
+ */
+static SHANI_TARGET void SHA1ProcessBlocksShaNi(uint32_t Intermediate_Hash[SHA1HashSize/4],
+                                                const uint8_t *blocks,
+                                                size_t nblocks) {
+    /* 把每个32位字从大端序转为小端序，并把4个字的顺序倒过来 */
+    const __m128i MASK = _mm_set_epi64x(0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL);
+    __m128i ABCD, ABCD_SAVE, E0, E0_SAVE, E1;
+    __m128i MSG0, MSG1, MSG2, MSG3;
+
+    ABCD = _mm_loadu_si128((const __m128i *) Intermediate_Hash);
+    ABCD = _mm_shuffle_epi32(ABCD, 0x1B);
+    E0 = _mm_set_epi32((int) Intermediate_Hash[4], 0, 0, 0);
+
+    for (; nblocks > 0; nblocks--, blocks += 64) {
+        ABCD_SAVE = ABCD;
+        E0_SAVE = E0;
+
+        /* 第0~3轮 */
+        MSG0 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) blocks), MASK);
+        E0 = _mm_add_epi32(E0, MSG0);
+        E1 = ABCD;
+        ABCD = _mm_sha1rnds4_epu32(ABCD, E0, 0);
+
+        /* 第4~7轮 */
+        MSG1 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) (blocks + 16)), MASK);
+        E1 = _mm_sha1nexte_epu32(E1, MSG1);
+        E0 = ABCD;
+        ABCD = _mm_sha1rnds4_epu32(ABCD, E1, 0);
+        MSG0 = _mm_sha1msg1_epu32(MSG0, MSG1);
+
+        /* 第8~11轮 */
+        MSG2 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) (blocks + 32)), MASK);
+        E0 = _mm_sha1nexte_epu32(E0, MSG2);
+        E1 = ABCD;
+        ABCD = _mm_sha1rnds4_epu32(ABCD, E0, 0);
+        MSG1 = _mm_sha1msg1_epu32(MSG1, MSG2);
+        MSG0 = _mm_xor_si128(MSG0, MSG2);
+
+        /* 第12~15轮 */
+        MSG3 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) (blocks + 48)), MASK);
+        SHANI_QROUND(0, E1, E0, MSG3, MSG0, MSG1, MSG2);
+
+        /* 第16~63轮：每组4轮，消息寄存器和 E0/E1 轮流使用 */
+        SHANI_QROUND(0, E0, E1, MSG0, MSG1, MSG2, MSG3);
+        SHANI_QROUND(1, E1, E0, MSG1, MSG2, MSG3, MSG0);
+        SHANI_QROUND(1, E0, E1, MSG2, MSG3, MSG0, MSG1);
+        SHANI_QROUND(1, E1, E0, MSG3, MSG0, MSG1, MSG2);
+        SHANI_QROUND(1, E0, E1, MSG0, MSG1, MSG2, MSG3);
+        SHANI_QROUND(1, E1, E0, MSG1, MSG2, MSG3, MSG0);
+        SHANI_QROUND(2, E0, E1, MSG2, MSG3, MSG0, MSG1);
+        SHANI_QROUND(2, E1, E0, MSG3, MSG0, MSG1, MSG2);
+        SHANI_QROUND(2, E0, E1, MSG0, MSG1, MSG2, MSG3);
+        SHANI_QROUND(2, E1, E0, MSG1, MSG2, MSG3, MSG0);
+        SHANI_QROUND(2, E0, E1, MSG2, MSG3, MSG0, MSG1);
+        SHANI_QROUND(3, E1, E0, MSG3, MSG0, MSG1, MSG2);
+
+        /* 第64~67轮 */
+        SHANI_QROUND(3, E0, E1, MSG0, MSG1, MSG2, MSG3);
+
+        /* 第68~71轮 */
+        E1 = _mm_sha1nexte_epu32(E1, MSG1);
+        E0 = ABCD;
+        MSG2 = _mm_sha1msg2_epu32(MSG2, MSG1);
+        ABCD = _mm_sha1rnds4_epu32(ABCD, E1, 3);
+        MSG3 = _mm_xor_si128(MSG3, MSG1);
+
+        /* 第72~75轮 */
+        E0 = _mm_sha1nexte_epu32(E0, MSG2);
+        E1 = ABCD;
+        MSG3 = _mm_sha1msg2_epu32(MSG3, MSG2);
+        ABCD = _mm_sha1rnds4_epu32(ABCD, E0, 3);
+
+        /* 第76~79轮 */
+        E1 = _mm_sha1nexte_epu32(E1, MSG3);
+        E0 = ABCD;
+        ABCD = _mm_sha1rnds4_epu32(ABCD, E1, 3);
+
+        /* 加回本块开始时的状态 (E 需要先循环左移30位，由 SHA1NEXTE 完成) */
+        E0 = _mm_sha1nexte_epu32(E0, E0_SAVE);
+        ABCD = _mm_add_epi32(ABCD, ABCD_SAVE);
+    }
+
+    ABCD = _mm_shuffle_epi32(ABCD, 0x1B);
+    _mm_storeu_si128((__m128i *) Intermediate_Hash, ABCD);
+    Intermediate_Hash[4] = (uint32_t) _mm_extract_epi32(E0, 3);
+}
+#endif
+
+/*
+ *  判断某个实现在当前CPU上是否可用
+ */
+static int SHA1ImplAvailable(sha1_impl_t impl) {
+    switch (impl) {
+        case SHA1_IMPL_GENERIC:
+            return 1;
+#if CPU_X86
+        case SHA1_IMPL_SSSE3:
+            return cpu_has(CPU_SSSE3);
+        case SHA1_IMPL_AVX2:
+            return cpu_has(CPU_AVX2);
+#endif
+        case SHA1_IMPL_SHANI:
+#if CPU_X86
+            return cpu_has(CPU_SHANI | CPU_SSE41);
+#else
+            return 0;
+#endif
+        default:
+            return 0;
+    }
+}
+
+/* 当前使用的实现，SHA1_IMPL_AUTO 表示尚未选定 */
+static sha1_impl_t sha1_impl = SHA1_IMPL_AUTO;
+
+/*
+ *  选定实现：环境变量 SHA1_IMPL 优先，否则依次尝试 SHA-NI、AVX2、SSSE3，最后是C实现
+ */
+static sha1_impl_t SHA1ResolveImpl(void) {
+    if (sha1_impl == SHA1_IMPL_AUTO) {
+        static const sha1_impl_t impls[] = {
+            SHA1_IMPL_SHANI, SHA1_IMPL_AVX2, SHA1_IMPL_SSSE3, SHA1_IMPL_GENERIC
+        };
+        const char *env = getenv("SHA1_IMPL");
+        sha1_impl_t impl = SHA1_IMPL_AUTO;
+        size_t i;
+
+        for (i = 0; env && i < sizeof(impls) / sizeof(impls[0]); i++) {
+            if (strcmp(env, SHA1ImplName(impls[i])) == 0 && SHA1ImplAvailable(impls[i])) {
+                impl = impls[i];
+            }
+        }
+        /* 按从快到慢的顺序取第一个可用的实现 */
+        for (i = 0; impl == SHA1_IMPL_AUTO; i++) {
+            if (SHA1ImplAvailable(impls[i])) {
+                impl = impls[i];
+            }
+        }
+        sha1_impl = impl;
+    }
+    return sha1_impl;
+}
+
+int SHA1SetImpl(sha1_impl_t impl) {
+    if (impl != SHA1_IMPL_AUTO && !SHA1ImplAvailable(impl)) {
+        return -1;
+    }
+    sha1_impl = impl;
+    return 0;
+}
+
+sha1_impl_t SHA1GetImpl(void) {
+    return SHA1ResolveImpl();
+}
+
+const char *SHA1ImplName(sha1_impl_t impl) {
+    switch (impl) {
+        case SHA1_IMPL_GENERIC:
+            return "generic";
+        case SHA1_IMPL_SSSE3:
+            return "ssse3";
+        case SHA1_IMPL_AVX2:
+            return "avx2";
+        case SHA1_IMPL_SHANI:
+            return "shani";
+        default:
+            return "auto";
+    }
+}
+
+/*
+ *  SHA1ProcessBlocks
+ *
+ *  Description:
+ *      This function will process nblocks consecutive 512-bit
+ *      message blocks starting at blocks, using the implementation
+ *      selected by SHA1SetImpl or CPUID.
+ *
+ *  直接读取调用者的缓冲区，SHA1Input 的完整块和 Message_Block 都由它处理
+ */
+void SHA1ProcessBlocks(uint32_t Intermediate_Hash[SHA1HashSize/4],
+                       const uint8_t *blocks,
+                       size_t nblocks) {
+#if CPU_X86
+    switch (SHA1ResolveImpl()) {
+        case SHA1_IMPL_SHANI:
+            SHA1ProcessBlocksShaNi(Intermediate_Hash, blocks, nblocks);
+            return;
+        case SHA1_IMPL_AVX2:
+            SHA1ProcessBlocksAVX2(Intermediate_Hash, blocks, nblocks);
+            return;
+        case SHA1_IMPL_SSSE3:
+            SHA1ProcessBlocksSSSE3(Intermediate_Hash, blocks, nblocks);
+            return;
+        default:
+            break;
+    }
+#endif
+    SHA1ProcessBlocksGeneric(Intermediate_Hash, blocks, nblocks);
+}
+
+/*
+ *  SHA1ProcessMessageBlock
+ *
+ *  Description:
+ *      This function will process the next 512 bits of the message
+ *      stored in the Message_Block array.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Global Variables:
+ *      Intermediate_Hash: [in/out]
+ *          The intermediate hash value that is being computed.
+ *      Message_Block: [in]
+ *          The message block to process.
+ *
+ *  处理缓冲区 Message_Block 中的一个消息块
+ */
+void SHA1ProcessMessageBlock(SHA1Context *context) {
+    SHA1ProcessBlocks(context->Intermediate_Hash, context->Message_Block, 1);
     context->Message_Block_Index = 0;
 }
 
@@ -17,6 +17,7 @@
 #ifndef _SHA1_H_
 #define _SHA1_H_
 
+#include <stddef.h>
 #include <stdint.h>
 
 #ifndef _SHA_enum_
@@ -52,14 +53,43 @@ typedef struct SHA1Context
     int Corrupted;                  /* Is the message digest corrupted? */
 } SHA1Context;
 
+/*
+ *  SHA-1 压缩函数的实现选择
+ */
+typedef enum
+{
+    SHA1_IMPL_AUTO = 0,     /* 自动选择最快的可用实现 */
+    SHA1_IMPL_GENERIC,      /* 可移植的C实现 */
+    SHA1_IMPL_SHANI,        /* SHA-NI 硬件指令实现 */
+    SHA1_IMPL_SSSE3,        /* SSSE3 向量化消息扩展，轮函数为标量 */
+    SHA1_IMPL_AVX2          /* AVX2 同时扩展两个块的消息 */
+} sha1_impl_t;
+
 /*
  *  Function Prototypes
  */
 int SHA1Reset(  SHA1Context *);
 int SHA1Input(  SHA1Context *,
                 const uint8_t *,
-                unsigned int);
+                size_t);
 int SHA1Result( SHA1Context *,
                 uint8_t Message_Digest[SHA1HashSize]);
 
+/*
+ *  对连续的 nblocks 个64字节分组执行压缩函数 (使用当前选定的实现)，
+ *  供多缓冲等实现处理剩余分组
+ */
+void SHA1ProcessBlocks(uint32_t Intermediate_Hash[SHA1HashSize/4],
+                       const uint8_t *blocks,
+                       size_t nblocks);
+
+/*
+ *  设置压缩函数使用的实现，成功返回0，当前CPU不支持返回-1
+ *  默认在第一次压缩时按CPUID自动选择：SHA-NI > AVX2 > SSSE3 > C实现；
+ *  环境变量 SHA1_IMPL=generic/ssse3/avx2/shani 可强制指定
+ */
+int SHA1SetImpl(sha1_impl_t impl);
+sha1_impl_t SHA1GetImpl(void);
+const char *SHA1ImplName(sha1_impl_t impl);
+
 #endif
\ No newline at end of file
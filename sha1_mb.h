@@ -0,0 +1,29 @@
+//
+// 多缓冲 SHA-1 - 在 SIMD 寄存器中同时计算多条互相独立消息的 SHA-1
+//
+
+#ifndef SHA1_MB_H
+#define SHA1_MB_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "sha1.h"
+
+// 最多同时计算的消息数 (AVX-512)
+#define SHA1_MB_MAX_LANES 16
+
+// 设置并行路数：4 (SSE2)、8 (AVX2)、16 (AVX-512)，1 表示逐条用 SHA1Input 计算，0 表示自动；
+// CPU 不支持或数值无效返回-1。自动模式取CPU支持的最宽实现，但没有 AVX-512 而有 SHA-NI 时逐条计算；
+// 环境变量 SHA1_MB_LANES 可强制指定
+int SHA1MBSetLanes(unsigned int lanes);
+
+// 返回当前的并行路数
+unsigned int SHA1MBLanes(void);
+
+// 计算 n 条消息的 SHA-1：msgs[i] 指向长度为 lens[i] 字节的第 i 条消息，摘要写入 digests[i]
+// 每一路算完一条消息后立即换入下一条，各路分别填充；
+// 待处理的消息用完、仍在计算的路数不足一半时，剩余部分改用 SHA1ProcessBlocks 完成
+void SHA1HashMany(const uint8_t *const *msgs, const size_t *lens, size_t n, uint8_t (*digests)[SHA1HashSize]);
+
+#endif //SHA1_MB_H
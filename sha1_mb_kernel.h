@@ -0,0 +1,79 @@
+//
+// 多缓冲 SHA-1 内核模板 - 由 sha1_mb.c 按不同向量宽度多次包含，不单独使用
+//
+// 包含前需定义：
+//   MB_T       每个元素为一路状态字的 GCC 向量类型
+//   MB_FN(n)   给函数名加上宽度后缀
+//   MB_TARGET  函数的 target 属性
+// 常数和移位次数自动扩展到所有路
+//
+
+// 一轮：f 为本阶段布尔函数的结果，k 为常量，w 为消息字
+#define SHA1_MB_ROUND(f, k, w) \
+    temp = SHA1_MB_ROL(a, 5) + (f) + e + (k) + (w); \
+    e = d; \
+    d = c; \
+    c = SHA1_MB_ROL(b, 30); \
+    b = a; \
+    a = temp
+
+// 各路同时压缩一个64字节分组：state[i][l] 为第 l 路的第 i 个状态字，blocks[l] 为第 l 路的分组
+static MB_TARGET void MB_FN(sha1_mb_compress)(uint32_t state[5][SHA1_MB_MAX_LANES],
+                                              const uint8_t *const blocks[SHA1_MB_MAX_LANES]) {
+    enum { LANES = sizeof(MB_T) / sizeof(uint32_t) };
+    uint32_t words[16][LANES];
+    MB_T a, b, c, d, e, temp, w[16];
+    int t;
+
+    // 把各路的分组转置为按字排列：w[j] 的第 l 个元素为第 l 路分组的第 j 个字 (大端)
+    for (int l = 0; l < LANES; l++) {
+        for (int j = 0; j < 16; j++) {
+            const uint8_t *p = blocks[l] + j * 4;
+            words[j][l] = ((uint32_t) p[0] << 24) | ((uint32_t) p[1] << 16) | ((uint32_t) p[2] << 8) | p[3];
+        }
+    }
+    memcpy(w, words, sizeof(w));
+    memcpy(&a, state[0], sizeof(MB_T));
+    memcpy(&b, state[1], sizeof(MB_T));
+    memcpy(&c, state[2], sizeof(MB_T));
+    memcpy(&d, state[3], sizeof(MB_T));
+    memcpy(&e, state[4], sizeof(MB_T));
+
+    // 消息扩展只保留最近16个字：W[t] 覆盖 W[t-16] 所在的位置
+    for (t = 0; t < 20; t++) {
+        if (t >= 16) {
+            w[t & 15] = SHA1_MB_ROL(w[(t - 3) & 15] ^ w[(t - 8) & 15] ^ w[(t - 14) & 15] ^ w[t & 15], 1);
+        }
+        SHA1_MB_ROUND(d ^ (b & (c ^ d)), 0x5A827999, w[t & 15]);
+    }
+    for (; t < 40; t++) {
+        w[t & 15] = SHA1_MB_ROL(w[(t - 3) & 15] ^ w[(t - 8) & 15] ^ w[(t - 14) & 15] ^ w[t & 15], 1);
+        SHA1_MB_ROUND(b ^ c ^ d, 0x6ED9EBA1, w[t & 15]);
+    }
+    for (; t < 60; t++) {
+        w[t & 15] = SHA1_MB_ROL(w[(t - 3) & 15] ^ w[(t - 8) & 15] ^ w[(t - 14) & 15] ^ w[t & 15], 1);
+        SHA1_MB_ROUND((b & c) | (d & (b | c)), 0x8F1BBCDC, w[t & 15]);
+    }
+    for (; t < 80; t++) {
+        w[t & 15] = SHA1_MB_ROL(w[(t - 3) & 15] ^ w[(t - 8) & 15] ^ w[(t - 14) & 15] ^ w[t & 15], 1);
+        SHA1_MB_ROUND(b ^ c ^ d, 0xCA62C1D6, w[t & 15]);
+    }
+
+    memcpy(&temp, state[0], sizeof(MB_T));
+    a += temp;
+    memcpy(&temp, state[1], sizeof(MB_T));
+    b += temp;
+    memcpy(&temp, state[2], sizeof(MB_T));
+    c += temp;
+    memcpy(&temp, state[3], sizeof(MB_T));
+    d += temp;
+    memcpy(&temp, state[4], sizeof(MB_T));
+    e += temp;
+    memcpy(state[0], &a, sizeof(MB_T));
+    memcpy(state[1], &b, sizeof(MB_T));
+    memcpy(state[2], &c, sizeof(MB_T));
+    memcpy(state[3], &d, sizeof(MB_T));
+    memcpy(state[4], &e, sizeof(MB_T));
+}
+
+#undef SHA1_MB_ROUND
@@ -0,0 +1,477 @@
+/*
+ *  sha256.c
+ *
+ *  Description:
+ *      This file implements the Secure Hashing Algorithms SHA-224
+ *      and SHA-256 as defined in FIPS PUB 180-4.
+ *
+ *      SHA-224 is SHA-256 with different initial values and the
+ *      output truncated to 224 bits, so both share one context type
+ *      and one compression function.
+ *
+ *  Portability Issues:
+ *      Like sha1.c, this code uses <stdint.h> for its 32-bit words.
+ *      The SHA-NI backend is only compiled on x86 with GCC/Clang and
+ *      is chosen at run time.
+ *
+ *  Caveats:
+ *      Messages are limited to less than 2^64 bits and must be a
+ *      whole number of bytes.
+ *
+ */
+
+#include "sha256.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "cpu_features.h"
+#include "sha256_common.h"
+
+#if CPU_X86
+#include <immintrin.h>
+#endif
+
+/* Constants defined in FIPS 180-4 (前64个素数立方根小数部分的前32位)，sha256_mb.c 通过 sha256_common.h 共用 */
+const uint32_t sha256_k[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+/* 初始值 */
+static const uint32_t SHA224_H0[SHA256HashSize/4] = {
+    0xc1059ed8, 0x367cd507, 0x3070dd17, 0xf70e5939, 0xffc00b31, 0x68581511, 0x64f98fa7, 0xbefa4fa4
+};
+static const uint32_t SHA256_H0[SHA256HashSize/4] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+/* Local Function Prototypes */
+static int SHA224_256Reset(SHA256Context *, const uint32_t *);
+static int SHA224_256Result(SHA256Context *, uint8_t *, int);
+static void SHA224_256PadMessage(SHA256Context *);
+
+/*
+ *  SHA224Reset / SHA256Reset
+ *
+ *  Description:
+ *      These functions will initialize the context in preparation
+ *      for computing a new SHA-224 / SHA-256 message digest.
+ *
+ *  Returns:
+ *      sha Error Code.
+ *
+ *  初始化上下文，为计算新的消息摘要做准备
+ */
+int SHA224Reset(SHA224Context *context) {
+    return SHA224_256Reset(context, SHA224_H0);
+}
+
+int SHA256Reset(SHA256Context *context) {
+    return SHA224_256Reset(context, SHA256_H0);
+}
+
+static int SHA224_256Reset(SHA256Context *context, const uint32_t *H0) {
+    if (!context) {
+        return shaNull;
+    }
+
+    context->Length_Low = 0;
+    context->Length_High = 0;
+    context->Message_Block_Index = 0;
+    memcpy(context->Intermediate_Hash, H0, sizeof(context->Intermediate_Hash));
+    context->Computed = 0;
+    context->Corrupted = 0;
+
+    return shaSuccess;
+}
+
+/*
+ *  SHA224Input / SHA256Input
+ *
+ *  Description:
+ *      These functions accept an array of octets as the next portion
+ *      of the message.
+ *
+ *  Returns:
+ *      sha Error Code.
+ *
+ *  接受消息的下一个部分：补满缓冲区中未满的块，之后的完整块直接在调用者的缓冲区上压缩
+ */
+int SHA224Input(SHA224Context *context, const uint8_t *message_array, size_t length) {
+    return SHA256Input(context, message_array, length);
+}
+
+int SHA256Input(SHA256Context *context,
+                const uint8_t *message_array,
+                size_t length) {
+    if (!length) {
+        return shaSuccess;
+    }
+
+    if (!context || !message_array) {
+        return shaNull;
+    }
+
+    if (context->Computed) {
+        context->Corrupted = shaStateError;
+        return shaStateError;
+    }
+
+    if (context->Corrupted) {
+        return context->Corrupted;
+    }
+
+    /*
+     *  一次性累加消息长度 (64位比特数)，超过 2^64 位时拒绝整段输入
+     */
+    {
+        uint64_t bits = ((uint64_t) context->Length_High << 32) | context->Length_Low;
+        uint64_t added = (uint64_t) length << 3;
+
+        if ((uint64_t) length > (UINT64_MAX >> 3) || bits + added < bits) {
+            context->Corrupted = shaInputTooLong;
+            return shaInputTooLong;
+        }
+        bits += added;
+        context->Length_Low = (uint32_t) bits;
+        context->Length_High = (uint32_t) (bits >> 32);
+    }
+
+    if (context->Message_Block_Index > 0) {
+        size_t n = SHA256_Message_Block_Size - context->Message_Block_Index;
+
+        if (n > length) {
+            n = length;
+        }
+        memcpy(&context->Message_Block[context->Message_Block_Index], message_array, n);
+        context->Message_Block_Index += (int_least16_t) n;
+        message_array += n;
+        length -= n;
+
+        if (context->Message_Block_Index == SHA256_Message_Block_Size) {
+            SHA256ProcessBlocks(context->Intermediate_Hash, context->Message_Block, 1);
+            context->Message_Block_Index = 0;
+        }
+    }
+
+    if (length >= SHA256_Message_Block_Size) {
+        SHA256ProcessBlocks(context->Intermediate_Hash, message_array, length / SHA256_Message_Block_Size);
+        message_array += length & ~(size_t) (SHA256_Message_Block_Size - 1);
+        length &= SHA256_Message_Block_Size - 1;
+    }
+
+    if (length > 0) {
+        memcpy(context->Message_Block, message_array, length);
+        context->Message_Block_Index = (int_least16_t) length;
+    }
+
+    return shaSuccess;
+}
+
+/*
+ *  SHA224Result / SHA256Result
+ *
+ *  Description:
+ *      These functions will return the 224-bit / 256-bit message
+ *      digest into the Message_Digest array provided by the caller.
+ *
+ *  Returns:
+ *      sha Error Code.
+ *
+ *  返回消息摘要 (大端序)
+ */
+int SHA224Result(SHA224Context *context, uint8_t Message_Digest[SHA224HashSize]) {
+    return SHA224_256Result(context, Message_Digest, SHA224HashSize);
+}
+
+int SHA256Result(SHA256Context *context, uint8_t Message_Digest[SHA256HashSize]) {
+    return SHA224_256Result(context, Message_Digest, SHA256HashSize);
+}
+
+static int SHA224_256Result(SHA256Context *context, uint8_t *Message_Digest, int HashSize) {
+    int i;
+
+    if (!context || !Message_Digest) {
+        return shaNull;
+    }
+
+    if (context->Corrupted) {
+        return context->Corrupted;
+    }
+
+    if (!context->Computed) {
+        SHA224_256PadMessage(context);
+        /* message may be sensitive, clear it out */
+        memset(context->Message_Block, 0, sizeof(context->Message_Block));
+        context->Length_Low = 0;
+        context->Length_High = 0;
+        context->Computed = 1;
+    }
+
+    for (i = 0; i < HashSize; ++i) {
+        Message_Digest[i] = (uint8_t) (context->Intermediate_Hash[i >> 2] >> 8 * (3 - (i & 0x03)));
+    }
+
+    return shaSuccess;
+}
+
+/*
+ *  SHA224_256PadMessage
+ *
+ *  按照标准要求填充消息：0x80、补零至 56 (mod 64) 字节，最后8字节为大端序的比特长度
+ */
+static void SHA224_256PadMessage(SHA256Context *context) {
+    if (context->Message_Block_Index > 55) {
+        context->Message_Block[context->Message_Block_Index++] = 0x80;
+        while (context->Message_Block_Index < 64) {
+            context->Message_Block[context->Message_Block_Index++] = 0;
+        }
+        SHA256ProcessBlocks(context->Intermediate_Hash, context->Message_Block, 1);
+        context->Message_Block_Index = 0;
+        while (context->Message_Block_Index < 56) {
+            context->Message_Block[context->Message_Block_Index++] = 0;
+        }
+    } else {
+        context->Message_Block[context->Message_Block_Index++] = 0x80;
+        while (context->Message_Block_Index < 56) {
+            context->Message_Block[context->Message_Block_Index++] = 0;
+        }
+    }
+
+    context->Message_Block[56] = (uint8_t) (context->Length_High >> 24);
+    context->Message_Block[57] = (uint8_t) (context->Length_High >> 16);
+    context->Message_Block[58] = (uint8_t) (context->Length_High >> 8);
+    context->Message_Block[59] = (uint8_t) context->Length_High;
+    context->Message_Block[60] = (uint8_t) (context->Length_Low >> 24);
+    context->Message_Block[61] = (uint8_t) (context->Length_Low >> 16);
+    context->Message_Block[62] = (uint8_t) (context->Length_Low >> 8);
+    context->Message_Block[63] = (uint8_t) context->Length_Low;
+
+    SHA256ProcessBlocks(context->Intermediate_Hash, context->Message_Block, 1);
+    context->Message_Block_Index = 0;
+}
+
+/*
+ *  SHA256ProcessBlocksGeneric
+ *
+ *  依次处理 nblocks 个512位的消息块 (可移植的C实现)
+ *  消息扩展只保留最近16个字，轮函数按8轮展开以免交换变量
+ */
+static void SHA256ProcessBlocksGeneric(uint32_t Intermediate_Hash[SHA256HashSize/4],
+                                       const uint8_t *blocks,
+                                       size_t nblocks) {
+    uint32_t W[16];
+    uint32_t A, B, C, D, E, F, G, H;
+    int t;
+
+    for (; nblocks > 0; nblocks--, blocks += 64) {
+        for (t = 0; t < 16; t++) {
+            W[t] = ((uint32_t) blocks[t * 4] << 24) | ((uint32_t) blocks[t * 4 + 1] << 16) |
+                   ((uint32_t) blocks[t * 4 + 2] << 8) | (uint32_t) blocks[t * 4 + 3];
+        }
+
+        A = Intermediate_Hash[0];
+        B = Intermediate_Hash[1];
+        C = Intermediate_Hash[2];
+        D = Intermediate_Hash[3];
+        E = Intermediate_Hash[4];
+        F = Intermediate_Hash[5];
+        G = Intermediate_Hash[6];
+        H = Intermediate_Hash[7];
+
+        /* 一轮：T1 加到 d、h 上，h 再加上 T2；下一轮把变量名整体右移一位 */
+#define SHA256_ROUND(a, b, c, d, e, f, g, h, t) \
+        if ((t) >= 16) { \
+            W[(t) & 15] += SHA256_sigma1(W[((t) - 2) & 15]) + W[((t) - 7) & 15] + \
+                           SHA256_sigma0(W[((t) - 15) & 15]); \
+        } \
+        h += SHA256_SIGMA1(e) + SHA256_CH(e, f, g) + sha256_k[t] + W[(t) & 15]; \
+        d += h; \
+        h += SHA256_SIGMA0(a) + SHA256_MAJ(a, b, c)
+
+        for (t = 0; t < 64; t += 8) {
+            SHA256_ROUND(A, B, C, D, E, F, G, H, t);
+            SHA256_ROUND(H, A, B, C, D, E, F, G, t + 1);
+            SHA256_ROUND(G, H, A, B, C, D, E, F, t + 2);
+            SHA256_ROUND(F, G, H, A, B, C, D, E, t + 3);
+            SHA256_ROUND(E, F, G, H, A, B, C, D, t + 4);
+            SHA256_ROUND(D, E, F, G, H, A, B, C, t + 5);
+            SHA256_ROUND(C, D, E, F, G, H, A, B, t + 6);
+            SHA256_ROUND(B, C, D, E, F, G, H, A, t + 7);
+        }
+#undef SHA256_ROUND
+
+        Intermediate_Hash[0] += A;
+        Intermediate_Hash[1] += B;
+        Intermediate_Hash[2] += C;
+        Intermediate_Hash[3] += D;
+        Intermediate_Hash[4] += E;
+        Intermediate_Hash[5] += F;
+        Intermediate_Hash[6] += G;
+        Intermediate_Hash[7] += H;
+    }
+}
+
+#if CPU_X86
+#define SHANI_TARGET __attribute__((target("sha,sse4.1")))
+
+/*
+ *  4轮：MSG_K 为本组的4个消息字；SHA256RNDS2 一次做2轮，
+ *  同时用 SHA256MSG1/SHA256MSG2 推进后续消息字的扩展
+ */
+#define SHANI256_QROUND(g, MSG_K, MSG_PREV, MSG_NEXT, DO_MSG2, DO_MSG1) \
+    MSG = _mm_add_epi32(MSG_K, _mm_loadu_si128((const __m128i *) (sha256_k + 4 * (g)))); \
+    STATE1 = _mm_sha256rnds2_epu32(STATE1, STATE0, MSG); \
+    if (DO_MSG2) { \
+        MSG_NEXT = _mm_add_epi32(MSG_NEXT, _mm_alignr_epi8(MSG_K, MSG_PREV, 4)); \
+        MSG_NEXT = _mm_sha256msg2_epu32(MSG_NEXT, MSG_K); \
+    } \
+    MSG = _mm_shuffle_epi32(MSG, 0x0E); \
+    STATE0 = _mm_sha256rnds2_epu32(STATE0, STATE1, MSG); \
+    if (DO_MSG1) { \
+        MSG_PREV = _mm_sha256msg1_epu32(MSG_PREV, MSG_K); \
+    }
+
+/*
+ *  SHA256ProcessBlocksShaNi
+ *
+ *  用 SHA256RNDS2/SHA256MSG1/SHA256MSG2 指令处理 nblocks 个消息块
+ *  SHA256RNDS2 要求状态按 ABEF / CDGH 两个寄存器排列
+ */
+static SHANI_TARGET void SHA256ProcessBlocksShaNi(uint32_t Intermediate_Hash[SHA256HashSize/4],
+                                                  const uint8_t *blocks,
+                                                  size_t nblocks) {
+    /* 每个32位字从大端序转为小端序 */
+    const __m128i MASK = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+    __m128i STATE0, STATE1, ABEF_SAVE, CDGH_SAVE, MSG, TMP;
+    __m128i MSG0, MSG1, MSG2, MSG3;
+
+    TMP = _mm_loadu_si128((const __m128i *) &Intermediate_Hash[0]);
+    STATE1 = _mm_loadu_si128((const __m128i *) &Intermediate_Hash[4]);
+    TMP = _mm_shuffle_epi32(TMP, 0xB1);             /* CDAB */
+    STATE1 = _mm_shuffle_epi32(STATE1, 0x1B);       /* EFGH */
+    STATE0 = _mm_alignr_epi8(TMP, STATE1, 8);       /* ABEF */
+    STATE1 = _mm_blend_epi16(STATE1, TMP, 0xF0);    /* CDGH */
+
+    for (; nblocks > 0; nblocks--, blocks += 64) {
+        ABEF_SAVE = STATE0;
+        CDGH_SAVE = STATE1;
+
+        MSG0 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) blocks), MASK);
+        MSG1 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) (blocks + 16)), MASK);
+        MSG2 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) (blocks + 32)), MASK);
+        MSG3 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) (blocks + 48)), MASK);
+
+        SHANI256_QROUND(0, MSG0, MSG3, MSG1, 0, 0);
+        SHANI256_QROUND(1, MSG1, MSG0, MSG2, 0, 1);
+        SHANI256_QROUND(2, MSG2, MSG1, MSG3, 0, 1);
+        SHANI256_QROUND(3, MSG3, MSG2, MSG0, 1, 1);
+        SHANI256_QROUND(4, MSG0, MSG3, MSG1, 1, 1);
+        SHANI256_QROUND(5, MSG1, MSG0, MSG2, 1, 1);
+        SHANI256_QROUND(6, MSG2, MSG1, MSG3, 1, 1);
+        SHANI256_QROUND(7, MSG3, MSG2, MSG0, 1, 1);
+        SHANI256_QROUND(8, MSG0, MSG3, MSG1, 1, 1);
+        SHANI256_QROUND(9, MSG1, MSG0, MSG2, 1, 1);
+        SHANI256_QROUND(10, MSG2, MSG1, MSG3, 1, 1);
+        SHANI256_QROUND(11, MSG3, MSG2, MSG0, 1, 1);
+        SHANI256_QROUND(12, MSG0, MSG3, MSG1, 1, 1);
+        SHANI256_QROUND(13, MSG1, MSG0, MSG2, 1, 0);
+        SHANI256_QROUND(14, MSG2, MSG1, MSG3, 1, 0);
+        SHANI256_QROUND(15, MSG3, MSG2, MSG0, 0, 0);
+
+        STATE0 = _mm_add_epi32(STATE0, ABEF_SAVE);
+        STATE1 = _mm_add_epi32(STATE1, CDGH_SAVE);
+    }
+
+    TMP = _mm_shuffle_epi32(STATE0, 0x1B);          /* FEBA */
+    STATE1 = _mm_shuffle_epi32(STATE1, 0xB1);       /* DCHG */
+    STATE0 = _mm_blend_epi16(TMP, STATE1, 0xF0);    /* DCBA */
+    STATE1 = _mm_alignr_epi8(STATE1, TMP, 8);       /* HGFE */
+    _mm_storeu_si128((__m128i *) &Intermediate_Hash[0], STATE0);
+    _mm_storeu_si128((__m128i *) &Intermediate_Hash[4], STATE1);
+}
+#endif
+
+/*
+ *  判断某个实现在当前CPU上是否可用
+ */
+static int SHA256ImplAvailable(sha256_impl_t impl) {
+    switch (impl) {
+        case SHA256_IMPL_GENERIC:
+            return 1;
+        case SHA256_IMPL_SHANI:
+#if CPU_X86
+            return cpu_has(CPU_SHANI | CPU_SSE41);
+#else
+            return 0;
+#endif
+        default:
+            return 0;
+    }
+}
+
+/* 当前使用的实现，SHA256_IMPL_AUTO 表示尚未选定 */
+static sha256_impl_t sha256_impl = SHA256_IMPL_AUTO;
+
+/*
+ *  选定实现：环境变量 SHA256_IMPL 优先，否则有 SHA-NI 时使用 SHA-NI
+ */
+static sha256_impl_t SHA256ResolveImpl(void) {
+    if (sha256_impl == SHA256_IMPL_AUTO) {
+        const char *env = getenv("SHA256_IMPL");
+        sha256_impl_t impl = SHA256_IMPL_AUTO;
+
+        if (env && strcmp(env, SHA256ImplName(SHA256_IMPL_GENERIC)) == 0) {
+            impl = SHA256_IMPL_GENERIC;
+        } else if (env && strcmp(env, SHA256ImplName(SHA256_IMPL_SHANI)) == 0) {
+            impl = SHA256_IMPL_SHANI;
+        }
+        if (impl == SHA256_IMPL_AUTO || !SHA256ImplAvailable(impl)) {
+            impl = SHA256ImplAvailable(SHA256_IMPL_SHANI) ? SHA256_IMPL_SHANI : SHA256_IMPL_GENERIC;
+        }
+        sha256_impl = impl;
+    }
+    return sha256_impl;
+}
+
+int SHA256SetImpl(sha256_impl_t impl) {
+    if (impl != SHA256_IMPL_AUTO && !SHA256ImplAvailable(impl)) {
+        return -1;
+    }
+    sha256_impl = impl;
+    return 0;
+}
+
+sha256_impl_t SHA256GetImpl(void) {
+    return SHA256ResolveImpl();
+}
+
+const char *SHA256ImplName(sha256_impl_t impl) {
+    switch (impl) {
+        case SHA256_IMPL_GENERIC:
+            return "generic";
+        case SHA256_IMPL_SHANI:
+            return "shani";
+        default:
+            return "auto";
+    }
+}
+
+void SHA256ProcessBlocks(uint32_t Intermediate_Hash[SHA256HashSize/4],
+                         const uint8_t *blocks,
+                         size_t nblocks) {
+#if CPU_X86
+    if (SHA256ResolveImpl() == SHA256_IMPL_SHANI) {
+        SHA256ProcessBlocksShaNi(Intermediate_Hash, blocks, nblocks);
+        return;
+    }
+#endif
+    SHA256ProcessBlocksGeneric(Intermediate_Hash, blocks, nblocks);
+}
@@ -0,0 +1,102 @@
+/*
+ *  sha256.h
+ *
+ *  Description:
+ *      This is the header file for code which implements the Secure
+ *      Hashing Algorithms SHA-224 and SHA-256 as defined in
+ *      FIPS PUB 180-4.
+ *
+ *      The interface follows sha1.h: Reset, Input (any number of
+ *      times), then Result.
+ *
+ *      Please read the file sha256.c for more information.
+ *
+ */
+
+#ifndef _SHA256_H_
+#define _SHA256_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifndef _SHA_enum_
+#define _SHA_enum_
+enum
+{
+    shaSuccess = 0,
+    shaNull,            /* Null pointer parameter */
+    shaInputTooLong,    /* input data too long */
+    shaStateError       /* called Input after Result */
+};
+#endif
+
+#define SHA224HashSize 28
+#define SHA256HashSize 32
+#define SHA256_Message_Block_Size 64
+
+/*
+ *  This structure will hold context information for the SHA-224
+ *  and SHA-256 hashing operations
+ *  SHA-224/SHA-256 上下文结构体，两者只有初始值和输出长度不同
+ */
+typedef struct SHA256Context
+{
+    uint32_t Intermediate_Hash[SHA256HashSize/4]; /* Message Digest  */
+
+    uint32_t Length_Low;            /* Message length in bits      */
+    uint32_t Length_High;           /* Message length in bits      */
+
+    /* Index into message block array   */
+    int_least16_t Message_Block_Index;
+    uint8_t Message_Block[SHA256_Message_Block_Size]; /* 512-bit message blocks */
+
+    int Computed;                   /* Is the digest computed?         */
+    int Corrupted;                  /* Is the message digest corrupted? */
+} SHA256Context;
+
+typedef struct SHA256Context SHA224Context;
+
+/*
+ *  SHA-256 压缩函数的实现选择
+ */
+typedef enum
+{
+    SHA256_IMPL_AUTO = 0,   /* 自动选择最快的可用实现 */
+    SHA256_IMPL_GENERIC,    /* 可移植的C实现 */
+    SHA256_IMPL_SHANI       /* SHA-NI 硬件指令实现 */
+} sha256_impl_t;
+
+/*
+ *  Function Prototypes
+ */
+int SHA224Reset(  SHA224Context *);
+int SHA224Input(  SHA224Context *,
+                  const uint8_t *,
+                  size_t);
+int SHA224Result( SHA224Context *,
+                  uint8_t Message_Digest[SHA224HashSize]);
+
+int SHA256Reset(  SHA256Context *);
+int SHA256Input(  SHA256Context *,
+                  const uint8_t *,
+                  size_t);
+int SHA256Result( SHA256Context *,
+                  uint8_t Message_Digest[SHA256HashSize]);
+
+/*
+ *  对连续的 nblocks 个64字节分组执行压缩函数 (使用当前选定的实现)
+ */
+void SHA256ProcessBlocks(uint32_t Intermediate_Hash[SHA256HashSize/4],
+                         const uint8_t *blocks,
+                         size_t nblocks);
+
+/*
+ *  设置压缩函数使用的实现，成功返回0，当前CPU不支持返回-1
+ *  默认在第一次压缩时按CPUID自动选择：SHA-NI > C实现；
+ *  环境变量 SHA256_IMPL=generic/shani 可强制指定
+ */
+int SHA256SetImpl(sha256_impl_t impl);
+sha256_impl_t SHA256GetImpl(void);
+const char *SHA256ImplName(sha256_impl_t impl);
+
+#endif
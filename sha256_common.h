@@ -0,0 +1,27 @@
+//
+// SHA-256 共用定义 - sha256.c 的标量/SHA-NI 实现与 sha256_mb.c 的多缓冲内核共用，只供内部使用
+//
+// 下列宏对 uint32_t 和 GCC 向量类型都适用，向量上按元素计算
+//
+
+#ifndef SHA256_COMMON_H
+#define SHA256_COMMON_H
+
+#include <stdint.h>
+
+/*
+ *  循环右移及 FIPS 180-4 中定义的各个函数
+ */
+#define SHA256_ROTR(bits,word) \
+                (((word) >> (bits)) | ((word) << (32-(bits))))
+#define SHA256_CH(x, y, z)  (((x) & ((y) ^ (z))) ^ (z))
+#define SHA256_MAJ(x, y, z) (((x) & ((y) | (z))) | ((y) & (z)))
+#define SHA256_SIGMA0(x) (SHA256_ROTR( 2, x) ^ SHA256_ROTR(13, x) ^ SHA256_ROTR(22, x))
+#define SHA256_SIGMA1(x) (SHA256_ROTR( 6, x) ^ SHA256_ROTR(11, x) ^ SHA256_ROTR(25, x))
+#define SHA256_sigma0(x) (SHA256_ROTR( 7, x) ^ SHA256_ROTR(18, x) ^ ((x) >> 3))
+#define SHA256_sigma1(x) (SHA256_ROTR(17, x) ^ SHA256_ROTR(19, x) ^ ((x) >> 10))
+
+/* Constants defined in FIPS 180-4 (前64个素数立方根小数部分的前32位)，定义在 sha256.c */
+extern const uint32_t sha256_k[64];
+
+#endif //SHA256_COMMON_H
@@ -0,0 +1,83 @@
+//
+// 多缓冲 SHA-256 - 按三种向量宽度编译压缩内核，分路调度由 hash_mb.c 完成
+//
+
+#include "sha256_mb.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include "cpu_features.h"
+#include "hash_mb.h"
+#include "sha256_common.h"
+
+#if CPU_X86
+typedef uint32_t mb_v4 __attribute__((vector_size(16)));
+typedef uint32_t mb_v8 __attribute__((vector_size(32)));
+typedef uint32_t mb_v16 __attribute__((vector_size(64)));
+
+// 4路：SSE2
+#define MB_T mb_v4
+#define MB_FN(name) name##_sse2
+#define MB_TARGET __attribute__((target("sse2")))
+#include "sha256_mb_kernel.h"
+#undef MB_T
+#undef MB_FN
+#undef MB_TARGET
+
+// 8路：AVX2
+#define MB_T mb_v8
+#define MB_FN(name) name##_avx2
+#define MB_TARGET __attribute__((target("avx2")))
+#include "sha256_mb_kernel.h"
+#undef MB_T
+#undef MB_FN
+#undef MB_TARGET
+
+// 16路：AVX-512
+#define MB_T mb_v16
+#define MB_FN(name) name##_avx512
+#define MB_TARGET __attribute__((target("avx512f")))
+#include "sha256_mb_kernel.h"
+#undef MB_T
+#undef MB_FN
+#undef MB_TARGET
+#endif
+
+#if CPU_X86
+#define SHA256_MB_KERNEL(name) name
+#else
+#define SHA256_MB_KERNEL(name) NULL
+#endif
+
+static const uint32_t sha256_init[8] = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                                        0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+
+static const hash_mb_alg sha256_alg = {
+    8, sha256_init, 1, SHA256ProcessBlocks,
+    SHA256_MB_KERNEL(sha256_mb_compress_sse2), SHA256_MB_KERNEL(sha256_mb_compress_avx2),
+    SHA256_MB_KERNEL(sha256_mb_compress_avx512)
+};
+
+static unsigned int mb_lanes = 0; // 0 表示尚未选择
+
+int SHA256MBSetLanes(unsigned int lanes) {
+    if (lanes != 0 && !hash_mb_lanes_available(lanes)) {
+        return -1;
+    }
+    mb_lanes = lanes;
+    return 0;
+}
+
+// 选定并行路数：环境变量 SHA256_MB_LANES 优先，否则取CPU支持的最宽实现；
+// 有 SHA-NI 时逐条计算比 4/8 路的向量内核更快，只有 16 路还能胜过它
+unsigned int SHA256MBLanes(void) {
+    if (mb_lanes == 0) {
+        mb_lanes = hash_mb_resolve_lanes("SHA256_MB_LANES", SHA256GetImpl() == SHA256_IMPL_SHANI);
+    }
+    return mb_lanes;
+}
+
+void SHA256HashMany(const uint8_t *const *msgs, const size_t *lens, size_t n, uint8_t (*digests)[SHA256HashSize]) {
+    hash_mb_many(&sha256_alg, SHA256MBLanes(), msgs, lens, n, (uint8_t *) digests);
+}
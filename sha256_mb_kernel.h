@@ -0,0 +1,83 @@
+//
+// 多缓冲 SHA-256 内核模板 - 由 sha256_mb.c 按不同向量宽度多次包含，不单独使用
+//
+// 包含前需定义：
+//   MB_T       每个元素为一路状态字的 GCC 向量类型
+//   MB_FN(n)   给函数名加上宽度后缀
+//   MB_TARGET  函数的 target 属性
+// 常数和移位次数自动扩展到所有路
+//
+
+// 一轮：与 sha256.c 中的标量轮函数相同，函数和轮常数来自 sha256_common.h，下一轮把变量名整体右移一位
+#define SHA256_MB_ROUND(a, b, c, d, e, f, g, h, t) \
+    if ((t) >= 16) { \
+        w[(t) & 15] += SHA256_sigma1(w[((t) - 2) & 15]) + w[((t) - 7) & 15] + \
+                       SHA256_sigma0(w[((t) - 15) & 15]); \
+    } \
+    h += SHA256_SIGMA1(e) + SHA256_CH(e, f, g) + sha256_k[t] + w[(t) & 15]; \
+    d += h; \
+    h += SHA256_SIGMA0(a) + SHA256_MAJ(a, b, c)
+
+// 各路同时压缩一个64字节分组：state[i][l] 为第 l 路的第 i 个状态字，blocks[l] 为第 l 路的分组
+static MB_TARGET void MB_FN(sha256_mb_compress)(uint32_t state[8][SHA256_MB_MAX_LANES],
+                                                const uint8_t *const blocks[SHA256_MB_MAX_LANES]) {
+    enum { LANES = sizeof(MB_T) / sizeof(uint32_t) };
+    uint32_t words[16][LANES];
+    MB_T a, b, c, d, e, f, g, h, temp, w[16];
+    int t;
+
+    // 把各路的分组转置为按字排列：w[j] 的第 l 个元素为第 l 路分组的第 j 个字 (大端)
+    for (int l = 0; l < LANES; l++) {
+        for (int j = 0; j < 16; j++) {
+            const uint8_t *p = blocks[l] + j * 4;
+            words[j][l] = ((uint32_t) p[0] << 24) | ((uint32_t) p[1] << 16) | ((uint32_t) p[2] << 8) | p[3];
+        }
+    }
+    memcpy(w, words, sizeof(w));
+    memcpy(&a, state[0], sizeof(MB_T));
+    memcpy(&b, state[1], sizeof(MB_T));
+    memcpy(&c, state[2], sizeof(MB_T));
+    memcpy(&d, state[3], sizeof(MB_T));
+    memcpy(&e, state[4], sizeof(MB_T));
+    memcpy(&f, state[5], sizeof(MB_T));
+    memcpy(&g, state[6], sizeof(MB_T));
+    memcpy(&h, state[7], sizeof(MB_T));
+
+    for (t = 0; t < 64; t += 8) {
+        SHA256_MB_ROUND(a, b, c, d, e, f, g, h, t);
+        SHA256_MB_ROUND(h, a, b, c, d, e, f, g, t + 1);
+        SHA256_MB_ROUND(g, h, a, b, c, d, e, f, t + 2);
+        SHA256_MB_ROUND(f, g, h, a, b, c, d, e, t + 3);
+        SHA256_MB_ROUND(e, f, g, h, a, b, c, d, t + 4);
+        SHA256_MB_ROUND(d, e, f, g, h, a, b, c, t + 5);
+        SHA256_MB_ROUND(c, d, e, f, g, h, a, b, t + 6);
+        SHA256_MB_ROUND(b, c, d, e, f, g, h, a, t + 7);
+    }
+
+    memcpy(&temp, state[0], sizeof(MB_T));
+    a += temp;
+    memcpy(&temp, state[1], sizeof(MB_T));
+    b += temp;
+    memcpy(&temp, state[2], sizeof(MB_T));
+    c += temp;
+    memcpy(&temp, state[3], sizeof(MB_T));
+    d += temp;
+    memcpy(&temp, state[4], sizeof(MB_T));
+    e += temp;
+    memcpy(&temp, state[5], sizeof(MB_T));
+    f += temp;
+    memcpy(&temp, state[6], sizeof(MB_T));
+    g += temp;
+    memcpy(&temp, state[7], sizeof(MB_T));
+    h += temp;
+    memcpy(state[0], &a, sizeof(MB_T));
+    memcpy(state[1], &b, sizeof(MB_T));
+    memcpy(state[2], &c, sizeof(MB_T));
+    memcpy(state[3], &d, sizeof(MB_T));
+    memcpy(state[4], &e, sizeof(MB_T));
+    memcpy(state[5], &f, sizeof(MB_T));
+    memcpy(state[6], &g, sizeof(MB_T));
+    memcpy(state[7], &h, sizeof(MB_T));
+}
+
+#undef SHA256_MB_ROUND
@@ -0,0 +1,339 @@
+/*
+ *  sha512.c
+ *
+ *  Description:
+ *      This file implements the Secure Hashing Algorithms SHA-384
+ *      and SHA-512 as defined in FIPS PUB 180-4.
+ *
+ *      SHA-384 is SHA-512 with different initial values and the
+ *      output truncated to 384 bits, so both share one context type
+ *      and one compression function.
+ *
+ *  Portability Issues:
+ *      This code uses <stdint.h> for its 64-bit words.  There is no
+ *      hardware backend: the 64-bit scalar rounds are already close
+ *      to the throughput of SHA-256 on 64-bit CPUs without SHA-NI.
+ *
+ *  Caveats:
+ *      Messages are limited to less than 2^128 bits and must be a
+ *      whole number of bytes.
+ *
+ */
+
+#include "sha512.h"
+
+#include <string.h>
+
+/*
+ *  循环右移及 FIPS 180-4 中定义的各个函数
+ */
+#define SHA512_ROTR(bits,word) \
+                (((word) >> (bits)) | ((word) << (64-(bits))))
+#define SHA512_CH(x, y, z)  (((x) & ((y) ^ (z))) ^ (z))
+#define SHA512_MAJ(x, y, z) (((x) & ((y) | (z))) | ((y) & (z)))
+#define SHA512_SIGMA0(x) (SHA512_ROTR(28, x) ^ SHA512_ROTR(34, x) ^ SHA512_ROTR(39, x))
+#define SHA512_SIGMA1(x) (SHA512_ROTR(14, x) ^ SHA512_ROTR(18, x) ^ SHA512_ROTR(41, x))
+#define SHA512_sigma0(x) (SHA512_ROTR( 1, x) ^ SHA512_ROTR( 8, x) ^ ((x) >> 7))
+#define SHA512_sigma1(x) (SHA512_ROTR(19, x) ^ SHA512_ROTR(61, x) ^ ((x) >> 6))
+
+/* Constants defined in FIPS 180-4 (前80个素数立方根小数部分的前64位) */
+static const uint64_t K512[80] = {
+    0x428a2f98d728ae22ULL, 0x7137449123ef65cdULL, 0xb5c0fbcfec4d3b2fULL, 0xe9b5dba58189dbbcULL,
+    0x3956c25bf348b538ULL, 0x59f111f1b605d019ULL, 0x923f82a4af194f9bULL, 0xab1c5ed5da6d8118ULL,
+    0xd807aa98a3030242ULL, 0x12835b0145706fbeULL, 0x243185be4ee4b28cULL, 0x550c7dc3d5ffb4e2ULL,
+    0x72be5d74f27b896fULL, 0x80deb1fe3b1696b1ULL, 0x9bdc06a725c71235ULL, 0xc19bf174cf692694ULL,
+    0xe49b69c19ef14ad2ULL, 0xefbe4786384f25e3ULL, 0x0fc19dc68b8cd5b5ULL, 0x240ca1cc77ac9c65ULL,
+    0x2de92c6f592b0275ULL, 0x4a7484aa6ea6e483ULL, 0x5cb0a9dcbd41fbd4ULL, 0x76f988da831153b5ULL,
+    0x983e5152ee66dfabULL, 0xa831c66d2db43210ULL, 0xb00327c898fb213fULL, 0xbf597fc7beef0ee4ULL,
+    0xc6e00bf33da88fc2ULL, 0xd5a79147930aa725ULL, 0x06ca6351e003826fULL, 0x142929670a0e6e70ULL,
+    0x27b70a8546d22ffcULL, 0x2e1b21385c26c926ULL, 0x4d2c6dfc5ac42aedULL, 0x53380d139d95b3dfULL,
+    0x650a73548baf63deULL, 0x766a0abb3c77b2a8ULL, 0x81c2c92e47edaee6ULL, 0x92722c851482353bULL,
+    0xa2bfe8a14cf10364ULL, 0xa81a664bbc423001ULL, 0xc24b8b70d0f89791ULL, 0xc76c51a30654be30ULL,
+    0xd192e819d6ef5218ULL, 0xd69906245565a910ULL, 0xf40e35855771202aULL, 0x106aa07032bbd1b8ULL,
+    0x19a4c116b8d2d0c8ULL, 0x1e376c085141ab53ULL, 0x2748774cdf8eeb99ULL, 0x34b0bcb5e19b48a8ULL,
+    0x391c0cb3c5c95a63ULL, 0x4ed8aa4ae3418acbULL, 0x5b9cca4f7763e373ULL, 0x682e6ff3d6b2b8a3ULL,
+    0x748f82ee5defb2fcULL, 0x78a5636f43172f60ULL, 0x84c87814a1f0ab72ULL, 0x8cc702081a6439ecULL,
+    0x90befffa23631e28ULL, 0xa4506cebde82bde9ULL, 0xbef9a3f7b2c67915ULL, 0xc67178f2e372532bULL,
+    0xca273eceea26619cULL, 0xd186b8c721c0c207ULL, 0xeada7dd6cde0eb1eULL, 0xf57d4f7fee6ed178ULL,
+    0x06f067aa72176fbaULL, 0x0a637dc5a2c898a6ULL, 0x113f9804bef90daeULL, 0x1b710b35131c471bULL,
+    0x28db77f523047d84ULL, 0x32caab7b40c72493ULL, 0x3c9ebe0a15c9bebcULL, 0x431d67c49c100d4cULL,
+    0x4cc5d4becb3e42b6ULL, 0x597f299cfc657e2aULL, 0x5fcb6fab3ad6faecULL, 0x6c44198c4a475817ULL
+};
+
+/* 初始值 */
+static const uint64_t SHA384_H0[SHA512HashSize/8] = {
+    0xcbbb9d5dc1059ed8ULL, 0x629a292a367cd507ULL, 0x9159015a3070dd17ULL, 0x152fecd8f70e5939ULL,
+    0x67332667ffc00b31ULL, 0x8eb44a8768581511ULL, 0xdb0c2e0d64f98fa7ULL, 0x47b5481dbefa4fa4ULL
+};
+static const uint64_t SHA512_H0[SHA512HashSize/8] = {
+    0x6a09e667f3bcc908ULL, 0xbb67ae8584caa73bULL, 0x3c6ef372fe94f82bULL, 0xa54ff53a5f1d36f1ULL,
+    0x510e527fade682d1ULL, 0x9b05688c2b3e6c1fULL, 0x1f83d9abfb41bd6bULL, 0x5be0cd19137e2179ULL
+};
+
+/* Local Function Prototypes */
+static int SHA384_512Reset(SHA512Context *, const uint64_t *);
+static int SHA384_512Result(SHA512Context *, uint8_t *, int);
+static void SHA384_512PadMessage(SHA512Context *);
+
+/*
+ *  SHA384Reset / SHA512Reset
+ *
+ *  Description:
+ *      These functions will initialize the context in preparation
+ *      for computing a new SHA-384 / SHA-512 message digest.
+ *
+ *  Returns:
+ *      sha Error Code.
+ *
+ *  初始化上下文，为计算新的消息摘要做准备
+ */
+int SHA384Reset(SHA384Context *context) {
+    return SHA384_512Reset(context, SHA384_H0);
+}
+
+int SHA512Reset(SHA512Context *context) {
+    return SHA384_512Reset(context, SHA512_H0);
+}
+
+static int SHA384_512Reset(SHA512Context *context, const uint64_t *H0) {
+    if (!context) {
+        return shaNull;
+    }
+
+    context->Length_Low = 0;
+    context->Length_High = 0;
+    context->Message_Block_Index = 0;
+    memcpy(context->Intermediate_Hash, H0, sizeof(context->Intermediate_Hash));
+    context->Computed = 0;
+    context->Corrupted = 0;
+
+    return shaSuccess;
+}
+
+/*
+ *  SHA384Input / SHA512Input
+ *
+ *  Description:
+ *      These functions accept an array of octets as the next portion
+ *      of the message.
+ *
+ *  Returns:
+ *      sha Error Code.
+ *
+ *  接受消息的下一个部分：补满缓冲区中未满的块，之后的完整块直接在调用者的缓冲区上压缩
+ */
+int SHA384Input(SHA384Context *context, const uint8_t *message_array, size_t length) {
+    return SHA512Input(context, message_array, length);
+}
+
+int SHA512Input(SHA512Context *context,
+                const uint8_t *message_array,
+                size_t length) {
+    if (!length) {
+        return shaSuccess;
+    }
+
+    if (!context || !message_array) {
+        return shaNull;
+    }
+
+    if (context->Computed) {
+        context->Corrupted = shaStateError;
+        return shaStateError;
+    }
+
+    if (context->Corrupted) {
+        return context->Corrupted;
+    }
+
+    /*
+     *  累加128位的消息比特数，超过 2^128 位时拒绝整段输入
+     */
+    {
+        uint64_t added_low = (uint64_t) length << 3;
+        uint64_t added_high = (uint64_t) length >> 61;
+        uint64_t low = context->Length_Low + added_low;
+        uint64_t high = context->Length_High + added_high + (low < added_low);
+
+        if (high < context->Length_High) {
+            context->Corrupted = shaInputTooLong;
+            return shaInputTooLong;
+        }
+        context->Length_Low = low;
+        context->Length_High = high;
+    }
+
+    if (context->Message_Block_Index > 0) {
+        size_t n = SHA512_Message_Block_Size - context->Message_Block_Index;
+
+        if (n > length) {
+            n = length;
+        }
+        memcpy(&context->Message_Block[context->Message_Block_Index], message_array, n);
+        context->Message_Block_Index += (int_least16_t) n;
+        message_array += n;
+        length -= n;
+
+        if (context->Message_Block_Index == SHA512_Message_Block_Size) {
+            SHA512ProcessBlocks(context->Intermediate_Hash, context->Message_Block, 1);
+            context->Message_Block_Index = 0;
+        }
+    }
+
+    if (length >= SHA512_Message_Block_Size) {
+        SHA512ProcessBlocks(context->Intermediate_Hash, message_array, length / SHA512_Message_Block_Size);
+        message_array += length & ~(size_t) (SHA512_Message_Block_Size - 1);
+        length &= SHA512_Message_Block_Size - 1;
+    }
+
+    if (length > 0) {
+        memcpy(context->Message_Block, message_array, length);
+        context->Message_Block_Index = (int_least16_t) length;
+    }
+
+    return shaSuccess;
+}
+
+/*
+ *  SHA384Result / SHA512Result
+ *
+ *  Description:
+ *      These functions will return the 384-bit / 512-bit message
+ *      digest into the Message_Digest array provided by the caller.
+ *
+ *  Returns:
+ *      sha Error Code.
+ *
+ *  返回消息摘要 (大端序)
+ */
+int SHA384Result(SHA384Context *context, uint8_t Message_Digest[SHA384HashSize]) {
+    return SHA384_512Result(context, Message_Digest, SHA384HashSize);
+}
+
+int SHA512Result(SHA512Context *context, uint8_t Message_Digest[SHA512HashSize]) {
+    return SHA384_512Result(context, Message_Digest, SHA512HashSize);
+}
+
+static int SHA384_512Result(SHA512Context *context, uint8_t *Message_Digest, int HashSize) {
+    int i;
+
+    if (!context || !Message_Digest) {
+        return shaNull;
+    }
+
+    if (context->Corrupted) {
+        return context->Corrupted;
+    }
+
+    if (!context->Computed) {
+        SHA384_512PadMessage(context);
+        /* message may be sensitive, clear it out */
+        memset(context->Message_Block, 0, sizeof(context->Message_Block));
+        context->Length_Low = 0;
+        context->Length_High = 0;
+        context->Computed = 1;
+    }
+
+    for (i = 0; i < HashSize; ++i) {
+        Message_Digest[i] = (uint8_t) (context->Intermediate_Hash[i >> 3] >> 8 * (7 - (i & 0x07)));
+    }
+
+    return shaSuccess;
+}
+
+/*
+ *  SHA384_512PadMessage
+ *
+ *  按照标准要求填充消息：0x80、补零至 112 (mod 128) 字节，最后16字节为大端序的比特长度
+ */
+static void SHA384_512PadMessage(SHA512Context *context) {
+    int i;
+
+    if (context->Message_Block_Index > 111) {
+        context->Message_Block[context->Message_Block_Index++] = 0x80;
+        while (context->Message_Block_Index < 128) {
+            context->Message_Block[context->Message_Block_Index++] = 0;
+        }
+        SHA512ProcessBlocks(context->Intermediate_Hash, context->Message_Block, 1);
+        context->Message_Block_Index = 0;
+        while (context->Message_Block_Index < 112) {
+            context->Message_Block[context->Message_Block_Index++] = 0;
+        }
+    } else {
+        context->Message_Block[context->Message_Block_Index++] = 0x80;
+        while (context->Message_Block_Index < 112) {
+            context->Message_Block[context->Message_Block_Index++] = 0;
+        }
+    }
+
+    for (i = 0; i < 8; i++) {
+        context->Message_Block[112 + i] = (uint8_t) (context->Length_High >> (56 - 8 * i));
+        context->Message_Block[120 + i] = (uint8_t) (context->Length_Low >> (56 - 8 * i));
+    }
+
+    SHA512ProcessBlocks(context->Intermediate_Hash, context->Message_Block, 1);
+    context->Message_Block_Index = 0;
+}
+
+/*
+ *  SHA512ProcessBlocks
+ *
+ *  依次处理 nblocks 个1024位的消息块
+ *  消息扩展只保留最近16个字，轮函数按8轮展开以免交换变量
+ */
+void SHA512ProcessBlocks(uint64_t Intermediate_Hash[SHA512HashSize/8],
+                         const uint8_t *blocks,
+                         size_t nblocks) {
+    uint64_t W[16];
+    uint64_t A, B, C, D, E, F, G, H;
+    int t, j;
+
+    for (; nblocks > 0; nblocks--, blocks += SHA512_Message_Block_Size) {
+        for (t = 0; t < 16; t++) {
+            W[t] = 0;
+            for (j = 0; j < 8; j++) {
+                W[t] = (W[t] << 8) | blocks[t * 8 + j];
+            }
+        }
+
+        A = Intermediate_Hash[0];
+        B = Intermediate_Hash[1];
+        C = Intermediate_Hash[2];
+        D = Intermediate_Hash[3];
+        E = Intermediate_Hash[4];
+        F = Intermediate_Hash[5];
+        G = Intermediate_Hash[6];
+        H = Intermediate_Hash[7];
+
+        /* 一轮：T1 加到 d、h 上，h 再加上 T2；下一轮把变量名整体右移一位 */
+#define SHA512_ROUND(a, b, c, d, e, f, g, h, t) \
+        if ((t) >= 16) { \
+            W[(t) & 15] += SHA512_sigma1(W[((t) - 2) & 15]) + W[((t) - 7) & 15] + \
+                           SHA512_sigma0(W[((t) - 15) & 15]); \
+        } \
+        h += SHA512_SIGMA1(e) + SHA512_CH(e, f, g) + K512[t] + W[(t) & 15]; \
+        d += h; \
+        h += SHA512_SIGMA0(a) + SHA512_MAJ(a, b, c)
+
+        for (t = 0; t < 80; t += 8) {
+            SHA512_ROUND(A, B, C, D, E, F, G, H, t);
+            SHA512_ROUND(H, A, B, C, D, E, F, G, t + 1);
+            SHA512_ROUND(G, H, A, B, C, D, E, F, t + 2);
+            SHA512_ROUND(F, G, H, A, B, C, D, E, t + 3);
+            SHA512_ROUND(E, F, G, H, A, B, C, D, t + 4);
+            SHA512_ROUND(D, E, F, G, H, A, B, C, t + 5);
+            SHA512_ROUND(C, D, E, F, G, H, A, B, t + 6);
+            SHA512_ROUND(B, C, D, E, F, G, H, A, t + 7);
+        }
+#undef SHA512_ROUND
+
+        Intermediate_Hash[0] += A;
+        Intermediate_Hash[1] += B;
+        Intermediate_Hash[2] += C;
+        Intermediate_Hash[3] += D;
+        Intermediate_Hash[4] += E;
+        Intermediate_Hash[5] += F;
+        Intermediate_Hash[6] += G;
+        Intermediate_Hash[7] += H;
+    }
+}
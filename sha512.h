@@ -0,0 +1,83 @@
+/*
+ *  sha512.h
+ *
+ *  Description:
+ *      This is the header file for code which implements the Secure
+ *      Hashing Algorithms SHA-384 and SHA-512 as defined in
+ *      FIPS PUB 180-4.
+ *
+ *      The interface follows sha1.h: Reset, Input (any number of
+ *      times), then Result.
+ *
+ *      Please read the file sha512.c for more information.
+ *
+ */
+
+#ifndef _SHA512_H_
+#define _SHA512_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifndef _SHA_enum_
+#define _SHA_enum_
+enum
+{
+    shaSuccess = 0,
+    shaNull,            /* Null pointer parameter */
+    shaInputTooLong,    /* input data too long */
+    shaStateError       /* called Input after Result */
+};
+#endif
+
+#define SHA384HashSize 48
+#define SHA512HashSize 64
+#define SHA512_Message_Block_Size 128
+
+/*
+ *  This structure will hold context information for the SHA-384
+ *  and SHA-512 hashing operations
+ *  SHA-384/SHA-512 上下文结构体，两者只有初始值和输出长度不同
+ */
+typedef struct SHA512Context
+{
+    uint64_t Intermediate_Hash[SHA512HashSize/8]; /* Message Digest  */
+
+    uint64_t Length_Low;            /* Message length in bits      */
+    uint64_t Length_High;           /* Message length in bits      */
+
+    /* Index into message block array   */
+    int_least16_t Message_Block_Index;
+    uint8_t Message_Block[SHA512_Message_Block_Size]; /* 1024-bit message blocks */
+
+    int Computed;                   /* Is the digest computed?         */
+    int Corrupted;                  /* Is the message digest corrupted? */
+} SHA512Context;
+
+typedef struct SHA512Context SHA384Context;
+
+/*
+ *  Function Prototypes
+ */
+int SHA384Reset(  SHA384Context *);
+int SHA384Input(  SHA384Context *,
+                  const uint8_t *,
+                  size_t);
+int SHA384Result( SHA384Context *,
+                  uint8_t Message_Digest[SHA384HashSize]);
+
+int SHA512Reset(  SHA512Context *);
+int SHA512Input(  SHA512Context *,
+                  const uint8_t *,
+                  size_t);
+int SHA512Result( SHA512Context *,
+                  uint8_t Message_Digest[SHA512HashSize]);
+
+/*
+ *  对连续的 nblocks 个128字节分组执行压缩函数
+ */
+void SHA512ProcessBlocks(uint64_t Intermediate_Hash[SHA512HashSize/8],
+                         const uint8_t *blocks,
+                         size_t nblocks);
+
+#endif